@@ -9,12 +9,20 @@
 #ifndef APPLICATION_H_
 #define APPLICATION_H_
 
+#include <HAL/Bench.h>
+#include <HAL/Commit.h>
+#include <HAL/Frame.h>
 #include <HAL/HAL.h>
+#include <HAL/Icons.h>
+#include <HAL/Profiler.h>
+#include <HAL/ScrollLog.h>
+#include <HAL/Text.h>
+#include <HAL/Trace.h>
 
 // Maximum length for text
 #define MAX_TEXT_LENGTH 100
 
-// Maximum length for strings
+// Maximum length for strings composed at run time
 #define MAX_STRING_LENGTH 21
 
 // Maximum length for player names
@@ -23,9 +31,6 @@
 // Length for player choices
 #define CHOICE_LENGTH 2
 
-// Maximum number of lines
-#define MAX_LINES 16
-
 // Increment value for Y position
 #define Y_INCREMENTAL 8
 
@@ -53,6 +58,260 @@
 // Position for players display
 #define PLAYERS_POS 72
 
+// Column of the winner icons on the end screen, right of the winner names
+#define WINNER_ICON_X 70
+
+// Band of the game screen below the scoreboard which logs every round
+#define LOG_TOP 96
+#define LOG_LINES 4
+
+// LEDs making up the baud rate indicator
+#define BAUD_LED_RED 0x01
+#define BAUD_LED_GREEN 0x02
+#define BAUD_LED_BLUE 0x04
+#define BAUD_LED_HIGH_BANK 0x08
+
+// Framing errors within one check period which trigger a new baud detection
+#define FRAMING_ERROR_THRESHOLD 3
+
+// Length of a framing error check period
+#define FRAMING_CHECK_TIME_MS 1000
+
+// The switches below may also be given on the compiler command line, as the
+// host build in host/ does.
+
+// Whether every seat enters its moves on its own UART (see HAL/UART.h)
+#ifndef SEAT_LINKS
+#define SEAT_LINKS false
+#endif
+
+// Whether this board plays linked to a second board (see HAL/Link.h). The
+// board link and the seat links use the same port.
+#ifndef BOARD_LINK
+#define BOARD_LINK false
+#endif
+#if BOARD_LINK && SEAT_LINKS
+#error "The board link and the seat links cannot be enabled together"
+#endif
+
+// Baudrate of the board link, which both boards must agree on
+#define BOARD_LINK_BAUD BAUD_115200
+
+// Which of the two linked boards this is (0 or 1). Board 0 hosts the first,
+// third and fifth seat, board 1 the others.
+#ifndef BOARD_LINK_ID
+#define BOARD_LINK_ID 0
+#endif
+
+// Message between linked boards: round, players, rounds, then a move for
+// every seat, which is 0 for the seats of the receiving board
+#define MSG_LINK_MOVES 0x10
+#define LINK_MOVES_HEADER 3
+
+// Whether to report on the USB UART how many LCD window update bytes every
+// screen sent, and how many the driver saved by reusing the window
+#ifndef LCD_BYTE_REPORT
+#define LCD_BYTE_REPORT false
+#endif
+
+// Whether to report on the USB UART how long the board took from the start of
+// HAL construction to the first frame on the LCD
+#ifndef BOOT_TIME_REPORT
+#define BOOT_TIME_REPORT false
+#endif
+
+// Whether to run the CPU slow (at CLOCK_SLOW_HZ) while the board waits for
+// input, and how long after the last input, button press or frame it waits
+// before slowing down
+#ifndef CLOCK_GOVERNOR
+#define CLOCK_GOVERNOR true
+#endif
+#define CLOCK_IDLE_TIME_MS 500
+
+// Whether to sleep while the clock is slowed down and no input is waiting,
+// and the longest sleep between two loops. Screens which read characters
+// sleep in LPM0, all others in LPM3 (see HAL_sleep()).
+#ifndef POWER_SLEEP
+#define POWER_SLEEP true
+#endif
+#define SLEEP_TIME_MS 1000
+
+// Binary protocol messages from machine clients (framing in HAL/Frame.h)
+#define MSG_MOVES 0x01         // Moves for rounds of the running game
+#define MSG_MATCH 0x02         // Stand-alone batch of rounds
+#define MSG_PROFILE 0x03       // Profiler command (see HAL/Profiler.h)
+#define MSG_POWER 0x04         // Query of the time in each power mode
+#define MSG_COMMIT 0x05        // Commitment to one seat's move (HAL/Commit.h)
+#define MSG_REVEAL 0x06        // Reveal of one seat's committed move
+#define MSG_TAP 0x07           // Virtual tap of a button
+#define MSG_RESET 0x08         // Restart of the board
+#define MSG_BENCH 0x09         // Run of one benchmark case (HAL/Bench.h)
+#define MSG_TRACE 0x0A         // Trace command (see HAL/Trace.h)
+#define MSG_METRICS 0x0B       // Snapshot of the metrics (see HAL/Metrics.h)
+#define MSG_RESULT 0x81        // Reply to MSG_MOVES
+#define MSG_MATCH_RESULT 0x82  // Reply to MSG_MATCH
+#define MSG_PROFILE_RESULT 0x83  // Reply to MSG_PROFILE
+#define MSG_POWER_RESULT 0x84  // Reply to MSG_POWER
+#define MSG_COMMIT_RESULT 0x85  // Reply to MSG_COMMIT
+#define MSG_REVEAL_RESULT 0x86  // Reply to MSG_REVEAL, but for the last one
+#define MSG_TAP_RESULT 0x87    // Reply to MSG_TAP
+#define MSG_RESET_RESULT 0x88  // Reply to MSG_RESET, sent before the restart
+#define MSG_BENCH_RESULT 0x89  // Reply to MSG_BENCH
+#define MSG_TRACE_RESULT 0x8A  // Reply to MSG_TRACE
+#define MSG_METRICS_RESULT 0x8B  // Reply to MSG_METRICS
+#define MSG_NACK 0xFF          // A frame was rejected
+
+// Reasons for rejecting a frame
+#define NACK_CORRUPT 0x01  // Bad CRC or encoding; the sequence number is lost
+#define NACK_TYPE 0x02     // Unknown message type
+#define NACK_STATE 0x03    // The game is not waiting for moves
+#define NACK_FORMAT 0x04   // Bad length, count or move
+#define NACK_COMMIT 0x05   // The revealed move does not open the commitment
+#define NACK_LATE 0x06     // The commit-reveal round ran out of time
+
+// Profiler commands, the one byte payload of MSG_PROFILE. Start and stop are
+// answered with the command byte. A dump is answered with a header frame of
+// the command, the number of frames which follow, and the samples taken and
+// dropped (32-bit little endian), then with frames of the command, the
+// number of frames still to follow and up to PROFILE_DUMP_SLOTS slots of PC,
+// LR and count (32-bit little endian each).
+#define PROFILE_STOP 0x00
+#define PROFILE_START 0x01
+#define PROFILE_DUMP 0x02
+#define PROFILE_DUMP_HEADER 2
+#define PROFILE_SLOT_BYTES 12
+#define PROFILE_DUMP_SLOTS \
+  ((FRAME_MAX_PAYLOAD - PROFILE_DUMP_HEADER) / PROFILE_SLOT_BYTES)
+
+// Commit-reveal rounds, for machine clients which each play one seat and must
+// not see each other's moves first. MSG_COMMIT carries a seat and its
+// COMMIT_LENGTH byte commitment, and is answered with the seat and the mask of
+// seats committed so far. Once every seat has committed, MSG_REVEAL carries a
+// seat, its move and its COMMIT_KEY_LENGTH byte key. It is answered with the
+// seat and the mask of seats revealed so far, and the last reveal with the
+// MSG_RESULT of the round. The commitment is for round rounds played + 1.
+// Every seat must have revealed within COMMIT_DEADLINE_MS of the first
+// commitment; otherwise the round is given up, the commitments are dropped,
+// the round is open to human input again, and late reveals are rejected with
+// NACK_LATE.
+#define COMMIT_HEADER 1
+#define REVEAL_HEADER 2
+#define COMMIT_DEADLINE_MS 10000
+
+// MSG_POWER has no payload. It is answered with the milliseconds spent in
+// each PowerMode, in order, and the number of sleeps (32-bit little endian
+// each).
+#define POWER_RESULT_LENGTH ((NUM_POWER_MODES + 1) * 4)
+
+// MSG_TAP carries one of the buttons below, which then reads as tapped for
+// the loop the frame arrived in. It is answered with the button and the
+// screen shown before the tap. Several taps of one button in the same loop
+// count as one. MSG_RESET has no payload; the board restarts once the empty
+// reply is sent, and detects the terminal's baudrate again.
+#define TAP_LAUNCHPAD_S1 0
+#define TAP_LAUNCHPAD_S2 1
+#define TAP_BOOSTERPACK_S1 2
+#define TAP_BOOSTERPACK_S2 3
+#define TAP_BOOSTERPACK_JS 4
+#define TAP_RESULT_LENGTH 2
+
+// MSG_BENCH carries a case number and a number of repetitions. It is answered
+// with the case, the number of cases, the repetitions run, the clock
+// frequency in Hz and the min, median, p99 and max cycle counts (32-bit
+// little endian each), followed by the name of the case. The renderer cases
+// are rejected with NACK_STATE unless the board shows the title screen.
+// tools/bench.py runs all cases and writes the results as JSON.
+#define BENCH_RESULT_HEADER 23
+
+// Trace commands, the one byte payload of MSG_TRACE. Start and stop are
+// answered with the command byte. A dump is answered with a header frame of
+// the command, the number of frames which follow, the number of records
+// written since the start and SYSTEM_CLOCK (32-bit little endian each), then
+// with frames of the command, the number of frames still to follow and up to
+// TRACE_DUMP_RECORDS records, oldest first. A record is its time (32-bit
+// little endian), point, phase and argument (16-bit little endian). A
+// running trace is stopped for the dump and started again, empty, after it.
+#define TRACE_STOP 0x00
+#define TRACE_START 0x01
+#define TRACE_DUMP 0x02
+#define TRACE_DUMP_HEADER 2
+#define TRACE_RECORD_BYTES 8
+#define TRACE_DUMP_RECORDS \
+  ((FRAME_MAX_PAYLOAD - TRACE_DUMP_HEADER) / TRACE_RECORD_BYTES)
+
+// MSG_METRICS has no payload. It is answered with the number of counters and
+// of gauges, then every Metric and every Gauge in order (32-bit little endian
+// each).
+#define METRICS_RESULT_LENGTH (2 + (NUM_METRICS + NUM_GAUGES) * 4)
+
+// Size of a character of the fixed 6x8 font used on every screen, which
+// grlib and HAL/Text.h draw alike
+#define FONT_WIDTH TEXT_FONT_WIDTH
+#define FONT_HEIGHT TEXT_FONT_HEIGHT
+
+// Values a display list item can show in place of constant text
+typedef enum {
+  FIELD_NONE,           // The item's constant text
+  FIELD_ROUNDS,         // Number of rounds chosen in the settings
+  FIELD_PLAYERS,        // Number of players chosen in the settings
+  FIELD_ROUNDS_COUNT,   // Number of rounds played so far
+  FIELD_PLAYER_NUMBER,  // The item's player number, as "1)"
+  FIELD_NAME,           // The item's player name
+  FIELD_CHOICE,         // The item's player choice in the last round
+  FIELD_WINS            // The item's player wins
+} display_field;
+
+// Player of items shown whatever the number of players
+#define ANY_PLAYER 0xFF
+
+// One item of a screen layout. The window is the exact area of the panel the
+// item covers. The text is streamed into the window in one pass (see
+// Text_draw()), and rest_display() uses the windows to find the rows a screen
+// occupies.
+struct _DisplayItem {
+  const char* text; // Constant text, for FIELD_NONE items
+  display_field field; // Value shown instead of the constant text
+  uint8_t player; // Player the item belongs to, or ANY_PLAYER
+  uint32_t color; // Foreground colour of the text
+  Graphics_Rectangle window; // Area covered by the item
+};
+typedef struct _DisplayItem DisplayItem;
+
+// Evaluates to 0 if an item of the given width in characters fits on the
+// panel, and stops the build with a negative array size otherwise
+#define DISPLAY_CHECK(x, y, width) \
+  (0 * sizeof(char[((x) + (width) * FONT_WIDTH <= LCD_HORIZONTAL_MAX && \
+                    (y) + FONT_HEIGHT <= LCD_VERTICAL_MAX) ? 1 : -1]))
+
+// Display list items. A text item is as wide as its string, a field item as
+// wide as the given number of characters.
+#define DISPLAY_ITEM(text, field, player, x, y, width, color)              \
+  { text, field, player, color,                                            \
+    { (x) + DISPLAY_CHECK(x, y, width), y, (x) + (width) * FONT_WIDTH - 1, \
+      (y) + FONT_HEIGHT - 1 } }
+#define DISPLAY_TEXT(x, y, text) \
+  DISPLAY_ITEM(text, FIELD_NONE, ANY_PLAYER, x, y, sizeof(text) - 1, GRAPHICS_COLOR_WHITE)
+#define DISPLAY_PLAYER_TEXT(player, x, y, text) \
+  DISPLAY_ITEM(text, FIELD_NONE, player, x, y, sizeof(text) - 1, GRAPHICS_COLOR_WHITE)
+#define DISPLAY_FIELD(field, player, x, y, width) \
+  DISPLAY_ITEM(NULL, field, player, x, y, width, GRAPHICS_COLOR_WHITE)
+
+// Number of items of a display list
+#define DISPLAY_LIST_LENGTH(list) (sizeof(list) / sizeof((list)[0]))
+
+// Widths of the fields, in characters
+#define NUMBER_WIDTH 2
+#define NAME_WIDTH (MAX_NAME_LENGTH - 1)
+#define CHOICE_WIDTH (CHOICE_LENGTH - 1)
+
+// Room to remember what a field showed, enough for the widest field. Constant
+// text is not remembered, as it only changes on a full redraw
+#define FIELD_CACHE_WIDTH (NAME_WIDTH + 1)
+
+// Items of the scoreboard: the name, choice, "wins:" and wins of every
+// player, then the round
+#define SCORES_ITEMS ((MAX_PLAYERS - 1) * 4 + 2)
+
 // Structure for the Application object
 struct _Application {
   // Put your application members and FSM state variables here!
@@ -70,6 +329,37 @@ struct _Application {
   int rounds_count; // Count of rounds
   int wins[MAX_PLAYERS - 1]; // Array to store player wins
   bool end;
+  SWTimer framingTimer; // Timer for the framing error check period
+  uint32_t framingErrorsSeen; // UART framing errors at the start of the period
+  char rxChar; // Character received during this loop
+  bool rxPending; // Flag indicating rxChar has not been read yet
+  Frame frame; // Receiver for binary frames from machine clients
+  uint32_t frameErrorsSeen; // Dropped frames already reported to the client
+  bool seatLinks; // Flag indicating every seat has its own UART
+  uint8_t seats_moved; // Mask of the seats whose move for this round is in
+  bool seats_prompted; // Flag indicating the seats were prompted this round
+  bool boardLink; // Flag indicating the game is shared with a second board
+  // Moves of the other board's seats and the round they belong to, -1 while
+  // none arrived. The other board can be one round ahead, so rounds
+  // alternate between two slots.
+  char link_moves[2][MAX_PLAYERS - 1];
+  int link_moves_round[2];
+  bool link_sent; // Flag indicating this board's moves are on their way
+  bool link_waiting; // Flag indicating the wait for the other board was shown
+  bool scores_drawn; // Flag indicating the scoreboard is on the game screen
+  char scores_shown[SCORES_ITEMS][FIELD_CACHE_WIDTH]; // What each scoreboard item showed
+  char icons_shown[MAX_PLAYERS - 1]; // Choice each scoreboard icon showed
+  bool title_drawn; // Flag indicating the title screen was drawn at start up
+  screen reported_screen; // Screen whose LCD bytes were last reported
+  bool boot_reported; // Flag indicating the boot time was reported
+  SWTimer idleTimer; // Restarted on every input, slows the clock on expiry
+  uint8_t commitments[MAX_PLAYERS - 1][COMMIT_LENGTH]; // Of this round
+  uint8_t seats_committed; // Mask of the seats which committed this round
+  uint8_t seats_revealed; // Mask of the seats which revealed this round
+  uint8_t revealed_moves[MAX_PLAYERS - 1]; // Moves revealed this round
+  SWTimer commitTimer; // Started by the first commitment of a round
+  bool commit_late; // Flag indicating the last commit-reveal round was given up
+  ScrollLog match_log; // Log of the rounds played, on the game screen
 };
 typedef struct _Application Application;
 
@@ -82,9 +372,39 @@ void Application_loop(Application* app, HAL* hal);
 // Updates communications settings
 void Application_updateCommunications(Application* app, HAL* hal);
 
+// Lights the LEDs which identify the current baud rate
+void Application_showBaudChoice(Application* app, HAL* hal);
+
+// Runs the automatic baud rate detection and restarts it on framing errors
+void Application_updateAutoBaud(Application* app, HAL* hal);
+
+// Runs the CPU at full speed while there is work and slow while idle
+void Application_governClock(Application* app, HAL* hal);
+
+// Sleeps until the next input while the board is idle
+void Application_sleep(Application* app, HAL* hal);
+
+// Starts a new automatic baud rate detection
+void Application_startAutoBaud(Application* app, HAL* hal);
+
 // Interprets incoming character and echoes back to terminal what kind of character was received
 char Application_interpretIncomingChar(char);
 
+// Reads the next UART character, handling binary frames on the way
+void Application_receive(Application* app, HAL* hal);
+
+// Hands out the character received during this loop, if any
+bool Application_getChar(Application* app, char* rxChar_p);
+
+// Discards the character received during this loop
+void Application_flushChar(Application* app);
+
+// Exchanges moves with the linked board and recovers from a lost link
+void Application_updateLink(Application* app, HAL* hal);
+
+// Dispatches a binary frame from a machine client
+void Application_handleFrame(Application* app, HAL* hal, FrameMessage* message_p);
+
 // Generic circular increment function
 uint32_t CircularIncrement(uint32_t value, uint32_t maximum);
 
@@ -92,6 +412,11 @@ uint32_t CircularIncrement(uint32_t value, uint32_t maximum);
 void Game_FSM(Application* app_p, HAL* hal_p);
 
 // Function declarations for printing different screens
+void draw_display_list(Application* app_p, HAL* hal_p, const DisplayItem* items, int count);
+void update_display_list(Application* app_p, HAL* hal_p, const DisplayItem* items, int count,
+                         char (*shown)[FIELD_CACHE_WIDTH], bool redraw);
+void draw_string(HAL* hal_p, const char* text, int x, int y);
+void rest_display(HAL* hal_p, const DisplayItem* items, int count);
 void print_title(Application* app_p, HAL* hal_p);
 void print_instructions(Application* app_p, HAL* hal_p);
 void print_settings(Application* app_p, HAL* hal_p, bool PR, bool rst);
@@ -108,7 +433,16 @@ void uart_name(HAL* hal_p, char* name);
 void uart_new_line(HAL* hal_p);
 void invalid_input(HAL* hal_p);
 void game_round(Application* app_p, HAL* hal_p);
+void game_round_seats(Application* app_p, HAL* hal_p);
+void uart_send_string(UART* uart_p, const char* text);
+void report_lcd_bytes(Application* app_p, HAL* hal_p);
+void report_boot_time(Application* app_p, HAL* hal_p);
+void game_round_linked(Application* app_p, HAL* hal_p);
+bool link_owns_seat(int seat);
+void link_send_moves(Application* app_p, HAL* hal_p);
+void link_resolve_round(Application* app_p, HAL* hal_p);
 void print_scores(Application* app_p, HAL* hal_p);
+const Sprite* choice_icon(char choice);
 void print_BB1(Application* app_p, HAL* hal_p);
 void print_BB1_end(Application* app_p, HAL* hal_p);
 void print_BB1_end_screen(Application* app_p, HAL* hal_p);
@@ -120,5 +454,23 @@ void settings_screen_state(Application* app_p, HAL* hal_p);
 void selection_screen_state(Application* app_p, HAL* hal_p);
 void game_screen_state(Application* app_p, HAL* hal_p);
 void end_screen_state(Application* app_p, HAL* hal_p);
+bool valid_moves(const uint8_t* moves, int count);
+uint8_t play_round(Application* app_p, const uint8_t* moves);
+uint8_t resolve_round(Application* app_p);
+void log_round(Application* app_p, HAL* hal_p, uint8_t winners);
+void bot_nack(HAL* hal_p, uint8_t seq, uint8_t reason);
+void bot_moves(Application* app_p, HAL* hal_p, FrameMessage* message_p);
+void bot_match(HAL* hal_p, FrameMessage* message_p);
+void bot_profile(HAL* hal_p, FrameMessage* message_p);
+void bot_power(HAL* hal_p, FrameMessage* message_p);
+void bot_commit(Application* app_p, HAL* hal_p, FrameMessage* message_p);
+void bot_reveal(Application* app_p, HAL* hal_p, FrameMessage* message_p);
+bool commit_deadline_passed(Application* app_p);
+void bot_result(Application* app_p, HAL* hal_p, uint8_t seq, uint8_t* reply, int length);
+void bot_tap(Application* app_p, HAL* hal_p, FrameMessage* message_p);
+void bot_reset(HAL* hal_p, FrameMessage* message_p);
+void bot_bench(Application* app_p, HAL* hal_p, FrameMessage* message_p);
+void bot_trace(HAL* hal_p, FrameMessage* message_p);
+void bot_metrics(HAL* hal_p, FrameMessage* message_p);
 
 #endif /* APPLICATION_H_ */
@@ -0,0 +1,194 @@
+/*
+ * AutoBaud.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <HAL/AutoBaud.h>
+#include <HAL/RamFunc.h>
+
+/** Timestamps (TIMER32_0_BASE values) of the RX line edges seen so far */
+static volatile uint32_t edgeTimes[AUTOBAUD_MAX_EDGES];
+
+/** Number of valid entries in edgeTimes */
+static volatile uint32_t edgeCount = 0;
+
+/** Whether a detection is running. The RX pin also wakes the board from LPM3
+ * (see HAL_sleep()), and those edges are not timestamped. */
+static volatile bool detecting = false;
+
+/**
+ * The ISR which timestamps every edge of the USB UART RX line while a
+ * detection is running. After each edge the trigger is flipped so that the
+ * opposite edge is captured next. DO NOT DIRECTLY INVOKE THIS FUNCTION.
+ */
+RAMFUNC void PORT1_IRQHandler() {
+  uint32_t now = Timer32_getValue(TIMER32_0_BASE);
+  uint_fast16_t status = GPIO_getEnabledInterruptStatus(USB_UART_PORT);
+  GPIO_clearInterruptFlag(USB_UART_PORT, status);
+
+  if (detecting && (status & USB_UART_RX_PIN)) {
+    if (edgeCount < AUTOBAUD_MAX_EDGES) {
+      edgeTimes[edgeCount] = now;
+      edgeCount++;
+    }
+
+    // Even edge counts wait for a falling edge, odd ones for a rising edge
+    if (edgeCount % 2 == 0) {
+      GPIO_interruptEdgeSelect(USB_UART_PORT, USB_UART_RX_PIN,
+                               GPIO_HIGH_TO_LOW_TRANSITION);
+    } else {
+      GPIO_interruptEdgeSelect(USB_UART_PORT, USB_UART_RX_PIN,
+                               GPIO_LOW_TO_HIGH_TRANSITION);
+    }
+  }
+}
+
+/**
+ * Constructs an auto-baud detector which is not yet running.
+ *
+ * @return the constructed detector
+ */
+AutoBaud AutoBaud_construct() {
+  AutoBaud autoBaud;
+
+  autoBaud.running = false;
+  autoBaud.edgesSeen = 0;
+  autoBaud.idleTimer = SWTimer_construct(AUTOBAUD_IDLE_TIME_MS);
+
+  return autoBaud;
+}
+
+/**
+ * Starts a detection. The RX pin is switched to a GPIO input which interrupts
+ * on the falling edge of the next start bit.
+ *
+ * @param autoBaud_p:   The detector to start
+ * @param uart_p:       The USB UART whose RX line is measured
+ */
+void AutoBaud_start(AutoBaud* autoBaud_p, UART* uart_p) {
+  Interrupt_disableInterrupt(INT_PORT1);
+
+  edgeCount = 0;
+  autoBaud_p->edgesSeen = 0;
+  autoBaud_p->running = true;
+  detecting = true;
+
+  GPIO_setAsInputPinWithPullUpResistor(uart_p->port, USB_UART_RX_PIN);
+  GPIO_interruptEdgeSelect(uart_p->port, USB_UART_RX_PIN,
+                           GPIO_HIGH_TO_LOW_TRANSITION);
+  GPIO_clearInterruptFlag(uart_p->port, USB_UART_RX_PIN);
+  GPIO_enableInterrupt(uart_p->port, USB_UART_RX_PIN);
+
+  Interrupt_enableInterrupt(INT_PORT1);
+}
+
+/**
+ * Stops a detection, whether it finished or not, and gives the RX pin back to
+ * the UART.
+ *
+ * @param autoBaud_p:   The detector to stop
+ * @param uart_p:       The USB UART whose RX line was measured
+ */
+void AutoBaud_stop(AutoBaud* autoBaud_p, UART* uart_p) {
+  GPIO_disableInterrupt(uart_p->port, USB_UART_RX_PIN);
+  GPIO_clearInterruptFlag(uart_p->port, USB_UART_RX_PIN);
+  GPIO_setAsPeripheralModuleFunctionInputPin(uart_p->port, USB_UART_RX_PIN,
+                                             GPIO_PRIMARY_MODULE_FUNCTION);
+
+  autoBaud_p->running = false;
+  detecting = false;
+}
+
+/**
+ * Returns whether a detection is in progress.
+ *
+ * @param autoBaud_p:   The detector to query
+ *
+ * @return true while the RX line is being measured
+ */
+bool AutoBaud_isRunning(AutoBaud* autoBaud_p) { return autoBaud_p->running; }
+
+/**
+ * Returns whether a running detection has timestamped an edge of the RX line.
+ *
+ * @param autoBaud_p:   The detector to query
+ *
+ * @return true once the measurement has begun
+ */
+bool AutoBaud_hasEdges(AutoBaud* autoBaud_p) {
+  return autoBaud_p->running && edgeCount > 0;
+}
+
+/**
+ * Advances a running detection. The measurement is evaluated once the edge
+ * buffer is full, or once enough edges were seen and the line has been quiet
+ * for AUTOBAUD_IDLE_TIME_MS. The shortest pulse is taken as one bit time and
+ * matched against the bit time of every baudrate up to AUTOBAUD_MAX_CHOICE.
+ * A pulse shorter than half the fastest of those bit times cannot be timed
+ * reliably, so the measurement is dropped and a new one started.
+ *
+ * @param autoBaud_p:     The detector to advance
+ * @param uart_p:         The USB UART whose RX line is measured
+ * @param baudChoice_p:   Receives the detected baudrate
+ *
+ * @return true if a baudrate was detected during this call
+ */
+bool AutoBaud_refresh(AutoBaud* autoBaud_p, UART* uart_p,
+                      UART_Baudrate* baudChoice_p) {
+  if (!autoBaud_p->running) {
+    return false;
+  }
+
+  // Any new edge restarts the quiet-line timer
+  uint32_t edges = edgeCount;
+  if (edges != autoBaud_p->edgesSeen) {
+    autoBaud_p->edgesSeen = edges;
+    SWTimer_start(&autoBaud_p->idleTimer);
+  }
+
+  bool bufferFull = edges >= AUTOBAUD_MAX_EDGES;
+  bool lineQuiet = edges >= AUTOBAUD_MIN_EDGES &&
+                   SWTimer_expired(&autoBaud_p->idleTimer);
+  if (!bufferFull && !lineQuiet) {
+    return false;
+  }
+
+  GPIO_disableInterrupt(uart_p->port, USB_UART_RX_PIN);
+
+  // The reference timer counts down, so earlier edges have larger values
+  uint32_t shortestPulse = LOADVALUE;
+  uint32_t i;
+  for (i = 1; i < edges; i++) {
+    uint32_t pulse = edgeTimes[i - 1] - edgeTimes[i];
+    if (pulse < shortestPulse) {
+      shortestPulse = pulse;
+    }
+  }
+
+  uint32_t shortestBitTime =
+      HW_TIMER_CLOCK / UART_baudRateValue(AUTOBAUD_MAX_CHOICE);
+  if (shortestPulse < shortestBitTime / 2) {
+    AutoBaud_start(autoBaud_p, uart_p);
+    return false;
+  }
+
+  // Pick the baudrate whose bit time is relatively closest to the pulse
+  UART_Baudrate bestChoice = BAUD_9600;
+  uint64_t bestError = UINT64_MAX;
+  for (i = 0; i <= AUTOBAUD_MAX_CHOICE; i++) {
+    uint32_t bitTime = HW_TIMER_CLOCK / UART_baudRateValue((UART_Baudrate)i);
+    uint32_t difference = shortestPulse > bitTime ? shortestPulse - bitTime
+                                                  : bitTime - shortestPulse;
+    uint64_t error = ((uint64_t)difference << 16) / bitTime;
+    if (error < bestError) {
+      bestError = error;
+      bestChoice = (UART_Baudrate)i;
+    }
+  }
+
+  AutoBaud_stop(autoBaud_p, uart_p);
+  *baudChoice_p = bestChoice;
+
+  return true;
+}
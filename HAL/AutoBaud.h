@@ -0,0 +1,79 @@
+/*
+ * AutoBaud.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef HAL_AUTOBAUD_H_
+#define HAL_AUTOBAUD_H_
+
+#include <HAL/Timer.h>
+#include <HAL/UART.h>
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+// Number of RX line edges after which the measurement is always evaluated
+#define AUTOBAUD_MAX_EDGES 32
+
+// Minimum number of RX line edges needed before a quiet line ends the
+// measurement. One ordinary character produces at least this many.
+#define AUTOBAUD_MIN_EDGES 4
+
+// How long the RX line has to stay quiet before the edges collected so far
+// are evaluated
+#define AUTOBAUD_IDLE_TIME_MS 20
+
+// Fastest baudrate the edge timestamps can tell apart from its neighbours.
+// Faster UART_Baudrate choices are never detected.
+#define AUTOBAUD_MAX_CHOICE BAUD_230400
+
+/**=============================================================================
+ * Automatic baudrate detection for the USB (backchannel) UART. While a
+ * detection runs, the RX pin is taken away from EUSCI_A0 and used as a GPIO
+ * interrupt whose handler timestamps every edge against the TIMER32_0_BASE
+ * reference timer. The shortest time between two edges is one bit time, which
+ * is then matched to the closest UART_Baudrate up to AUTOBAUD_MAX_CHOICE.
+ * =============================================================================
+ * USAGE WARNINGS
+ * =============================================================================
+ * The characters used for the measurement are consumed and never reach the
+ * UART. A character with single-bit pulses, such as 'U', gives the most
+ * reliable result. The edge timestamps are taken in an interrupt handler, so
+ * detection is dependable up to AUTOBAUD_MAX_CHOICE; a pulse shorter than
+ * half its bit time is a glitch or a faster rate, and the measurement starts
+ * over. The timestamps are
+ * matched against bit times at SYSTEM_CLOCK, so the clock must not be slowed
+ * down (see Clock.h) while edges are collected.
+ */
+struct _AutoBaud {
+  // Whether a detection is in progress
+  bool running;
+
+  // Number of edges seen at the last refresh, used to notice new activity
+  uint32_t edgesSeen;
+
+  // Restarted on every new edge; the measurement ends when it expires
+  SWTimer idleTimer;
+};
+typedef struct _AutoBaud AutoBaud;
+
+// Constructs an idle auto-baud detector
+AutoBaud AutoBaud_construct();
+
+// Starts a detection on the USB UART's RX line
+void AutoBaud_start(AutoBaud* autoBaud_p, UART* uart_p);
+
+// Aborts a detection and gives the RX line back to the UART
+void AutoBaud_stop(AutoBaud* autoBaud_p, UART* uart_p);
+
+// Returns true while a detection is in progress
+bool AutoBaud_isRunning(AutoBaud* autoBaud_p);
+
+// Returns true once a running detection has seen an edge
+bool AutoBaud_hasEdges(AutoBaud* autoBaud_p);
+
+// Advances the detection. Returns true once a baudrate has been detected and
+// stores it in baudChoice_p; the RX line is then already given back.
+bool AutoBaud_refresh(AutoBaud* autoBaud_p, UART* uart_p,
+                      UART_Baudrate* baudChoice_p);
+
+#endif /* HAL_AUTOBAUD_H_ */
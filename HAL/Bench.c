@@ -0,0 +1,103 @@
+/*
+ * Bench.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <HAL/Bench.h>
+
+// Cycles a measurement of an empty function takes
+static uint32_t overhead = 0;
+
+// Cycle counts of the repetitions of the current run
+static uint32_t samples[BENCH_MAX_REPETITIONS];
+
+static void Bench_empty(void* context_p) {}
+
+/**
+ * Times a single call of a function in CPU cycles, with interrupts disabled.
+ *
+ * @param function:   The function to call
+ * @param context_p:  The context to call it with
+ *
+ * @return the cycles the call took, including the measuring overhead
+ */
+static uint32_t Bench_measure(BenchFunction function, void* context_p) {
+  uint32_t start, end;
+  bool enabled = !Interrupt_disableMaster();
+
+  start = DWT->CYCCNT;
+  function(context_p);
+  end = DWT->CYCCNT;
+
+  if (enabled) {
+    Interrupt_enableMaster();
+  }
+
+  return end - start;
+}
+
+/**
+ * Enables the DWT cycle counter, which counts at the CPU clock, and measures
+ * how many cycles the measurement itself takes. The smallest of a few
+ * measurements of an empty function is taken as the overhead.
+ */
+void Bench_enable(void) {
+  int i;
+
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  overhead = Bench_measure(Bench_empty, NULL);
+  for (i = 0; i < BENCH_WARMUP; i++) {
+    uint32_t cycles = Bench_measure(Bench_empty, NULL);
+    if (cycles < overhead) {
+      overhead = cycles;
+    }
+  }
+}
+
+/**
+ * Runs a benchmark and sums up the cycle counts of its repetitions. The
+ * percentiles are taken by nearest rank, so the p99 of fewer than 100
+ * repetitions is the slowest one.
+ *
+ * @param function:     The code under test
+ * @param context_p:    The context the code is called with
+ * @param repetitions:  Number of timed calls, at most BENCH_MAX_REPETITIONS
+ * @param result_p:     Receives the cycle counts, less the overhead
+ */
+void Bench_run(BenchFunction function, void* context_p, uint16_t repetitions,
+               BenchResult* result_p) {
+  int i, j;
+
+  if (repetitions > BENCH_MAX_REPETITIONS) {
+    repetitions = BENCH_MAX_REPETITIONS;
+  }
+
+  for (i = 0; i < BENCH_WARMUP; i++) {
+    function(context_p);
+  }
+
+  // Measure, keeping the samples sorted
+  for (i = 0; i < repetitions; i++) {
+    uint32_t cycles = Bench_measure(function, context_p);
+    cycles = cycles > overhead ? cycles - overhead : 0;
+
+    for (j = i; j > 0 && samples[j - 1] > cycles; j--) {
+      samples[j] = samples[j - 1];
+    }
+    samples[j] = cycles;
+  }
+
+  result_p->repetitions = repetitions;
+  if (repetitions == 0) {
+    result_p->min = result_p->median = result_p->p99 = result_p->max = 0;
+    return;
+  }
+
+  result_p->min = samples[0];
+  result_p->median = samples[(repetitions - 1) / 2];
+  result_p->p99 = samples[(repetitions * 99 + 99) / 100 - 1];
+  result_p->max = samples[repetitions - 1];
+}
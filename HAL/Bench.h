@@ -0,0 +1,59 @@
+/*
+ * Bench.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef HAL_BENCH_H_
+#define HAL_BENCH_H_
+
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+// Untimed calls before the measured repetitions, which fill the caches and
+// bring the code under test into a steady state
+#define BENCH_WARMUP 4
+
+// Most repetitions a single run can measure
+#define BENCH_MAX_REPETITIONS 64
+
+// The code under test, given the context it was registered with
+typedef void (*BenchFunction)(void* context_p);
+
+// A named piece of code under test
+struct _BenchCase {
+  const char* name;
+  BenchFunction function;
+};
+typedef struct _BenchCase BenchCase;
+
+// Cycle counts of the repetitions of one run, less the measuring overhead
+struct _BenchResult {
+  uint32_t min;
+  uint32_t median;
+  uint32_t p99;
+  uint32_t max;
+  uint16_t repetitions;
+};
+typedef struct _BenchResult BenchResult;
+
+/**=============================================================================
+ * A micro-benchmark harness counting CPU cycles with the DWT cycle counter.
+ * Every repetition is timed on its own with interrupts disabled, so the
+ * counts are not disturbed by the UART or timer interrupts.
+ * =============================================================================
+ * USAGE WARNINGS
+ * =============================================================================
+ * Code which waits for an interrupt cannot be measured. A character arriving
+ * on a UART during a long repetition waits in the receive register, and a
+ * second one overruns it.
+ */
+
+// Starts the cycle counter and measures the overhead of a measurement
+void Bench_enable(void);
+
+// Runs a function BENCH_WARMUP times untimed and then repetitions times
+// timed, at most BENCH_MAX_REPETITIONS
+void Bench_run(BenchFunction function, void* context_p, uint16_t repetitions,
+               BenchResult* result_p);
+
+#endif /* HAL_BENCH_H_ */
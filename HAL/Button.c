@@ -7,6 +7,28 @@
  */
 
 #include <HAL/Button.h>
+#include <HAL/RamFunc.h>
+
+/**
+ * The ISRs of the ports whose pin interrupts only wake the board from a sleep
+ * (see Button_enableWake()). The buttons are still read by polling, so the
+ * handlers only clear the flags. Port 1 shares its ISR with the baudrate
+ * detector, see AutoBaud.c. DO NOT DIRECTLY INVOKE THESE FUNCTIONS.
+ */
+RAMFUNC void PORT3_IRQHandler() {
+  GPIO_clearInterruptFlag(GPIO_PORT_P3,
+                          GPIO_getEnabledInterruptStatus(GPIO_PORT_P3));
+}
+
+RAMFUNC void PORT4_IRQHandler() {
+  GPIO_clearInterruptFlag(GPIO_PORT_P4,
+                          GPIO_getEnabledInterruptStatus(GPIO_PORT_P4));
+}
+
+RAMFUNC void PORT5_IRQHandler() {
+  GPIO_clearInterruptFlag(GPIO_PORT_P5,
+                          GPIO_getEnabledInterruptStatus(GPIO_PORT_P5));
+}
 
 /**
  * Constructs a button as a GPIO pushbutton, given a proper port and pin.
@@ -43,6 +65,44 @@ Button Button_construct(uint8_t port, uint16_t pin) {
   return button;
 }
 
+/**
+ * Returns whether the button is released and settled, so that nothing about it
+ * can change until it is pressed again. Unlike the other getters, this reads
+ * the pin, to catch a press which the debouncing FSM has not seen yet.
+ *
+ * @param button:   The Button object to check
+ *
+ * @return true if the button is released and not bouncing
+ */
+bool Button_isIdle(Button* button) {
+  return button->debounceState == StableR &&
+         GPIO_getInputPinValue(button->port, button->pin) == RELEASED;
+}
+
+/**
+ * Makes a press of the button raise its port interrupt, which wakes the board
+ * from a sleep. The press itself is still seen by [Button_refresh()].
+ *
+ * @param button:   The Button object which should wake the board
+ */
+void Button_enableWake(Button* button) {
+  GPIO_interruptEdgeSelect(button->port, button->pin,
+                           GPIO_HIGH_TO_LOW_TRANSITION);
+  GPIO_clearInterruptFlag(button->port, button->pin);
+  GPIO_enableInterrupt(button->port, button->pin);
+  Interrupt_enableInterrupt(INT_PORT1 + (button->port - GPIO_PORT_P1));
+}
+
+/**
+ * Stops a press of the button from raising its port interrupt.
+ *
+ * @param button:   The Button object which should no longer wake the board
+ */
+void Button_disableWake(Button* button) {
+  GPIO_disableInterrupt(button->port, button->pin);
+  GPIO_clearInterruptFlag(button->port, button->pin);
+}
+
 /**
  * A getter method which should just return whether the user currently has held
  * down the button. This should be determined using the pushState which was
@@ -69,13 +129,22 @@ bool Button_isPressed(Button* button) { return button->pushState == PRESSED; }
  */
 bool Button_isTapped(Button* button) { return button->isTapped; }
 
+/**
+ * Taps a button without it being pressed, for a machine driving the board.
+ * The tap is seen by everything which asks for it until the next call to
+ * [Button_refresh()], which then works out the outputs from the pin again.
+ *
+ * @param button:   The Button object to tap
+ */
+void Button_tap(Button* button) { button->isTapped = true; }
+
 /**
  * Refreshes the input of the provided Button by polling for the new GPIO input
  * pin value and advancing the debouncing FSM by one step.
  *
  * @param button:   The Button object to refresh
  */
-void Button_refresh(Button* button) {
+RAMFUNC void Button_refresh(Button* button) {
   // Retrieve the port and pin targets
   uint8_t port = button->port;
   uint16_t pin = button->pin;
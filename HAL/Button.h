@@ -94,6 +94,18 @@ bool Button_isPressed(Button* button);
 /** Given a button, determines if it was "tapped" - pressed down and released */
 bool Button_isTapped(Button* button);
 
+/** Makes a button read as tapped until the next [Button_refresh()] */
+void Button_tap(Button* button);
+
+/** Given a button, determines if it is released and not bouncing */
+bool Button_isIdle(Button* button);
+
+/** Makes a press of this button wake the board from a sleep */
+void Button_enableWake(Button* button);
+
+/** Stops a press of this button from waking the board */
+void Button_disableWake(Button* button);
+
 /** Refreshes this button so the Button FSM now has new outputs to interpret */
 void Button_refresh(Button* button);
 
@@ -0,0 +1,69 @@
+/*
+ * Clock.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <HAL/Clock.h>
+#include <HAL/Timer.h>
+
+/** The clock speed set by InitSystemTiming() */
+static ClockSpeed currentSpeed = CLOCK_FAST;
+
+/**
+ * Returns the speed the system currently runs at.
+ *
+ * @return CLOCK_FAST or CLOCK_SLOW
+ */
+ClockSpeed Clock_speed(void) { return currentSpeed; }
+
+/**
+ * Returns the frequency of MCLK, HSMCLK and SMCLK at a clock speed.
+ *
+ * @param speed:  The clock speed
+ *
+ * @return the frequency in Hz
+ */
+uint32_t Clock_speedHz(ClockSpeed speed) {
+  return speed == CLOCK_FAST ? SYSTEM_CLOCK : CLOCK_SLOW_HZ;
+}
+
+uint32_t Clock_hz(void) { return Clock_speedHz(currentSpeed); }
+
+/**
+ * Switches the DCO to the given speed. MCLK, HSMCLK and SMCLK keep the DCO as
+ * their source, so they all follow it.
+ *
+ * Flash reads need 2 wait states at SYSTEM_CLOCK (see InitSystemTiming()), so
+ * the wait states are raised BEFORE the clock speeds up and only lowered AFTER
+ * it has slowed down. Fetching from flash with too few wait states makes the
+ * board read garbage instructions.
+ *
+ * @param speed:  The new clock speed
+ */
+void Clock_setSpeed(ClockSpeed speed) {
+  if (speed == currentSpeed) {
+    return;
+  }
+
+  // No interrupt may run, or read the timers, while the clock is between
+  // speeds
+  bool enabled = !Interrupt_disableMaster();
+
+  if (speed == CLOCK_FAST) {
+    FlashCtl_setWaitState(FLASH_BANK0, 2);
+    FlashCtl_setWaitState(FLASH_BANK1, 2);
+    CS_setDCOFrequency(SYSTEM_CLOCK);
+  } else {
+    CS_setDCOFrequency(CLOCK_SLOW_HZ);
+    FlashCtl_setWaitState(FLASH_BANK0, 0);
+    FlashCtl_setWaitState(FLASH_BANK1, 0);
+  }
+
+  currentSpeed = speed;
+  Timer_setCounterClock(Clock_hz());
+
+  if (enabled) {
+    Interrupt_enableMaster();
+  }
+}
@@ -0,0 +1,43 @@
+/*
+ * Clock.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef HAL_CLOCK_H_
+#define HAL_CLOCK_H_
+
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+// The clock speeds the system can run at. CLOCK_FAST is SYSTEM_CLOCK.
+typedef enum { CLOCK_FAST, CLOCK_SLOW } ClockSpeed;
+
+// MCLK, HSMCLK and SMCLK while the system runs slow, in Hz. Must divide
+// SYSTEM_CLOCK.
+#define CLOCK_SLOW_HZ 3000000
+
+/**=============================================================================
+ * Switches the DCO, from which MCLK, HSMCLK and SMCLK all run, between
+ * SYSTEM_CLOCK and CLOCK_SLOW_HZ. The flash wait states follow the clock, and
+ * the software timers are rebased so that they keep their timing.
+ * =============================================================================
+ * USAGE WARNINGS
+ * =============================================================================
+ * Every peripheral clocked from SMCLK must be reconfigured after a switch. Use
+ * HAL_setClockSpeed(), which does this for the UARTs and the LCD, rather than
+ * calling [Clock_setSpeed()] directly.
+ */
+
+// Returns the current clock speed
+ClockSpeed Clock_speed(void);
+
+// Returns the frequency of the given clock speed, in Hz
+uint32_t Clock_speedHz(ClockSpeed speed);
+
+// Returns the current frequency of MCLK and SMCLK, in Hz
+uint32_t Clock_hz(void);
+
+// Switches the system to the given clock speed
+void Clock_setSpeed(ClockSpeed speed);
+
+#endif /* HAL_CLOCK_H_ */
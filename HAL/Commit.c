@@ -0,0 +1,42 @@
+/*
+ * Commit.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <HAL/Commit.h>
+#include <string.h>
+
+/**
+ * Checks a revealed move against its commitment. The committed block is
+ * encrypted with the revealed key on the AES256 module, which takes a few
+ * hundred clock cycles, and compared with the commitment.
+ *
+ * @param commitment:   The COMMIT_LENGTH bytes the client committed to
+ * @param key:          The COMMIT_KEY_LENGTH byte key the client revealed
+ * @param round:        The round the move is for, starting at 1
+ * @param seat:         The seat the move is for, starting at 0
+ * @param move:         The revealed move
+ *
+ * @return true if the commitment was made for this move
+ */
+bool Commit_verify(const uint8_t* commitment, const uint8_t* key,
+                   uint8_t round, uint8_t seat, uint8_t move) {
+  uint8_t block[COMMIT_LENGTH];
+  uint8_t encrypted[COMMIT_LENGTH];
+  uint8_t difference = 0;
+  int i;
+
+  block[0] = round;
+  block[1] = seat;
+  block[2] = move;
+  memcpy(&block[3], COMMIT_TAG, COMMIT_TAG_LENGTH);
+
+  AES256_setCipherKey(AES256_BASE, key, AES256_KEYLENGTH_256BIT);
+  AES256_encryptData(AES256_BASE, block, encrypted);
+
+  for (i = 0; i < COMMIT_LENGTH; i++) {
+    difference |= encrypted[i] ^ commitment[i];
+  }
+  return difference == 0;
+}
@@ -0,0 +1,43 @@
+/*
+ * Commit.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef HAL_COMMIT_H_
+#define HAL_COMMIT_H_
+
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+// Length of a commitment, one AES block
+#define COMMIT_LENGTH 16
+
+// Length of the key a commitment is opened with, an AES-256 key
+#define COMMIT_KEY_LENGTH 32
+
+// The fixed bytes which fill the committed block after round, seat and move
+#define COMMIT_TAG "RPS commit v1"
+#define COMMIT_TAG_LENGTH 13
+
+/**=============================================================================
+ * Commitments to a move, checked with the AES256 accelerator. A client picks
+ * a random 32-byte key and commits to its move with
+ *
+ *     commitment = AES-256-encrypt(key, round | seat | move | COMMIT_TAG)
+ *
+ * and later reveals the move and the key. Without the key, the commitment
+ * tells nothing about the move. Opening it as a different move would need a
+ * second key which encrypts to the same block with all 13 tag bytes intact,
+ * which takes about 2^104 tries. tools/commit.py is the host reference.
+ * =============================================================================
+ * USAGE WARNINGS
+ * =============================================================================
+ * The key must be fresh for every commitment, or a client's earlier reveals
+ * give its later moves away.
+ */
+
+// Returns true if the commitment opens to the move with the key
+bool Commit_verify(const uint8_t* commitment, const uint8_t* key,
+                   uint8_t round, uint8_t seat, uint8_t move);
+
+#endif /* HAL_COMMIT_H_ */
@@ -0,0 +1,61 @@
+/*
+ * Format.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <HAL/Format.h>
+
+/**
+ * Writes the decimal digits of a value into a buffer, without going through
+ * the printf machinery of the runtime library. The digits are produced from
+ * the least significant one into a small local buffer and then copied out in
+ * order, so no division is needed to find the number of digits first.
+ *
+ * @param buffer:   Where the digits are written. Must have room for
+ *                  FORMAT_MAX_DECIMAL + 1 characters.
+ * @param value:    The value to write
+ *
+ * @return the number of digits written, not counting the '\0'
+ */
+int Format_decimal(char* buffer, uint32_t value) {
+  char digits[FORMAT_MAX_DECIMAL];
+  int count = 0;
+  int i;
+
+  do {
+    digits[count++] = '0' + value % 10;
+    value /= 10;
+  } while (value != 0);
+
+  for (i = 0; i < count; i++) {
+    buffer[i] = digits[count - 1 - i];
+  }
+  buffer[count] = '\0';
+
+  return count;
+}
+
+/**
+ * Writes a value as a fixed number of hexadecimal digits, using upper-case
+ * letters. Digits above the requested number are dropped.
+ *
+ * @param buffer:   Where the digits are written. Must have room for
+ *                  digits + 1 characters.
+ * @param value:    The value to write
+ * @param digits:   The number of digits to write, 1 to FORMAT_MAX_HEX
+ *
+ * @return the number of digits written, not counting the '\0'
+ */
+int Format_hex(char* buffer, uint32_t value, int digits) {
+  static const char hexDigits[] = "0123456789ABCDEF";
+  int i;
+
+  for (i = digits - 1; i >= 0; i--) {
+    buffer[i] = hexDigits[value & 0xF];
+    value >>= 4;
+  }
+  buffer[digits] = '\0';
+
+  return digits;
+}
@@ -0,0 +1,27 @@
+/*
+ * Format.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef HAL_FORMAT_H_
+#define HAL_FORMAT_H_
+
+#include <stdint.h>
+
+// Most characters Format_decimal() writes for a 32-bit value, without the
+// terminating '\0'
+#define FORMAT_MAX_DECIMAL 10
+
+// Most characters Format_hex() writes for a 32-bit value, without the
+// terminating '\0'
+#define FORMAT_MAX_HEX 8
+
+// Writes a value in decimal, followed by '\0'. Returns the number of digits.
+int Format_decimal(char* buffer, uint32_t value);
+
+// Writes a value in hexadecimal with a fixed number of digits, padded with
+// zeros, followed by '\0'. Returns the number of digits.
+int Format_hex(char* buffer, uint32_t value, int digits);
+
+#endif /* HAL_FORMAT_H_ */
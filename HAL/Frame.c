@@ -0,0 +1,226 @@
+/*
+ * Frame.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <HAL/Frame.h>
+#include <string.h>
+
+/**
+ * Constructs a frame receiver. The receiver ignores every byte until it sees
+ * the opening FRAME_DELIMITER of a frame.
+ *
+ * @return the constructed receiver
+ */
+Frame Frame_construct() {
+  Frame frame;
+
+  frame.receiving = false;
+  frame.discarding = false;
+  frame.rxLength = 0;
+  frame.errors = 0;
+
+  return frame;
+}
+
+/**
+ * Determines whether a received byte belongs to a frame. This is the case for
+ * every delimiter and for every byte between an opening delimiter and the
+ * closing one.
+ *
+ * @param frame_p:  The frame receiver
+ * @param rxByte:   The byte which was just received
+ *
+ * @return true if the byte must be handed to Frame_receiveByte()
+ */
+bool Frame_isReceiving(Frame* frame_p, uint8_t rxByte) {
+  return frame_p->receiving || rxByte == FRAME_DELIMITER;
+}
+
+/**
+ * Computes the CRC32 of a buffer using the CRC32 hardware module. The result
+ * matches the common CRC-32 (reflected polynomial 0xEDB88320, seed and final
+ * XOR 0xFFFFFFFF), so clients can check it with any standard library.
+ *
+ * @param data:     The bytes to checksum
+ * @param length:   The number of bytes to checksum
+ *
+ * @return the CRC32 of the buffer
+ */
+uint32_t Frame_crc32(const uint8_t* data, uint16_t length) {
+  uint16_t i;
+
+  CRC32_setSeed(FRAME_CRC_SEED, CRC32_MODE);
+  for (i = 0; i < length; i++) {
+    CRC32_set8BitData(data[i], CRC32_MODE);
+  }
+
+  return CRC32_getResultReversed(CRC32_MODE) ^ 0xFFFFFFFF;
+}
+
+/**
+ * Decodes a COBS-encoded buffer in place.
+ *
+ * @param buffer:   The encoded bytes, without delimiters
+ * @param length:   The number of encoded bytes
+ *
+ * @return the number of decoded bytes, or -1 if the encoding is broken
+ */
+static int32_t Frame_decode(uint8_t* buffer, uint16_t length) {
+  uint16_t in = 0;
+  uint16_t out = 0;
+
+  while (in < length) {
+    uint8_t code = buffer[in++];
+    uint8_t i;
+
+    if (code == 0 || in + code - 1 > length) {
+      return -1;
+    }
+
+    for (i = 1; i < code; i++) {
+      buffer[out++] = buffer[in++];
+    }
+
+    // A code below 0xFF stands for a zero, unless it ends the buffer
+    if (code < 0xFF && in < length) {
+      buffer[out++] = 0;
+    }
+  }
+
+  return out;
+}
+
+/**
+ * Feeds one received byte to the frame receiver. A delimiter closes the frame
+ * being received; the frame is then COBS-decoded and its CRC32 checked. Broken
+ * frames are counted and dropped. A frame which overflows the buffer is
+ * dropped as a whole: its remaining bytes and its closing delimiter are still
+ * taken, so that they are neither read as ASCII input nor as the opening of
+ * another frame.
+ *
+ * @param frame_p:    The frame receiver
+ * @param rxByte:     The byte which was just received
+ * @param message_p:  Receives the frame, if this byte completed a valid one
+ *
+ * @return true if a valid frame was received
+ */
+bool Frame_receiveByte(Frame* frame_p, uint8_t rxByte, FrameMessage* message_p) {
+  if (rxByte != FRAME_DELIMITER) {
+    if (frame_p->discarding) {
+      return false;
+    }
+    if (frame_p->rxLength < FRAME_MAX_ENCODED) {
+      frame_p->rxBuffer[frame_p->rxLength++] = rxByte;
+    } else {
+      // Too long to be a frame; drop the rest of it up to its delimiter
+      frame_p->errors++;
+      frame_p->discarding = true;
+      frame_p->rxLength = 0;
+    }
+    return false;
+  }
+
+  // The closing delimiter of an overflowed frame
+  if (frame_p->discarding) {
+    frame_p->discarding = false;
+    frame_p->receiving = false;
+    return false;
+  }
+
+  // An opening delimiter, or two delimiters in a row
+  if (!frame_p->receiving || frame_p->rxLength == 0) {
+    frame_p->receiving = true;
+    frame_p->rxLength = 0;
+    return false;
+  }
+
+  // A closing delimiter: the frame is complete
+  frame_p->receiving = false;
+  int32_t length = Frame_decode(frame_p->rxBuffer, frame_p->rxLength);
+  frame_p->rxLength = 0;
+
+  if (length < FRAME_HEADER_LENGTH + FRAME_CRC_LENGTH) {
+    frame_p->errors++;
+    return false;
+  }
+
+  uint16_t crcOffset = length - FRAME_CRC_LENGTH;
+  uint8_t* crcBytes = &frame_p->rxBuffer[crcOffset];
+  uint32_t receivedCrc = (uint32_t)crcBytes[0] | ((uint32_t)crcBytes[1] << 8) |
+                         ((uint32_t)crcBytes[2] << 16) |
+                         ((uint32_t)crcBytes[3] << 24);
+
+  if (receivedCrc != Frame_crc32(frame_p->rxBuffer, crcOffset)) {
+    frame_p->errors++;
+    return false;
+  }
+
+  message_p->type = frame_p->rxBuffer[0];
+  message_p->seq = frame_p->rxBuffer[1];
+  message_p->length = crcOffset - FRAME_HEADER_LENGTH;
+  memcpy(message_p->payload, &frame_p->rxBuffer[FRAME_HEADER_LENGTH],
+         message_p->length);
+
+  return true;
+}
+
+/**
+ * Builds, COBS-encodes and sends a frame, surrounded by delimiters. Payloads
+ * longer than FRAME_MAX_PAYLOAD are truncated.
+ *
+ * @param uart_p:   The UART to send the frame on
+ * @param type:     The message type
+ * @param seq:      The sequence number
+ * @param payload:  The payload bytes
+ * @param length:   The number of payload bytes
+ */
+void Frame_send(UART* uart_p, uint8_t type, uint8_t seq,
+                const uint8_t* payload, uint16_t length) {
+  static uint8_t raw[FRAME_MAX_RAW];
+  static uint8_t encoded[FRAME_MAX_ENCODED];
+
+  if (length > FRAME_MAX_PAYLOAD) {
+    length = FRAME_MAX_PAYLOAD;
+  }
+
+  // Assemble the raw frame and append its CRC32
+  raw[0] = type;
+  raw[1] = seq;
+  memcpy(&raw[FRAME_HEADER_LENGTH], payload, length);
+  uint16_t rawLength = FRAME_HEADER_LENGTH + length;
+  uint32_t crc = Frame_crc32(raw, rawLength);
+  raw[rawLength++] = crc;
+  raw[rawLength++] = crc >> 8;
+  raw[rawLength++] = crc >> 16;
+  raw[rawLength++] = crc >> 24;
+
+  // COBS: every zero is replaced by the distance to the next zero
+  uint16_t codeIndex = 0;
+  uint16_t out = 1;
+  uint8_t code = 1;
+  uint16_t i;
+  for (i = 0; i < rawLength; i++) {
+    if (raw[i] == 0) {
+      encoded[codeIndex] = code;
+      codeIndex = out++;
+      code = 1;
+    } else {
+      encoded[out++] = raw[i];
+      code++;
+      if (code == 0xFF) {
+        encoded[codeIndex] = code;
+        codeIndex = out++;
+        code = 1;
+      }
+    }
+  }
+  encoded[codeIndex] = code;
+
+  UART_sendChar(uart_p, FRAME_DELIMITER);
+  for (i = 0; i < out; i++) {
+    UART_sendChar(uart_p, encoded[i]);
+  }
+  UART_sendChar(uart_p, FRAME_DELIMITER);
+}
@@ -0,0 +1,95 @@
+/*
+ * Frame.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef HAL_FRAME_H_
+#define HAL_FRAME_H_
+
+#include <HAL/UART.h>
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+// Largest payload a single frame can carry
+#define FRAME_MAX_PAYLOAD 240
+
+// A frame before encoding: type, sequence number, payload and CRC32
+#define FRAME_HEADER_LENGTH 2
+#define FRAME_CRC_LENGTH 4
+#define FRAME_MAX_RAW (FRAME_HEADER_LENGTH + FRAME_MAX_PAYLOAD + FRAME_CRC_LENGTH)
+
+// COBS adds one byte for every 254 bytes of data, plus the trailing delimiter
+#define FRAME_MAX_ENCODED (FRAME_MAX_RAW + 2)
+
+// The only byte value which never appears inside an encoded frame
+#define FRAME_DELIMITER 0x00
+
+// Seed of the CRC32 computation, matching the common (zlib) CRC-32
+#define FRAME_CRC_SEED 0xFFFFFFFF
+
+/**
+ * A decoded, CRC-checked frame.
+ */
+struct _FrameMessage {
+  uint8_t type;
+  uint8_t seq;
+  uint16_t length;
+  uint8_t payload[FRAME_MAX_PAYLOAD];
+};
+typedef struct _FrameMessage FrameMessage;
+
+/**=============================================================================
+ * Receiver state for COBS-framed binary messages on a UART. On the wire a
+ * frame is FRAME_DELIMITER, the COBS encoding of
+ *
+ *     type | seq | payload... | CRC32 (little endian)
+ *
+ * and a closing FRAME_DELIMITER. The CRC32 covers type, seq and payload and is
+ * computed with the MSP432 CRC32 module, giving the same value as the common
+ * (zlib) CRC-32. Human input never contains FRAME_DELIMITER, so the receiver
+ * only takes over the UART between the two delimiters and ASCII input keeps
+ * working outside of frames. Clients should send one more FRAME_DELIMITER in
+ * front of every frame: a sleeping board may lose the first character, which
+ * only wakes it up (see HAL_sleep()), and two delimiters in a row are the
+ * same as one.
+ * =============================================================================
+ * USAGE WARNINGS
+ * =============================================================================
+ * Treat all members as PRIVATE. Use [Frame_isReceiving()] to decide whether a
+ * received byte belongs to a frame before handing it to the ASCII logic.
+ */
+struct _Frame {
+  // Whether an opening delimiter has been seen and the frame is not complete
+  bool receiving;
+
+  // Whether the frame being received overflowed, so its remaining bytes are
+  // dropped until the closing delimiter
+  bool discarding;
+
+  // Encoded bytes of the frame received so far
+  uint8_t rxBuffer[FRAME_MAX_ENCODED];
+  uint16_t rxLength;
+
+  // Frames dropped because of a bad CRC, a bad encoding or an overflow
+  uint32_t errors;
+};
+typedef struct _Frame Frame;
+
+// Constructs a frame receiver which is waiting for a delimiter
+Frame Frame_construct();
+
+// Returns true if the next received byte belongs to a frame
+bool Frame_isReceiving(Frame* frame_p, uint8_t rxByte);
+
+// Feeds one received byte to the receiver. Returns true when the byte
+// completed a valid frame, which is then stored in message_p.
+bool Frame_receiveByte(Frame* frame_p, uint8_t rxByte, FrameMessage* message_p);
+
+// Encodes and sends a frame over the UART
+void Frame_send(UART* uart_p, uint8_t type, uint8_t seq,
+                const uint8_t* payload, uint16_t length);
+
+// Computes the CRC32 of a buffer with the hardware CRC32 module
+uint32_t Frame_crc32(const uint8_t* data, uint16_t length);
+
+#endif /* HAL_FRAME_H_ */
@@ -7,6 +7,9 @@
  */
 
 #include <HAL/HAL.h>
+#include <HAL/LcdDriver/HAL_MSP_EXP432P401R_Crystalfontz128x128_ST7735.h>
+
+static void HAL_bootDisplay(HAL* hal_p);
 
 /**
  * Constructs a new API object. The API constructor should simply call the
@@ -18,6 +21,23 @@ HAL HAL_construct() {
   // The API object which will be returned at the end of construction
   HAL hal;
 
+  // Mark the stack before it is used any deeper
+  Metrics_paintStack();
+
+  // Start the only timer which runs while the board sleeps in LPM3
+  Power_init();
+
+  // Reset the LCD first. Its power-up sequence takes far longer than the rest
+  // of construction, so the remaining steps run from HAL_refresh() while the
+  // program is already looping.
+  hal.bootTimer = SWTimer_construct(0);
+  SWTimer_start(&hal.bootTimer);
+  Crystalfontz128x128_Reset();
+  hal.displayBoot = DISPLAY_RESETTING;
+  hal.displayTimer = SWTimer_construct(LCD_RESET_TIME_MS);
+  SWTimer_start(&hal.displayTimer);
+  hal.bootTimeUS = 0;
+
   // Initialize all LEDs by calling their constructors with correctly-defined
   // arguments.
   hal.launchpadLED1 = LED_construct(LAUNCHPAD_LED1_PORT, LAUNCHPAD_LED1_PIN);
@@ -56,8 +76,19 @@ HAL HAL_construct() {
   // Enable the UART at 9600 BPS
   // TODO: Call UART_SetBaud_Enable to achieve the above goal
 
-  initializeGraphics(&hal.g_sContext);
+  // Collect received characters in the background so none are lost while
+  // the application is busy drawing
+  UART_enableRxBuffer(&hal.uart);
+
+  // The baudrate detector stays idle until the Application starts it
+  hal.autoBaud = AutoBaud_construct();
 
+  // The seat link pins double as LED and BoosterPack pins, so the seat links
+  // are only set up on request
+  hal.seatLinks = false;
+
+  // The board link shares its port with seat 4 and is also set up on request
+  hal.boardLink = false;
 
   // Once we have finished building the API, return the completed struct.
   return hal;
@@ -83,16 +114,297 @@ void HAL_refresh(HAL* hal) {
   Button_refresh(&hal->boosterpackJS);
 
   // Not real TODO: No need to add anything for UART
+
+  // Continue the LCD power-up sequence
+  if (hal->displayBoot != DISPLAY_ON) {
+    HAL_bootDisplay(hal);
+  }
+
+  // Resend the message to the other board if it was not acknowledged in time
+  if (hal->boardLink) {
+    Link_refresh(&hal->link);
+  }
+}
+
+/**
+ * Runs the next step of the LCD power-up sequence once the wait after the
+ * previous step is over. The display is cleared as soon as it can be drawn
+ * to, and only turned on once the application had the chance to draw its
+ * first screen, so that the first frame shown is a complete screen.
+ *
+ * @param hal_p:  The HAL whose LCD is powering up
+ */
+static void HAL_bootDisplay(HAL* hal_p) {
+  if (!SWTimer_expired(&hal_p->displayTimer)) {
+    return;
+  }
+
+  switch (hal_p->displayBoot) {
+    case DISPLAY_RESETTING:
+      Crystalfontz128x128_SleepOut();
+      hal_p->displayTimer = SWTimer_construct(LCD_SLEEP_OUT_TIME_MS);
+      hal_p->displayBoot = DISPLAY_WAKING;
+      break;
+
+    case DISPLAY_WAKING:
+      Crystalfontz128x128_Configure();
+      initializeGraphics(&hal_p->g_sContext);
+      hal_p->displayTimer = SWTimer_construct(LCD_DISPLAY_ON_TIME_MS -
+                                              LCD_SLEEP_OUT_TIME_MS);
+      hal_p->displayBoot = DISPLAY_DRAWABLE;
+      break;
+
+    case DISPLAY_DRAWABLE:
+      Crystalfontz128x128_DisplayOn();
+      hal_p->bootTimeUS = SWTimer_elapsedTimeUS(&hal_p->bootTimer);
+      hal_p->displayBoot = DISPLAY_ON;
+      return;
+
+    case DISPLAY_ON:
+      return;
+  }
+
+  SWTimer_start(&hal_p->displayTimer);
+}
+
+/**
+ * Returns whether the LCD can be drawn to. Until then the graphics context is
+ * not set up, and nothing may be drawn.
+ *
+ * @param hal_p:  The HAL holding the LCD
+ *
+ * @return true once the LCD is cleared and drawable
+ */
+bool HAL_canDraw(HAL* hal_p) {
+  return hal_p->displayBoot >= DISPLAY_DRAWABLE;
+}
+
+/**
+ * Constructs the UARTs of the dedicated seat links, one eUSCI_A module per
+ * seat, and enables them with interrupt-driven reception so that all seats
+ * can type at the same time. Calling this again only updates the baudrate.
+ *
+ * @param hal_p:        The HAL whose seat links to enable
+ * @param baudChoice:   The baudrate of the seat links
+ */
+void HAL_enableSeatLinks(HAL* hal_p, UART_Baudrate baudChoice) {
+  int i;
+
+  if (!hal_p->seatLinks) {
+    hal_p->seatUarts[0] = UART_construct(SEAT2_UART_INSTANCE, SEAT2_UART_PORT,
+                                         SEAT2_UART_PINS);
+    hal_p->seatUarts[1] = UART_construct(SEAT3_UART_INSTANCE, SEAT3_UART_PORT,
+                                         SEAT3_UART_PINS);
+    hal_p->seatUarts[2] = UART_construct(SEAT4_UART_INSTANCE, SEAT4_UART_PORT,
+                                         SEAT4_UART_PINS);
+
+    for (i = 0; i < NUM_SEAT_UARTS; i++) {
+      UART_enableRxBuffer(&hal_p->seatUarts[i]);
+    }
+    hal_p->seatLinks = true;
+  }
+
+  for (i = 0; i < NUM_SEAT_UARTS; i++) {
+    UART_SetBaud_Enable(&hal_p->seatUarts[i], baudChoice);
+  }
+}
+
+/**
+ * Constructs the UART of the link to a second board and the message link on
+ * top of it. Both boards must use the same baudrate. Calling this again only
+ * updates the baudrate.
+ *
+ * @param hal_p:        The HAL whose board link to enable. The link keeps a
+ *                      pointer to its UART, so this must be the final HAL
+ *                      object rather than a copy.
+ * @param baudChoice:   The baudrate of the link
+ */
+void HAL_enableBoardLink(HAL* hal_p, UART_Baudrate baudChoice) {
+  if (!hal_p->boardLink) {
+    hal_p->linkUart = UART_construct(LINK_UART_INSTANCE, LINK_UART_PORT,
+                                     LINK_UART_PINS);
+    UART_enableRxBuffer(&hal_p->linkUart);
+  }
+
+  UART_SetBaud_Enable(&hal_p->linkUart, baudChoice);
+
+  // The link starts its first session over the enabled UART
+  if (!hal_p->boardLink) {
+    hal_p->link = Link_construct(&hal_p->linkUart);
+    hal_p->boardLink = true;
+  }
+}
+
+/**
+ * Returns the UART on which a seat enters its moves. Seat 0 always uses the
+ * USB UART; the other seats use their dedicated links once those are enabled.
+ *
+ * @param hal_p:  The HAL holding the UARTs
+ * @param seat:   The seat number, starting at 0
+ *
+ * @return the seat's UART
+ */
+UART* HAL_seatUart(HAL* hal_p, int seat) {
+  if (seat == 0 || !hal_p->seatLinks) {
+    return &hal_p->uart;
+  }
+  return &hal_p->seatUarts[seat - 1];
+}
+
+/**
+ * Switches the system clock, and re-derives the settings of every peripheral
+ * clocked from SMCLK: the baudrates of all enabled UARTs and the SPI clock of
+ * the LCD. The software timers are rebased by the clock switch itself. The
+ * switch is refused when an enabled UART's baudrate cannot be generated at
+ * the new clock, or while the LCD is still powering up.
+ *
+ * @param hal_p:  The HAL whose clock to switch
+ * @param speed:  The new clock speed
+ *
+ * @return true if the system now runs at the given speed
+ */
+bool HAL_setClockSpeed(HAL* hal_p, ClockSpeed speed) {
+  UART* uarts[1 + NUM_SEAT_UARTS + 1];
+  int count = 0;
+  int i;
+
+  if (speed == Clock_speed()) {
+    return true;
+  }
+  if (hal_p->displayBoot != DISPLAY_ON) {
+    return false;
+  }
+
+  uarts[count++] = &hal_p->uart;
+  if (hal_p->seatLinks) {
+    for (i = 0; i < NUM_SEAT_UARTS; i++) {
+      uarts[count++] = &hal_p->seatUarts[i];
+    }
+  }
+  if (hal_p->boardLink) {
+    uarts[count++] = &hal_p->linkUart;
+  }
+
+  uint32_t clockHz = Clock_speedHz(speed);
+  for (i = 0; i < count; i++) {
+    if (!UART_supportsClock(uarts[i], clockHz)) {
+      return false;
+    }
+  }
+
+  // Characters in flight would be cut by the reconfiguration
+  for (i = 0; i < count; i++) {
+    UART_waitIdle(uarts[i]);
+  }
+
+  Power_account();
+  Clock_setSpeed(speed);
+
+  for (i = 0; i < count; i++) {
+    UART_setClock(uarts[i], clockHz);
+  }
+  Crystalfontz128x128_SetSystemClock(clockHz);
+
+  return true;
+}
+
+/**
+ * Gives the USB UART's RX pin back to the UART after an LPM3 sleep. This runs
+ * first thing on the wake-up: the UART must hear the start bit of the character
+ * after the one which woke the board, one character time later.
+ */
+static void HAL_endRxWake(void) {
+  GPIO_disableInterrupt(USB_UART_PORT, USB_UART_RX_PIN);
+  GPIO_setAsPeripheralModuleFunctionInputPin(USB_UART_PORT, USB_UART_RX_PIN,
+                                             GPIO_PRIMARY_MODULE_FUNCTION);
+}
+
+/**
+ * Puts the board to sleep until a button is pressed, a character arrives or
+ * sleep_ms have passed. Nothing is done when input has already arrived.
+ *
+ * In LPM0 the UARTs keep receiving, and their receive interrupts end the
+ * sleep. In LPM3 SMCLK is off, so the UARTs cannot receive; instead the USB
+ * UART's RX pin wakes the board on the start bit of a character. That
+ * character is lost, so LPM3 is only for screens which ignore characters.
+ * Binary frames are sent with an extra leading delimiter, which is the
+ * character spent on waking the board (see HAL/Frame.h).
+ *
+ * @param hal_p:      The HAL to put to sleep
+ * @param mode:       POWER_LPM0 or POWER_LPM3
+ * @param sleep_ms:   The longest time to sleep, at most POWER_MAX_SLEEP_MS
+ *
+ * @return true if the board slept
+ */
+bool HAL_sleep(HAL* hal_p, PowerMode mode, uint32_t sleep_ms) {
+  Button* buttons[] = {&hal_p->launchpadS1, &hal_p->launchpadS2,
+                       &hal_p->boosterpackS1, &hal_p->boosterpackS2,
+                       &hal_p->boosterpackJS};
+  int numButtons = sizeof(buttons) / sizeof(buttons[0]);
+  bool rxWake = mode == POWER_LPM3 && !AutoBaud_isRunning(&hal_p->autoBaud);
+  bool pending = false;
+  int i;
+
+  // The UARTs must have sent their last character before SMCLK stops
+  if (mode == POWER_LPM3) {
+    UART_waitIdle(&hal_p->uart);
+  }
+
+  // From here on an interrupt can only end the sleep, not slip in before it
+  Interrupt_disableMaster();
+
+  pending = UART_hasChar(&hal_p->uart);
+  if (hal_p->seatLinks) {
+    for (i = 0; i < NUM_SEAT_UARTS; i++) {
+      pending = pending || UART_hasChar(&hal_p->seatUarts[i]);
+    }
+  }
+  if (hal_p->boardLink) {
+    pending = pending || UART_hasChar(&hal_p->linkUart);
+  }
+  for (i = 0; i < numButtons; i++) {
+    pending = pending || !Button_isIdle(buttons[i]);
+  }
+
+  if (pending) {
+    Interrupt_enableMaster();
+    return false;
+  }
+
+  for (i = 0; i < numButtons; i++) {
+    Button_enableWake(buttons[i]);
+  }
+  if (rxWake) {
+    GPIO_setAsInputPinWithPullUpResistor(USB_UART_PORT, USB_UART_RX_PIN);
+    GPIO_interruptEdgeSelect(USB_UART_PORT, USB_UART_RX_PIN,
+                             GPIO_HIGH_TO_LOW_TRANSITION);
+    GPIO_clearInterruptFlag(USB_UART_PORT, USB_UART_RX_PIN);
+    GPIO_enableInterrupt(USB_UART_PORT, USB_UART_RX_PIN);
+    Interrupt_enableInterrupt(INT_PORT1);
+  }
+
+  Power_sleep(mode, sleep_ms, rxWake ? HAL_endRxWake : NULL);
+
+  for (i = 0; i < numButtons; i++) {
+    Button_disableWake(buttons[i]);
+  }
+
+  return true;
 }
 
 void initializeGraphics(Graphics_Context *g_sContext_p) {
-  // Initialize the LCD
-  Crystalfontz128x128_Init();
+  // The LCD was configured by HAL_bootDisplay()
   Crystalfontz128x128_SetOrientation(LCD_ORIENTATION_UP);
 
-  // Initialize context
+  // Initialize context. With the framebuffer, drawing only reaches the LCD
+  // when the buffer is flushed.
+#if LCD_FRAMEBUFFER
+  Graphics_initContext(g_sContext_p, &g_sCrystalfontz128x128,
+                       &g_sCrystalfontz128x128_fbFuncs);
+#else
   Graphics_initContext(g_sContext_p, &g_sCrystalfontz128x128,
                        &g_sCrystalfontz128x128_funcs);
+#endif
 
   // Set colors and fonts
   Graphics_setForegroundColor(g_sContext_p, GRAPHICS_COLOR_WHITE);
@@ -101,5 +413,6 @@ void initializeGraphics(Graphics_Context *g_sContext_p) {
 
   // Clear the screen
   Graphics_clearDisplay(g_sContext_p);
+  Graphics_flushBuffer(g_sContext_p);
 }
 
@@ -9,8 +9,13 @@
 #ifndef HAL_HAL_H_
 #define HAL_HAL_H_
 
+#include <HAL/AutoBaud.h>
 #include <HAL/Button.h>
+#include <HAL/Clock.h>
 #include <HAL/LED.h>
+#include <HAL/Link.h>
+#include <HAL/Metrics.h>
+#include <HAL/Power.h>
 #include <HAL/Timer.h>
 #include <HAL/UART.h>
 #include <ti/devices/msp432p4xx/driverlib/driverlib.h>
@@ -33,6 +38,14 @@
  */
 
 
+// Steps of the LCD power-up sequence, see HAL_construct()
+typedef enum {
+  DISPLAY_RESETTING,  // Waiting for the controller to come out of reset
+  DISPLAY_WAKING,     // Waiting for the controller to leave sleep mode
+  DISPLAY_DRAWABLE,   // Cleared and drawable, waiting to turn the display on
+  DISPLAY_ON          // Showing the frame memory
+} DisplayBoot;
+
 struct _HAL {
   // LEDs - Left Launchpad LED (the LED is only a single color - red)
   LED launchpadLED1;
@@ -59,8 +72,31 @@ struct _HAL {
   // UART - Construct a new UART instance
   UART uart;
 
+  // Baudrate detector for the UART above
+  AutoBaud autoBaud;
+
+  // UARTs of the dedicated seat links for seats 2 to 4, only constructed
+  // once HAL_enableSeatLinks() is called
+  UART seatUarts[NUM_SEAT_UARTS];
+  bool seatLinks;
+
+  // UART and message link to a second board, only constructed once
+  // HAL_enableBoardLink() is called
+  UART linkUart;
+  Link link;
+  bool boardLink;
+
   Graphics_Context g_sContext;
 
+  // Progress of the LCD power-up sequence, which runs alongside the rest of
+  // the program, and the wait before its next step
+  DisplayBoot displayBoot;
+  SWTimer displayTimer;
+
+  // Runs from construction until the display is turned on
+  SWTimer bootTimer;
+  uint64_t bootTimeUS;
+
 };
 typedef struct _HAL HAL;
 
@@ -73,6 +109,26 @@ HAL HAL_construct();
 // Refreshes all necessary inputs in the HAL
 void HAL_refresh(HAL* api);
 
+// Constructs and enables the dedicated seat links at the given baudrate
+void HAL_enableSeatLinks(HAL* hal_p, UART_Baudrate baudChoice);
+
+// Constructs and enables the link to a second board at the given baudrate
+void HAL_enableBoardLink(HAL* hal_p, UART_Baudrate baudChoice);
+
+// Returns true once the LCD can be drawn to
+bool HAL_canDraw(HAL* hal_p);
+
+// Switches the system clock and reconfigures the UARTs and the LCD for it.
+// Returns false if the switch is not possible right now.
+bool HAL_setClockSpeed(HAL* hal_p, ClockSpeed speed);
+
+// Sleeps in LPM0 or LPM3 until input arrives or for at most sleep_ms. Returns
+// false without sleeping if input is already waiting.
+bool HAL_sleep(HAL* hal_p, PowerMode mode, uint32_t sleep_ms);
+
+// Returns the UART a seat (0 to NUM_SEAT_UARTS) enters its moves on
+UART* HAL_seatUart(HAL* hal_p, int seat);
+
 void initializeGraphics(Graphics_Context *g_sContext_p);
 
 
@@ -0,0 +1,77 @@
+/*
+ * Icons.c
+ *
+ * Generated by tools/encode_sprite.py from tools/sprites/. Do not edit.
+ */
+
+#include <HAL/Icons.h>
+
+static const SpriteRun rockRuns[] = {
+    {38, 0x0000}, {4, 0x528A}, {10, 0x0000}, {2, 0x528A},
+    {4, 0x9492}, {2, 0x528A}, {7, 0x0000}, {1, 0x528A},
+    {3, 0x9492}, {2, 0xC618}, {3, 0x9492}, {1, 0x528A},
+    {5, 0x0000}, {1, 0x528A}, {3, 0x9492}, {3, 0xC618},
+    {3, 0x9492}, {1, 0x528A}, {5, 0x0000}, {1, 0x528A},
+    {3, 0x9492}, {2, 0xC618}, {5, 0x9492}, {1, 0x528A},
+    {3, 0x0000}, {1, 0x528A}, {12, 0x9492}, {1, 0x528A},
+    {2, 0x0000}, {1, 0x528A}, {7, 0x9492}, {1, 0x528A},
+    {4, 0x9492}, {1, 0x528A}, {2, 0x0000}, {1, 0x528A},
+    {6, 0x9492}, {1, 0x528A}, {6, 0x9492}, {1, 0x528A},
+    {1, 0x0000}, {1, 0x528A}, {13, 0x9492}, {1, 0x528A},
+    {2, 0x0000}, {1, 0x528A}, {10, 0x9492}, {1, 0x528A},
+    {5, 0x0000}, {2, 0x528A}, {6, 0x9492}, {2, 0x528A},
+    {8, 0x0000}, {6, 0x528A}, {37, 0x0000},
+};
+
+const Sprite rockIcon = {16, 16, rockRuns,
+                         sizeof(rockRuns) / sizeof(rockRuns[0])};
+
+static const SpriteRun paperRuns[] = {
+    {18, 0x0000}, {10, 0xFFFF}, {6, 0x0000}, {11, 0xFFFF},
+    {5, 0x0000}, {1, 0xFFFF}, {6, 0x9492}, {5, 0xFFFF},
+    {4, 0x0000}, {12, 0xFFFF}, {4, 0x0000}, {1, 0xFFFF},
+    {9, 0x9492}, {2, 0xFFFF}, {4, 0x0000}, {12, 0xFFFF},
+    {4, 0x0000}, {1, 0xFFFF}, {10, 0x9492}, {1, 0xFFFF},
+    {4, 0x0000}, {12, 0xFFFF}, {4, 0x0000}, {1, 0xFFFF},
+    {9, 0x9492}, {2, 0xFFFF}, {4, 0x0000}, {12, 0xFFFF},
+    {4, 0x0000}, {1, 0xFFFF}, {10, 0x9492}, {1, 0xFFFF},
+    {4, 0x0000}, {12, 0xFFFF}, {4, 0x0000}, {1, 0xFFFF},
+    {6, 0x9492}, {5, 0xFFFF}, {4, 0x0000}, {12, 0xFFFF},
+    {18, 0x0000},
+};
+
+const Sprite paperIcon = {16, 16, paperRuns,
+                          sizeof(paperRuns) / sizeof(paperRuns[0])};
+
+static const SpriteRun scissorsRuns[] = {
+    {17, 0x0000}, {1, 0xC618}, {11, 0x0000}, {1, 0xC618},
+    {4, 0x0000}, {1, 0xC618}, {9, 0x0000}, {1, 0xC618},
+    {6, 0x0000}, {1, 0xC618}, {7, 0x0000}, {1, 0xC618},
+    {8, 0x0000}, {1, 0xC618}, {5, 0x0000}, {1, 0xC618},
+    {10, 0x0000}, {1, 0xC618}, {3, 0x0000}, {1, 0xC618},
+    {12, 0x0000}, {1, 0xC618}, {1, 0x0000}, {1, 0xC618},
+    {14, 0x0000}, {1, 0xC618}, {14, 0x0000}, {1, 0xC618},
+    {1, 0x0000}, {1, 0xC618}, {12, 0x0000}, {1, 0xC618},
+    {3, 0x0000}, {1, 0xC618}, {9, 0x0000}, {3, 0xF800},
+    {3, 0x0000}, {3, 0xF800}, {6, 0x0000}, {1, 0xF800},
+    {3, 0x0000}, {1, 0xF800}, {1, 0x0000}, {1, 0xF800},
+    {3, 0x0000}, {1, 0xF800}, {5, 0x0000}, {1, 0xF800},
+    {3, 0x0000}, {1, 0xF800}, {1, 0x0000}, {1, 0xF800},
+    {3, 0x0000}, {1, 0xF800}, {5, 0x0000}, {1, 0xF800},
+    {3, 0x0000}, {1, 0xF800}, {1, 0x0000}, {1, 0xF800},
+    {3, 0x0000}, {1, 0xF800}, {6, 0x0000}, {3, 0xF800},
+    {3, 0x0000}, {3, 0xF800}, {20, 0x0000},
+};
+
+const Sprite scissorsIcon = {16, 16, scissorsRuns,
+                             sizeof(scissorsRuns) / sizeof(scissorsRuns[0])};
+
+static const SpriteRun winnerRuns[] = {
+    {8, 0x0000}, {1, 0xFEA0}, {2, 0x0000}, {2, 0xFEA0},
+    {2, 0x0000}, {3, 0xFEA0}, {1, 0x0000}, {2, 0xFEA0},
+    {1, 0x0000}, {18, 0xFEA0}, {1, 0x0000}, {6, 0xFEA0},
+    {2, 0x0000}, {6, 0xFEA0}, {9, 0x0000},
+};
+
+const Sprite winnerIcon = {8, 8, winnerRuns,
+                           sizeof(winnerRuns) / sizeof(winnerRuns[0])};
@@ -0,0 +1,24 @@
+/*
+ * Icons.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef HAL_ICONS_H_
+#define HAL_ICONS_H_
+
+#include <HAL/Sprite.h>
+
+// Size of the rock, paper and scissors icons
+#define ICON_SIZE 16
+
+// Size of the winner icon
+#define WINNER_ICON_SIZE 8
+
+// Icons generated into HAL/Icons.c, see tools/encode_sprite.py
+extern const Sprite rockIcon;
+extern const Sprite paperIcon;
+extern const Sprite scissorsIcon;
+extern const Sprite winnerIcon;
+
+#endif /* HAL_ICONS_H_ */
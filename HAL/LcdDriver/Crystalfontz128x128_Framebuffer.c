@@ -0,0 +1,356 @@
+//*****************************************************************************
+//
+// Crystalfontz128x128_Framebuffer.c - Offscreen framebuffer display functions
+//                                     for the Crystalfontz128x128 display
+//                                     with ST7735 controller.
+//
+// grlib draws into an 8bpp framebuffer in SRAM instead of onto the panel.
+// Every pixel holds an index into a palette of up to 256 RGB565 colors, which
+// fills up with the colors the program actually uses. Rows which were drawn
+// into are marked dirty, and Graphics_flushBuffer() sends only those rows to
+// the panel, expanding them to RGB565 one row at a time while DMA feeds the
+// previous row to the SPI transmit buffer. A screen drawn between two flushes
+// therefore appears at once, without the panel showing it half drawn.
+//
+//*****************************************************************************
+
+#include <HAL/LcdDriver/Crystalfontz128x128_ST7735.h>
+#include <HAL/LcdDriver/HAL_MSP_EXP432P401R_Crystalfontz128x128_ST7735.h>
+#include <HAL/Metrics.h>
+#include <HAL/RamFunc.h>
+#include <HAL/Trace.h>
+#include <stdint.h>
+#include <string.h>
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+#include <ti/grlib/grlib.h>
+
+#if LCD_FRAMEBUFFER
+
+// Number of 32-bit words of the dirty row mask
+#define LCD_DIRTY_WORDS (LCD_VERTICAL_MAX / 32)
+
+// One palette index per pixel
+static uint8_t Lcd_Framebuffer[LCD_VERTICAL_MAX][LCD_HORIZONTAL_MAX];
+
+// RGB565 color of each palette index in use. Index 0 is black, which is what
+// the zeroed framebuffer starts out as.
+static uint16_t Lcd_Palette[256] = {0x0000};
+static uint16_t Lcd_PaletteSize = 1;
+
+// One bit per row which changed since the last flush
+static uint32_t Lcd_DirtyRows[LCD_DIRTY_WORDS];
+
+// Block and position of the pixels written by WritePixels()
+static uint16_t Lcd_BlockX0, Lcd_BlockX1, Lcd_BlockY1;
+static uint16_t Lcd_CursorX, Lcd_CursorY;
+
+// Two rows of RGB565 bytes: one is expanded while DMA sends the other
+static uint8_t Lcd_RowBuffers[2][LCD_HORIZONTAL_MAX * 2];
+
+// The DMA control table, which the DMA module requires to be aligned to
+// its size
+#if defined(__TI_COMPILER_VERSION__)
+#pragma DATA_ALIGN(Lcd_DmaControlTable, 1024)
+static DMA_ControlTable Lcd_DmaControlTable[16];
+#elif defined(__IAR_SYSTEMS_ICC__)
+#pragma data_alignment = 1024
+static DMA_ControlTable Lcd_DmaControlTable[16];
+#elif defined(__GNUC__)
+static DMA_ControlTable Lcd_DmaControlTable[16]
+    __attribute__((aligned(1024)));
+#elif defined(__CC_ARM)
+static __align(1024) DMA_ControlTable Lcd_DmaControlTable[16];
+#endif
+
+static bool Lcd_DmaReady = false;
+
+//*****************************************************************************
+//
+// Marks the rows from y0 to y1 as changed.
+//
+//*****************************************************************************
+static void Crystalfontz128x128_MarkDirty(int16_t y0, int16_t y1) {
+  int16_t y;
+
+  for (y = y0; y <= y1; y++) {
+    Lcd_DirtyRows[y >> 5] |= (uint32_t)1 << (y & 31);
+  }
+}
+
+//*****************************************************************************
+//
+// Returns the palette index of an RGB565 color. A color which is not in the
+// palette yet is added; once the palette is full, the closest color is used.
+//
+//*****************************************************************************
+static uint8_t Crystalfontz128x128_PaletteIndex(uint16_t color) {
+  uint32_t bestDistance = UINT32_MAX;
+  uint16_t best = 0;
+  uint16_t i;
+
+  for (i = 0; i < Lcd_PaletteSize; i++) {
+    if (Lcd_Palette[i] == color) {
+      return i;
+    }
+  }
+
+  if (Lcd_PaletteSize < 256) {
+    Lcd_Palette[Lcd_PaletteSize] = color;
+    return Lcd_PaletteSize++;
+  }
+
+  for (i = 0; i < Lcd_PaletteSize; i++) {
+    int32_t red = (int32_t)(color >> 11) - (Lcd_Palette[i] >> 11);
+    int32_t green =
+        (int32_t)((color >> 5) & 0x3F) - ((Lcd_Palette[i] >> 5) & 0x3F);
+    int32_t blue = (int32_t)(color & 0x1F) - (Lcd_Palette[i] & 0x1F);
+    uint32_t distance = red * red + green * green + blue * blue;
+
+    if (distance < bestDistance) {
+      bestDistance = distance;
+      best = i;
+    }
+  }
+  return best;
+}
+
+//*****************************************************************************
+//
+// Sets up the DMA channel which feeds the SPI transmit buffer, one byte per
+// transmit request.
+//
+//*****************************************************************************
+static void Crystalfontz128x128_DmaInit(void) {
+  DMA_enableModule();
+  DMA_setControlBase(Lcd_DmaControlTable);
+  DMA_assignChannel(LCD_DMA_CHANNEL);
+  DMA_disableChannelAttribute(LCD_DMA_CHANNEL,
+                              UDMA_ATTR_ALTSELECT | UDMA_ATTR_USEBURST |
+                                  UDMA_ATTR_HIGH_PRIORITY | UDMA_ATTR_REQMASK);
+  DMA_setChannelControl(UDMA_PRI_SELECT | LCD_DMA_CHANNEL,
+                        UDMA_SIZE_8 | UDMA_SRC_INC_8 | UDMA_DST_INC_NONE |
+                            UDMA_ARB_1);
+  Lcd_DmaReady = true;
+}
+
+//*****************************************************************************
+//
+// Sends the rows from y0 to y1 to the panel in a single RAMWR.
+//
+//*****************************************************************************
+RAMFUNC static void Crystalfontz128x128_SendRows(uint16_t y0, uint16_t y1) {
+  uint16_t x, y;
+
+  Crystalfontz128x128_SetDrawFrame(0, y0, LCD_HORIZONTAL_MAX - 1, y1);
+  HAL_LCD_writeCommand(CM_RAMWR);
+
+  for (y = y0; y <= y1; y++) {
+    uint8_t *row_p = Lcd_RowBuffers[y & 1];
+
+    // Expand this row while the previous one is still being sent
+    for (x = 0; x < LCD_HORIZONTAL_MAX; x++) {
+      uint16_t color = Lcd_Palette[Lcd_Framebuffer[y][x]];
+      row_p[2 * x] = color >> 8;
+      row_p[2 * x + 1] = color;
+    }
+
+    while (DMA_isChannelEnabled(LCD_DMA_CHANNEL_NUMBER))
+      ;
+    DMA_setChannelTransfer(
+        UDMA_PRI_SELECT | LCD_DMA_CHANNEL, UDMA_MODE_BASIC, row_p,
+        (void *)SPI_getTransmitBufferAddressForDMA(LCD_EUSCI_BASE),
+        sizeof(Lcd_RowBuffers[0]));
+    DMA_enableChannel(LCD_DMA_CHANNEL_NUMBER);
+    METRIC_ADD(METRIC_SPI_BYTES, sizeof(Lcd_RowBuffers[0]));
+  }
+
+  // The last byte must be out before the next command lowers DC
+  while (DMA_isChannelEnabled(LCD_DMA_CHANNEL_NUMBER))
+    ;
+  while (UCB0STATW & UCBUSY)
+    ;
+}
+
+//*****************************************************************************
+//
+// Sends every dirty row to the panel, with consecutive dirty rows sharing one
+// window and one RAMWR.
+//
+//*****************************************************************************
+static void Crystalfontz128x128_FbFlush(const Graphics_Display *pDisplay) {
+  int16_t y = 0;
+
+  TRACE_ENTER(TRACE_LCD_FLUSH);
+
+  if (!Lcd_DmaReady) {
+    Crystalfontz128x128_DmaInit();
+  }
+
+  while (y < LCD_VERTICAL_MAX) {
+    int16_t first;
+
+    if (!(Lcd_DirtyRows[y >> 5] & ((uint32_t)1 << (y & 31)))) {
+      y++;
+      continue;
+    }
+
+    first = y;
+    while (y < LCD_VERTICAL_MAX &&
+           (Lcd_DirtyRows[y >> 5] & ((uint32_t)1 << (y & 31)))) {
+      y++;
+    }
+    Crystalfontz128x128_SendRows(first, y - 1);
+  }
+
+  memset(Lcd_DirtyRows, 0, sizeof(Lcd_DirtyRows));
+
+  TRACE_EXIT(TRACE_LCD_FLUSH);
+}
+
+static void Crystalfontz128x128_FbPixelDraw(const Graphics_Display *pDisplay,
+                                            int16_t lX, int16_t lY,
+                                            uint16_t ulValue) {
+  Lcd_Framebuffer[lY][lX] = ulValue;
+  Crystalfontz128x128_MarkDirty(lY, lY);
+}
+
+//*****************************************************************************
+//
+// Draws a horizontal sequence of pixels. For 1bpp data the palette holds
+// translated colors, which are palette indices here; for 4 and 8bpp data it
+// holds 24-bit colors, and 16bpp data is RGB565.
+//
+//*****************************************************************************
+static void Crystalfontz128x128_FbPixelDrawMultiple(
+    const Graphics_Display *pDisplay, int16_t lX, int16_t lY, int16_t lX0,
+    int16_t lCount, int16_t lBPP, const uint8_t *pucData,
+    const uint32_t *pucPalette) {
+  uint8_t *pixel_p = &Lcd_Framebuffer[lY][lX];
+  uint16_t Data;
+
+  Crystalfontz128x128_MarkDirty(lY, lY);
+
+  switch (lBPP) {
+    case 1:
+      while (lCount > 0) {
+        Data = *pucData++;
+        for (; (lX0 < 8) && lCount; lX0++, lCount--) {
+          *pixel_p++ = pucPalette[(Data >> (7 - lX0)) & 1];
+        }
+        lX0 = 0;
+      }
+      break;
+
+    case 4:
+      while (lCount--) {
+        Data = (lX0 & 1) ? (*pucData++ & 15) : (*pucData >> 4);
+        *pixel_p++ = Crystalfontz128x128_PaletteIndex(
+            g_sCrystalfontz128x128_fbFuncs.pfnColorTranslate(
+                pDisplay, pucPalette[Data]));
+        lX0++;
+      }
+      break;
+
+    case 8:
+      while (lCount--) {
+        *pixel_p++ = g_sCrystalfontz128x128_fbFuncs.pfnColorTranslate(
+            pDisplay, pucPalette[*pucData++]);
+      }
+      break;
+
+    case 16:
+      while (lCount--) {
+        *pixel_p++ = Crystalfontz128x128_PaletteIndex(*(uint16_t *)pucData);
+        pucData += 2;
+      }
+      break;
+  }
+}
+
+static void Crystalfontz128x128_FbLineDrawH(const Graphics_Display *pDisplay,
+                                            int16_t lX1, int16_t lX2,
+                                            int16_t lY, uint16_t ulValue) {
+  memset(&Lcd_Framebuffer[lY][lX1], ulValue, lX2 - lX1 + 1);
+  Crystalfontz128x128_MarkDirty(lY, lY);
+}
+
+static void Crystalfontz128x128_FbLineDrawV(const Graphics_Display *pDisplay,
+                                            int16_t lX, int16_t lY1,
+                                            int16_t lY2, uint16_t ulValue) {
+  int16_t y;
+
+  for (y = lY1; y <= lY2; y++) {
+    Lcd_Framebuffer[y][lX] = ulValue;
+  }
+  Crystalfontz128x128_MarkDirty(lY1, lY2);
+}
+
+static void Crystalfontz128x128_FbRectFill(const Graphics_Display *pDisplay,
+                                           const Graphics_Rectangle *pRect,
+                                           uint16_t ulValue) {
+  int16_t y;
+
+  for (y = pRect->sYMin; y <= pRect->sYMax; y++) {
+    memset(&Lcd_Framebuffer[y][pRect->sXMin], ulValue,
+           pRect->sXMax - pRect->sXMin + 1);
+  }
+  Crystalfontz128x128_MarkDirty(pRect->sYMin, pRect->sYMax);
+}
+
+//*****************************************************************************
+//
+// Translates a 24-bit RGB color to the palette index of its RGB565 value.
+//
+//*****************************************************************************
+static uint32_t Crystalfontz128x128_FbColorTranslate(
+    const Graphics_Display *pDisplay, uint32_t ulValue) {
+  return Crystalfontz128x128_PaletteIndex(
+      ((ulValue & 0x00f80000) >> 8) | ((ulValue & 0x0000fc00) >> 5) |
+      ((ulValue & 0x000000f8) >> 3));
+}
+
+static void Crystalfontz128x128_FbClearScreen(const Graphics_Display *pDisplay,
+                                              uint16_t ulValue) {
+  memset(Lcd_Framebuffer, ulValue, sizeof(Lcd_Framebuffer));
+  Crystalfontz128x128_MarkDirty(0, LCD_VERTICAL_MAX - 1);
+}
+
+//*****************************************************************************
+//
+// Starts writing a block of pixels into the framebuffer, see the direct
+// version in Crystalfontz128x128_ST7735.c.
+//
+//*****************************************************************************
+void Crystalfontz128x128_BeginPixels(uint16_t x0, uint16_t y0, uint16_t x1,
+                                     uint16_t y1) {
+  Lcd_BlockX0 = x0;
+  Lcd_BlockX1 = x1;
+  Lcd_BlockY1 = y1;
+  Lcd_CursorX = x0;
+  Lcd_CursorY = y0;
+  Crystalfontz128x128_MarkDirty(y0, y1);
+}
+
+void Crystalfontz128x128_WritePixels(uint16_t color, uint16_t count) {
+  uint8_t index = Crystalfontz128x128_PaletteIndex(color);
+
+  while (count-- && Lcd_CursorY <= Lcd_BlockY1) {
+    Lcd_Framebuffer[Lcd_CursorY][Lcd_CursorX] = index;
+    if (Lcd_CursorX++ == Lcd_BlockX1) {
+      Lcd_CursorX = Lcd_BlockX0;
+      Lcd_CursorY++;
+    }
+  }
+}
+
+const Graphics_Display_Functions g_sCrystalfontz128x128_fbFuncs = {
+    Crystalfontz128x128_FbPixelDraw,
+    Crystalfontz128x128_FbPixelDrawMultiple,
+    Crystalfontz128x128_FbLineDrawH,
+    Crystalfontz128x128_FbLineDrawV,
+    Crystalfontz128x128_FbRectFill,
+    Crystalfontz128x128_FbColorTranslate,
+    Crystalfontz128x128_FbFlush,
+    Crystalfontz128x128_FbClearScreen};
+
+#endif
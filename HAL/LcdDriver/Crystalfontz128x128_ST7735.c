@@ -38,6 +38,8 @@
 
 #include <HAL/LcdDriver/Crystalfontz128x128_ST7735.h>
 #include <HAL/LcdDriver/HAL_MSP_EXP432P401R_Crystalfontz128x128_ST7735.h>
+#include <HAL/RamFunc.h>
+#include <HAL/Trace.h>
 #include <stdint.h>
 #include <ti/devices/msp432p4xx/driverlib/driverlib.h>
 #include <ti/grlib/grlib.h>
@@ -47,28 +49,104 @@ uint16_t Lcd_ScreenWidth, Lcd_ScreenHeigth;
 uint8_t Lcd_PenSolid, Lcd_FontSolid, Lcd_FlagRead;
 uint16_t Lcd_TouchTrim;
 
+// Screen rows of the hardware scroll area
+static uint16_t Lcd_ScrollTop, Lcd_ScrollHeight;
+
+// Whether the panel is in partial and idle mode with the SPI module stopped
+static bool Lcd_LowPower = false;
+
+// Bytes of a window update: CASET and RASET with four parameters each, and
+// RAMWR
+#define LCD_CASET_BYTES 5
+#define LCD_RASET_BYTES 5
+#define LCD_RAMWR_BYTES 1
+
+// The controller's column and row window, as last sent
+static bool Lcd_WindowValid = false;
+static uint16_t Lcd_WindowX0, Lcd_WindowX1, Lcd_WindowY0, Lcd_WindowY1;
+
+// The RAMWR stream which is still open, and the screen position its next
+// pixel goes to. Only one row streams are kept open; any other command ends
+// the stream.
+static bool Lcd_WriteOpen = false;
+static uint16_t Lcd_WriteX, Lcd_WriteY, Lcd_WriteX1;
+
+// Window update bytes sent and skipped since they were last taken
+static uint32_t Lcd_WindowBytesSent, Lcd_WindowBytesSaved;
+
 //*****************************************************************************
 //
 //! Initializes the display driver.
 //!
 //! This function initializes the ST7735 display controller on the panel,
-//! preparing it to display data.
+//! preparing it to display data. It blocks for the whole power-up sequence;
+//! Crystalfontz128x128_Reset(), Crystalfontz128x128_SleepOut(),
+//! Crystalfontz128x128_Configure() and Crystalfontz128x128_DisplayOn() run
+//! the same sequence step by step, so that the waits between the steps can be
+//! used for other work.
+//!
+//! The frame memory is not cleared, so it should be drawn over before the
+//! display is turned on.
 //!
 //! \return None.
 //
 //*****************************************************************************
 void Crystalfontz128x128_Init(void) {
+  Crystalfontz128x128_Reset();
+  HAL_LCD_delay(LCD_RESET_TIME_MS * 1000);
+
+  Crystalfontz128x128_SleepOut();
+  HAL_LCD_delay(LCD_SLEEP_OUT_TIME_MS * 1000);
+
+  Crystalfontz128x128_Configure();
+  HAL_LCD_delay((LCD_DISPLAY_ON_TIME_MS - LCD_SLEEP_OUT_TIME_MS) * 1000);
+
+  Crystalfontz128x128_DisplayOn();
+}
+
+//*****************************************************************************
+//
+//! Sets up the pins and the SPI module and resets the controller.
+//!
+//! The controller accepts SLPOUT \b LCD_RESET_TIME_MS after this returns.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Crystalfontz128x128_Reset(void) {
   HAL_LCD_PortInit();
   HAL_LCD_SpiInit();
 
   GPIO_setOutputLowOnPin(LCD_RST_PORT, LCD_RST_PIN);
   HAL_LCD_delay(50);
   GPIO_setOutputHighOnPin(LCD_RST_PORT, LCD_RST_PIN);
-  HAL_LCD_delay(120);
+}
 
+//*****************************************************************************
+//
+//! Wakes the controller from the sleep mode it starts in.
+//!
+//! The controller accepts further commands \b LCD_SLEEP_OUT_TIME_MS after
+//! this returns.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Crystalfontz128x128_SleepOut(void) {
   HAL_LCD_writeCommand(CM_SLPOUT);
-  HAL_LCD_delay(200);
+}
 
+//*****************************************************************************
+//
+//! Configures the controller for 16-bit color in normal mode.
+//!
+//! The frame memory can be drawn to once this returns, while the display is
+//! still off.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Crystalfontz128x128_Configure(void) {
   HAL_LCD_writeCommand(CM_GAMSET);
   HAL_LCD_writeData(0x04);
 
@@ -96,20 +174,39 @@ void Crystalfontz128x128_Init(void) {
   Lcd_FlagRead = 0;
   Lcd_TouchTrim = 0;
 
-  Crystalfontz128x128_SetDrawFrame(0, 0, 127, 127);
-  HAL_LCD_writeCommand(CM_RAMWR);
-  int i;
-  for (i = 0; i < 16384; i++) {
-    HAL_LCD_writeData(0xFF);
-    HAL_LCD_writeData(0xFF);
-  }
+  Lcd_WindowValid = false;
+  Lcd_WriteOpen = false;
+}
 
-  HAL_LCD_delay(10);
-  HAL_LCD_writeCommand(CM_DISPON);
+//*****************************************************************************
+//
+//! Turns the display on, showing the frame memory.
+//!
+//! This must be called no earlier than \b LCD_DISPLAY_ON_TIME_MS after
+//! Crystalfontz128x128_SleepOut(). If the panel already rests in low power
+//! mode, it stays there.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Crystalfontz128x128_DisplayOn(void) {
+  if (Lcd_LowPower) {
+    HAL_LCD_SpiEnable();
+    HAL_LCD_writeCommand(CM_DISPON);
+    HAL_LCD_SpiDisable();
+  } else {
+    HAL_LCD_writeCommand(CM_DISPON);
+  }
 }
 
 void Crystalfontz128x128_SetDrawFrame(uint16_t x0, uint16_t y0, uint16_t x1,
                                       uint16_t y1) {
+  Crystalfontz128x128_Wake();
+
+  // The caller starts a new RAMWR, which moves the write pointer back to the
+  // start of the window
+  Lcd_WriteOpen = false;
+
   switch (Lcd_Orientation) {
     case 0:
       x0 += 2;
@@ -139,17 +236,86 @@ void Crystalfontz128x128_SetDrawFrame(uint16_t x0, uint16_t y0, uint16_t x1,
       break;
   }
 
-  HAL_LCD_writeCommand(CM_CASET);
-  HAL_LCD_writeData((uint8_t)(x0 >> 8));
-  HAL_LCD_writeData((uint8_t)(x0));
-  HAL_LCD_writeData((uint8_t)(x1 >> 8));
-  HAL_LCD_writeData((uint8_t)(x1));
-
-  HAL_LCD_writeCommand(CM_RASET);
-  HAL_LCD_writeData((uint8_t)(y0 >> 8));
-  HAL_LCD_writeData((uint8_t)(y0));
-  HAL_LCD_writeData((uint8_t)(y1 >> 8));
-  HAL_LCD_writeData((uint8_t)(y1));
+  // Only the parts of the window which changed are sent
+  if (Lcd_WindowValid && x0 == Lcd_WindowX0 && x1 == Lcd_WindowX1) {
+    Lcd_WindowBytesSaved += LCD_CASET_BYTES;
+  } else {
+    HAL_LCD_writeCommand(CM_CASET);
+    HAL_LCD_writeData((uint8_t)(x0 >> 8));
+    HAL_LCD_writeData((uint8_t)(x0));
+    HAL_LCD_writeData((uint8_t)(x1 >> 8));
+    HAL_LCD_writeData((uint8_t)(x1));
+    Lcd_WindowBytesSent += LCD_CASET_BYTES;
+  }
+
+  if (Lcd_WindowValid && y0 == Lcd_WindowY0 && y1 == Lcd_WindowY1) {
+    Lcd_WindowBytesSaved += LCD_RASET_BYTES;
+  } else {
+    HAL_LCD_writeCommand(CM_RASET);
+    HAL_LCD_writeData((uint8_t)(y0 >> 8));
+    HAL_LCD_writeData((uint8_t)(y0));
+    HAL_LCD_writeData((uint8_t)(y1 >> 8));
+    HAL_LCD_writeData((uint8_t)(y1));
+    Lcd_WindowBytesSent += LCD_RASET_BYTES;
+  }
+
+  Lcd_WindowValid = true;
+  Lcd_WindowX0 = x0;
+  Lcd_WindowX1 = x1;
+  Lcd_WindowY0 = y0;
+  Lcd_WindowY1 = y1;
+}
+
+//*****************************************************************************
+//
+//! Returns and clears the count of window update bytes.
+//!
+//! \param sent_p points to where the number of CASET, RASET and RAMWR bytes
+//! sent by the drawing functions is stored.
+//! \param saved_p points to where the number of those bytes which were not
+//! sent, because the window or the RAMWR stream could be reused, is stored.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Crystalfontz128x128_TakeWindowBytes(uint32_t *sent_p, uint32_t *saved_p) {
+  *sent_p = Lcd_WindowBytesSent;
+  *saved_p = Lcd_WindowBytesSaved;
+  Lcd_WindowBytesSent = 0;
+  Lcd_WindowBytesSaved = 0;
+}
+
+//*****************************************************************************
+//
+// Prepares the controller for the pixels of a block, which the caller sends
+// next. A one row block which starts where the open RAMWR stream left off
+// just continues that stream, without any command. Otherwise the window is
+// set and RAMWR sent; a one row block gets a window reaching the right edge
+// of the screen so that the block to its right can continue the stream.
+//
+//*****************************************************************************
+RAMFUNC static void Crystalfontz128x128_StartWrite(int16_t x0, int16_t y0,
+                                           int16_t x1, int16_t y1) {
+  if (y0 == y1 && Lcd_WriteOpen && y0 == Lcd_WriteY && x0 == Lcd_WriteX &&
+      x1 <= Lcd_WriteX1) {
+    Lcd_WindowBytesSaved +=
+        LCD_CASET_BYTES + LCD_RASET_BYTES + LCD_RAMWR_BYTES;
+    Lcd_WriteX = x1 + 1;
+    return;
+  }
+
+  if (y0 == y1) {
+    Crystalfontz128x128_SetDrawFrame(x0, y0, LCD_HORIZONTAL_MAX - 1, y0);
+    HAL_LCD_writeCommand(CM_RAMWR);
+    Lcd_WriteOpen = true;
+    Lcd_WriteX = x1 + 1;
+    Lcd_WriteY = y0;
+    Lcd_WriteX1 = LCD_HORIZONTAL_MAX - 1;
+  } else {
+    Crystalfontz128x128_SetDrawFrame(x0, y0, x1, y1);
+    HAL_LCD_writeCommand(CM_RAMWR);
+  }
+  Lcd_WindowBytesSent += LCD_RAMWR_BYTES;
 }
 
 //*****************************************************************************
@@ -168,6 +334,12 @@ void Crystalfontz128x128_SetDrawFrame(uint16_t x0, uint16_t y0, uint16_t x1,
 //
 //*****************************************************************************
 void Crystalfontz128x128_SetOrientation(uint8_t orientation) {
+  Crystalfontz128x128_Wake();
+
+  // The offsets of the window change with the orientation
+  Lcd_WindowValid = false;
+  Lcd_WriteOpen = false;
+
   Lcd_Orientation = orientation;
   HAL_LCD_writeCommand(CM_MADCTL);
   switch (Lcd_Orientation) {
@@ -186,6 +358,238 @@ void Crystalfontz128x128_SetOrientation(uint8_t orientation) {
   }
 }
 
+#if !LCD_FRAMEBUFFER
+//*****************************************************************************
+//
+//! Starts writing a block of pixels.
+//!
+//! \param x0 is the left column of the block.
+//! \param y0 is the top row of the block.
+//! \param x1 is the right column of the block.
+//! \param y1 is the bottom row of the block.
+//!
+//! The pixels passed to Crystalfontz128x128_WritePixels() afterwards fill the
+//! block row by row, from left to right. The colors are RGB565 values as
+//! returned by the ColorTranslate function of this driver.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Crystalfontz128x128_BeginPixels(uint16_t x0, uint16_t y0, uint16_t x1,
+                                     uint16_t y1) {
+  Crystalfontz128x128_SetDrawFrame(x0, y0, x1, y1);
+  HAL_LCD_writeCommand(CM_RAMWR);
+}
+
+//*****************************************************************************
+//
+//! Writes a run of pixels of one color into the block started with
+//! Crystalfontz128x128_BeginPixels().
+//!
+//! \param color is the RGB565 color of the run.
+//! \param count is the number of pixels in the run.
+//!
+//! \return None.
+//
+//*****************************************************************************
+RAMFUNC void Crystalfontz128x128_WritePixels(uint16_t color, uint16_t count) {
+  while (count--) {
+    HAL_LCD_writeData(color >> 8);
+    HAL_LCD_writeData(color);
+  }
+}
+#endif
+
+//*****************************************************************************
+//
+//! Defines the part of the screen which scrolls in hardware.
+//!
+//! \param top is the first screen row of the scroll area.
+//! \param height is the number of rows in the scroll area.
+//!
+//! The rows above and below the area stay fixed. The controller scrolls along
+//! its frame memory rows, which are the screen rows only in the
+//! \b LCD_ORIENTATION_UP and \b LCD_ORIENTATION_DOWN orientations; in the
+//! other orientations this function does nothing. In the UP orientation the
+//! frame memory is mirrored (MADCTL MY), so the area is mirrored too.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Crystalfontz128x128_SetScrollArea(uint16_t top, uint16_t height) {
+  uint16_t fixedTop;
+
+  switch (Lcd_Orientation) {
+    case LCD_ORIENTATION_UP:
+      fixedTop = LCD_FRAME_ROWS - 3 - (top + height);
+      break;
+    case LCD_ORIENTATION_DOWN:
+      fixedTop = top + 1;
+      break;
+    default:
+      return;
+  }
+
+  Crystalfontz128x128_Wake();
+  Lcd_WriteOpen = false;
+
+  Lcd_ScrollTop = top;
+  Lcd_ScrollHeight = height;
+
+  HAL_LCD_writeCommand(CM_VSCRDEF);
+  HAL_LCD_writeData((uint8_t)(fixedTop >> 8));
+  HAL_LCD_writeData((uint8_t)(fixedTop));
+  HAL_LCD_writeData((uint8_t)(height >> 8));
+  HAL_LCD_writeData((uint8_t)(height));
+  HAL_LCD_writeData((uint8_t)((LCD_FRAME_ROWS - fixedTop - height) >> 8));
+  HAL_LCD_writeData((uint8_t)(LCD_FRAME_ROWS - fixedTop - height));
+}
+
+//*****************************************************************************
+//
+//! Scrolls the hardware scroll area.
+//!
+//! \param row is the screen row, drawn as usual through SetDrawFrame, which is
+//! shown at the top of the scroll area. The rows below it follow, wrapping
+//! around from the bottom of the area to its top. Passing the top row of the
+//! area shows the area unscrolled.
+//!
+//! Only two bytes of data are sent, however much of the area moves.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Crystalfontz128x128_SetScrollStart(uint16_t row) {
+  uint16_t start;
+
+  switch (Lcd_Orientation) {
+    case LCD_ORIENTATION_UP:
+      // The frame memory runs bottom to top, so its first line in the area is
+      // the screen row shown at the bottom of the area
+      row = Lcd_ScrollTop +
+            (row - Lcd_ScrollTop + Lcd_ScrollHeight - 1) % Lcd_ScrollHeight;
+      start = LCD_FRAME_ROWS - 1 - (row + 3);
+      break;
+    case LCD_ORIENTATION_DOWN:
+      start = row + 1;
+      break;
+    default:
+      return;
+  }
+
+  Crystalfontz128x128_Wake();
+  Lcd_WriteOpen = false;
+
+  HAL_LCD_writeCommand(CM_VSCSAD);
+  HAL_LCD_writeData((uint8_t)(start >> 8));
+  HAL_LCD_writeData((uint8_t)(start));
+}
+
+//*****************************************************************************
+//
+//! Puts the panel into its low power modes while it shows a static screen.
+//!
+//! \param top is the first screen row which shows anything.
+//! \param bottom is the last screen row which shows anything.
+//!
+//! The panel is switched to partial mode, which refreshes only the rows from
+//! \e top to \e bottom, and to idle mode, which shows 8 colors. The rows
+//! outside the partial area are not refreshed and show the panel's
+//! non-display color instead of their content. Partial mode follows the frame
+//! memory rows, so in the \b LCD_ORIENTATION_LEFT and
+//! \b LCD_ORIENTATION_RIGHT orientations only idle mode is used. The SPI
+//! module is stopped afterwards.
+//!
+//! Any later drawing, scrolling or orientation change wakes the panel with
+//! Crystalfontz128x128_Wake() first.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Crystalfontz128x128_EnterLowPower(uint16_t top, uint16_t bottom) {
+  uint16_t start, end;
+  bool partial = true;
+
+  if (Lcd_LowPower) {
+    return;
+  }
+  Lcd_WriteOpen = false;
+
+  switch (Lcd_Orientation) {
+    case LCD_ORIENTATION_UP:
+      // The frame memory runs bottom to top, see SetScrollStart
+      start = LCD_FRAME_ROWS - 1 - (bottom + 3);
+      end = LCD_FRAME_ROWS - 1 - (top + 3);
+      break;
+    case LCD_ORIENTATION_DOWN:
+      start = top + 1;
+      end = bottom + 1;
+      break;
+    default:
+      partial = false;
+      break;
+  }
+
+  if (partial) {
+    HAL_LCD_writeCommand(CM_PTLAR);
+    HAL_LCD_writeData((uint8_t)(start >> 8));
+    HAL_LCD_writeData((uint8_t)(start));
+    HAL_LCD_writeData((uint8_t)(end >> 8));
+    HAL_LCD_writeData((uint8_t)(end));
+    HAL_LCD_writeCommand(CM_PTLON);
+  }
+  HAL_LCD_writeCommand(CM_IDMON);
+
+  HAL_LCD_SpiDisable();
+  Lcd_LowPower = true;
+}
+
+//*****************************************************************************
+//
+//! Brings the panel back to full color normal mode after
+//! Crystalfontz128x128_EnterLowPower().
+//!
+//! Waking restarts the SPI module and sends two command bytes, which takes
+//! a few microseconds; the panel shows the whole screen again from its next
+//! frame. Nothing is sent when the panel is not in low power mode.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Crystalfontz128x128_Wake(void) {
+  if (!Lcd_LowPower) {
+    return;
+  }
+  Lcd_LowPower = false;
+  Lcd_WriteOpen = false;
+
+  HAL_LCD_SpiEnable();
+  HAL_LCD_writeCommand(CM_IDMOFF);
+  HAL_LCD_writeCommand(CM_NORON);
+}
+
+//*****************************************************************************
+//
+//! Reconfigures the SPI interface after SMCLK changed.
+//!
+//! \param systemClockHz is the new frequency of SMCLK.
+//!
+//! The SPI clock stays at LCD_SPI_CLOCK_SPEED while SMCLK is at least that
+//! fast, and runs at SMCLK otherwise. An open RAMWR stream stays open, as the
+//! panel does not see the reconfiguration. The SPI module is left stopped
+//! while the panel is in low power mode.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Crystalfontz128x128_SetSystemClock(uint32_t systemClockHz) {
+  HAL_LCD_SpiConfigure(systemClockHz);
+
+  if (!Lcd_LowPower) {
+    HAL_LCD_SpiEnable();
+  }
+}
+
 //*****************************************************************************
 //
 //! Draws a pixel on the screen.
@@ -202,15 +606,14 @@ void Crystalfontz128x128_SetOrientation(uint8_t orientation) {
 //! \return None.
 //
 //*****************************************************************************
-static void Crystalfontz128x128_PixelDraw(const Graphics_Display *pDisplay,
+RAMFUNC static void Crystalfontz128x128_PixelDraw(const Graphics_Display *pDisplay,
                                           int16_t lX, int16_t lY,
                                           uint16_t ulValue) {
-  Crystalfontz128x128_SetDrawFrame(lX, lY, lX, lY);
+  Crystalfontz128x128_StartWrite(lX, lY, lX, lY);
 
   //
   // Write the pixel value.
   //
-  HAL_LCD_writeCommand(CM_RAMWR);
   HAL_LCD_writeData(ulValue >> 8);
   HAL_LCD_writeData(ulValue);
 }
@@ -240,17 +643,18 @@ static void Crystalfontz128x128_PixelDraw(const Graphics_Display *pDisplay,
 //! \return None.
 //
 //*****************************************************************************
-static void Crystalfontz128x128_PixelDrawMultiple(
+RAMFUNC static void Crystalfontz128x128_PixelDrawMultiple(
     const Graphics_Display *pDisplay, int16_t lX, int16_t lY, int16_t lX0,
     int16_t lCount, int16_t lBPP, const uint8_t *pucData,
     const uint32_t *pucPalette) {
   uint16_t Data;
 
+  TRACE_ENTER_ARG(TRACE_LCD_PIXELS, lCount);
+
   //
-  // Set the cursor increment to left to right, followed by top to bottom.
+  // The pixels go left to right along one row.
   //
-  Crystalfontz128x128_SetDrawFrame(lX, lY, lX + lCount, 127);
-  HAL_LCD_writeCommand(CM_RAMWR);
+  Crystalfontz128x128_StartWrite(lX, lY, lX + lCount - 1, lY);
 
   //
   // Determine how to interpret the pixel data based on the number of bits
@@ -365,6 +769,8 @@ static void Crystalfontz128x128_PixelDrawMultiple(
       }
     }
   }
+
+  TRACE_EXIT(TRACE_LCD_PIXELS);
 }
 
 //*****************************************************************************
@@ -384,20 +790,23 @@ static void Crystalfontz128x128_PixelDrawMultiple(
 //! \return None.
 //
 //*****************************************************************************
-static void Crystalfontz128x128_LineDrawH(const Graphics_Display *pDisplay,
+RAMFUNC static void Crystalfontz128x128_LineDrawH(const Graphics_Display *pDisplay,
                                           int16_t lX1, int16_t lX2, int16_t lY,
                                           uint16_t ulValue) {
-  Crystalfontz128x128_SetDrawFrame(lX1, lY, lX2, lY);
+  TRACE_ENTER_ARG(TRACE_LCD_LINE_H, lX2 - lX1 + 1);
+
+  Crystalfontz128x128_StartWrite(lX1, lY, lX2, lY);
 
   //
   // Write the pixel value.
   //
   int16_t i;
-  HAL_LCD_writeCommand(CM_RAMWR);
   for (i = lX1; i <= lX2; i++) {
     HAL_LCD_writeData(ulValue >> 8);
     HAL_LCD_writeData(ulValue);
   }
+
+  TRACE_EXIT(TRACE_LCD_LINE_H);
 }
 
 //*****************************************************************************
@@ -417,20 +826,23 @@ static void Crystalfontz128x128_LineDrawH(const Graphics_Display *pDisplay,
 //! \return None.
 //
 //*****************************************************************************
-static void Crystalfontz128x128_LineDrawV(const Graphics_Display *pDisplay,
+RAMFUNC static void Crystalfontz128x128_LineDrawV(const Graphics_Display *pDisplay,
                                           int16_t lX, int16_t lY1, int16_t lY2,
                                           uint16_t ulValue) {
-  Crystalfontz128x128_SetDrawFrame(lX, lY1, lX, lY2);
+  TRACE_ENTER_ARG(TRACE_LCD_LINE_V, lY2 - lY1 + 1);
+
+  Crystalfontz128x128_StartWrite(lX, lY1, lX, lY2);
 
   //
   // Write the pixel value.
   //
   int16_t i;
-  HAL_LCD_writeCommand(CM_RAMWR);
   for (i = lY1; i <= lY2; i++) {
     HAL_LCD_writeData(ulValue >> 8);
     HAL_LCD_writeData(ulValue);
   }
+
+  TRACE_EXIT(TRACE_LCD_LINE_V);
 }
 
 //*****************************************************************************
@@ -450,7 +862,7 @@ static void Crystalfontz128x128_LineDrawV(const Graphics_Display *pDisplay,
 //! \return None.
 //
 //*****************************************************************************
-static void Crystalfontz128x128_RectFill(const Graphics_Display *pDisplay,
+RAMFUNC static void Crystalfontz128x128_RectFill(const Graphics_Display *pDisplay,
                                          const Graphics_Rectangle *pRect,
                                          uint16_t ulValue) {
   int16_t x0 = pRect->sXMin;
@@ -458,18 +870,22 @@ static void Crystalfontz128x128_RectFill(const Graphics_Display *pDisplay,
   int16_t y0 = pRect->sYMin;
   int16_t y1 = pRect->sYMax;
 
-  Crystalfontz128x128_SetDrawFrame(x0, y0, x1, y1);
+  TRACE_ENTER_ARG(TRACE_LCD_RECT, (x1 - x0 + 1) * (y1 - y0 + 1));
+
+  Crystalfontz128x128_StartWrite(x0, y0, x1, y1);
 
   //
-  // Write the pixel value.
+  // Write the pixel value. A one row fill may continue an open stream, so
+  // exactly the pixels of the rectangle are written.
   //
   int16_t i;
   int16_t pixels = (x1 - x0 + 1) * (y1 - y0 + 1);
-  HAL_LCD_writeCommand(CM_RAMWR);
-  for (i = 0; i <= pixels; i++) {
+  for (i = 0; i < pixels; i++) {
     HAL_LCD_writeData(ulValue >> 8);
     HAL_LCD_writeData(ulValue);
   }
+
+  TRACE_EXIT(TRACE_LCD_RECT);
 }
 
 //*****************************************************************************
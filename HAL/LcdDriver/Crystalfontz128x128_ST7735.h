@@ -53,6 +53,17 @@
 #define LCD_ORIENTATION_DOWN 2
 #define LCD_ORIENTATION_RIGHT 3
 
+// Rows of the controller's frame memory, of which the panel shows 128
+#define LCD_FRAME_ROWS 132
+
+// Waits of the power-up sequence: after the reset before SLPOUT, after SLPOUT
+// before the next command, and after SLPOUT before the display is turned on.
+// The controller takes other commands 5 ms after the reset, but SLPOUT only
+// after 120 ms, and SLPOUT is the first command sent.
+#define LCD_RESET_TIME_MS 120
+#define LCD_SLEEP_OUT_TIME_MS 5
+#define LCD_DISPLAY_ON_TIME_MS 120
+
 // ST7735 LCD controller Command Set
 #define CM_NOP 0x00
 #define CM_SWRESET 0x01
@@ -73,7 +84,11 @@
 #define CM_RGBSET 0x2d
 #define CM_RAMRD 0x2E
 #define CM_PTLAR 0x30
+#define CM_VSCRDEF 0x33
 #define CM_MADCTL 0x36
+#define CM_VSCSAD 0x37
+#define CM_IDMOFF 0x38
+#define CM_IDMON 0x39
 #define CM_COLMOD 0x3A
 #define CM_SETPWCTR 0xB1
 #define CM_SETDISPL 0xB2
@@ -101,11 +116,41 @@ extern Graphics_Display g_sCrystalfontz128x128;
 
 extern const Graphics_Display_Functions g_sCrystalfontz128x128_funcs;
 
+// Display functions drawing into the offscreen framebuffer, only available
+// when LCD_FRAMEBUFFER is set
+extern const Graphics_Display_Functions g_sCrystalfontz128x128_fbFuncs;
+
 extern void Crystalfontz128x128_Init(void);
 
+extern void Crystalfontz128x128_Reset(void);
+
+extern void Crystalfontz128x128_SleepOut(void);
+
+extern void Crystalfontz128x128_Configure(void);
+
+extern void Crystalfontz128x128_DisplayOn(void);
+
 extern void Crystalfontz128x128_SetDrawFrame(uint16_t x0, uint16_t y0,
                                              uint16_t x1, uint16_t y1);
 
 extern void Crystalfontz128x128_SetOrientation(uint8_t orientation);
 
+extern void Crystalfontz128x128_TakeWindowBytes(uint32_t *sent_p,
+                                                uint32_t *saved_p);
+
+extern void Crystalfontz128x128_BeginPixels(uint16_t x0, uint16_t y0,
+                                            uint16_t x1, uint16_t y1);
+
+extern void Crystalfontz128x128_WritePixels(uint16_t color, uint16_t count);
+
+extern void Crystalfontz128x128_SetScrollArea(uint16_t top, uint16_t height);
+
+extern void Crystalfontz128x128_SetScrollStart(uint16_t row);
+
+extern void Crystalfontz128x128_EnterLowPower(uint16_t top, uint16_t bottom);
+
+extern void Crystalfontz128x128_Wake(void);
+
+extern void Crystalfontz128x128_SetSystemClock(uint32_t systemClockHz);
+
 #endif /* __CRYSTALFONTZLCD_H__ */
@@ -38,6 +38,8 @@
 //*****************************************************************************
 
 #include <HAL/LcdDriver/HAL_MSP_EXP432P401R_Crystalfontz128x128_ST7735.h>
+#include <HAL/Metrics.h>
+#include <HAL/RamFunc.h>
 #include <stdint.h>
 #include <ti/devices/msp432p4xx/driverlib/driverlib.h>
 #include <ti/grlib/grlib.h>
@@ -57,16 +59,31 @@ void HAL_LCD_PortInit(void) {
   GPIO_setAsOutputPin(LCD_CS_PORT, LCD_CS_PIN);
 }
 
-void HAL_LCD_SpiInit(void) {
+//*****************************************************************************
+//
+// Configures the SPI module for a given SMCLK frequency, leaving it stopped.
+// The SPI clock is LCD_SPI_CLOCK_SPEED, or SMCLK itself when that is slower.
+//
+//*****************************************************************************
+void HAL_LCD_SpiConfigure(uint32_t systemClockHz) {
   eUSCI_SPI_MasterConfig config = {
       EUSCI_B_SPI_CLOCKSOURCE_SMCLK,
-      LCD_SYSTEM_CLOCK_SPEED,
-      LCD_SPI_CLOCK_SPEED,
+      systemClockHz,
+      LCD_SPI_CLOCK_SPEED < systemClockHz ? LCD_SPI_CLOCK_SPEED : systemClockHz,
       EUSCI_B_SPI_MSB_FIRST,
       EUSCI_B_SPI_PHASE_DATA_CAPTURED_ONFIRST_CHANGED_ON_NEXT,
       EUSCI_B_SPI_CLOCKPOLARITY_INACTIVITY_LOW,
       EUSCI_B_SPI_3PIN};
+
+  // USCI_B0 Busy? //
+  while (UCB0STATW & UCBUSY)
+    ;
+
   SPI_initMaster(LCD_EUSCI_BASE, &config);
+}
+
+void HAL_LCD_SpiInit(void) {
+  HAL_LCD_SpiConfigure(LCD_SYSTEM_CLOCK_SPEED);
   SPI_enableModule(LCD_EUSCI_BASE);
 
   GPIO_setOutputLowOnPin(LCD_CS_PORT, LCD_CS_PIN);
@@ -74,13 +91,40 @@ void HAL_LCD_SpiInit(void) {
   GPIO_setOutputHighOnPin(LCD_DC_PORT, LCD_DC_PIN);
 }
 
+//*****************************************************************************
+//
+// Stops the SPI module once the last byte is out and deselects the LCD, so
+// that neither the module nor the LCD's interface is clocked while nothing is
+// drawn.
+//
+//*****************************************************************************
+void HAL_LCD_SpiDisable(void) {
+  // USCI_B0 Busy? //
+  while (UCB0STATW & UCBUSY)
+    ;
+
+  GPIO_setOutputHighOnPin(LCD_CS_PORT, LCD_CS_PIN);
+  SPI_disableModule(LCD_EUSCI_BASE);
+}
+
+//*****************************************************************************
+//
+// Restarts the SPI module stopped by HAL_LCD_SpiDisable(). The configuration
+// is kept while the module is stopped, so it is ready right away.
+//
+//*****************************************************************************
+void HAL_LCD_SpiEnable(void) {
+  SPI_enableModule(LCD_EUSCI_BASE);
+  GPIO_setOutputLowOnPin(LCD_CS_PORT, LCD_CS_PIN);
+}
+
 //*****************************************************************************
 //
 // Writes a command to the CFAF128128B-0145T.  This function implements the
 // basic SPI interface to the LCD display.
 //
 //*****************************************************************************
-void HAL_LCD_writeCommand(uint8_t command) {
+RAMFUNC void HAL_LCD_writeCommand(uint8_t command) {
   // Set to command mode
   GPIO_setOutputLowOnPin(LCD_DC_PORT, LCD_DC_PIN);
 
@@ -90,6 +134,7 @@ void HAL_LCD_writeCommand(uint8_t command) {
 
   // Transmit data
   UCB0TXBUF = command;
+  METRIC_COUNT(METRIC_SPI_BYTES);
 
   // USCI_B0 Busy? //
   while (UCB0STATW & UCBUSY)
@@ -105,13 +150,14 @@ void HAL_LCD_writeCommand(uint8_t command) {
 // SPI interface to the LCD display.
 //
 //*****************************************************************************
-void HAL_LCD_writeData(uint8_t data) {
+RAMFUNC void HAL_LCD_writeData(uint8_t data) {
   // USCI_B0 Busy? //
   while (UCB0STATW & UCBUSY)
     ;
 
   // Transmit data
   UCB0TXBUF = data;
+  METRIC_COUNT(METRIC_SPI_BYTES);
 
   // USCI_B0 Busy? //
   while (UCB0STATW & UCBUSY)
@@ -151,7 +197,8 @@ void SysCtlDelay(uint32_t ui32Count) {
       "    bx      lr");
 }
 #endif
-#if defined(codered) || defined(__GNUC__) || defined(sourcerygxx)
+#if defined(codered) || (defined(__GNUC__) && defined(__arm__)) || \
+    defined(sourcerygxx)
 void __attribute__((naked)) SysCtlDelay(uint32_t ui32Count) {
   __asm(
       "    subs    r0, #1\n"
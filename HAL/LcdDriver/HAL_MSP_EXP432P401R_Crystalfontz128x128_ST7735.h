@@ -48,7 +48,7 @@
 //
 //*****************************************************************************
 
-// System clock speed (in Hz)
+// System clock speed (in Hz) at initialization
 #define LCD_SYSTEM_CLOCK_SPEED 48000000
 // SPI clock speed (in Hz)
 #define LCD_SPI_CLOCK_SPEED 16000000
@@ -72,6 +72,16 @@
 // Definition of USCI base address to be used for SPI communication
 #define LCD_EUSCI_BASE EUSCI_B0_BASE
 
+// Set to 1 to draw into an 8bpp offscreen framebuffer (16 KB of SRAM) which
+// is sent to the LCD on Graphics_flushBuffer(), instead of drawing directly
+#ifndef LCD_FRAMEBUFFER
+#define LCD_FRAMEBUFFER 0
+#endif
+
+// DMA channel feeding the SPI transmit buffer when flushing the framebuffer
+#define LCD_DMA_CHANNEL DMA_CH0_EUSCIB0TX0
+#define LCD_DMA_CHANNEL_NUMBER 0
+
 //*****************************************************************************
 //
 // Prototypes for the globals exported by this driver.
@@ -80,7 +90,10 @@
 extern void HAL_LCD_writeCommand(uint8_t command);
 extern void HAL_LCD_writeData(uint8_t data);
 extern void HAL_LCD_PortInit(void);
+extern void HAL_LCD_SpiConfigure(uint32_t systemClockHz);
 extern void HAL_LCD_SpiInit(void);
+extern void HAL_LCD_SpiDisable(void);
+extern void HAL_LCD_SpiEnable(void);
 
 // Custom __delay_cycles() for non CCS Compiler
 #if !defined(__TI_ARM__)
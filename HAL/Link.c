@@ -0,0 +1,240 @@
+/*
+ * Link.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <HAL/Link.h>
+#include <HAL/Metrics.h>
+#include <string.h>
+
+/**
+ * Constructs a link to another board and starts its first session. The UART
+ * must already be enabled at the baudrate both boards agreed on.
+ *
+ * @param uart_p:   The UART connected to the other board
+ *
+ * @return the constructed link with no message in flight
+ */
+Link Link_construct(UART* uart_p) {
+  Link link;
+
+  link.uart_p = uart_p;
+  link.retransmitTimer = SWTimer_construct(LINK_RETRANSMIT_TIME_MS);
+  link.roundTripTimer = SWTimer_construct(0);
+  link.lastRoundTripUS = 0;
+  link.maxRoundTripUS = 0;
+  link.messagesSent = 0;
+  link.messagesReceived = 0;
+  link.retransmissions = 0;
+  link.duplicates = 0;
+  Link_reset(&link);
+
+  return link;
+}
+
+/**
+ * Starts a new session by sending a SYNC frame, which Link_refresh() sends
+ * again until the peer answers it. No message can be sent until then. The
+ * statistics of the link are kept.
+ *
+ * @param link_p:   The link to reset
+ */
+void Link_reset(Link* link_p) {
+  link_p->frame = Frame_construct();
+  link_p->txSeq = 0;
+  link_p->rxSeq = 0;
+  link_p->awaitingAck = false;
+  link_p->retries = 0;
+  link_p->lost = false;
+  link_p->syncing = true;
+
+  Frame_send(link_p->uart_p, LINK_MSG_SYNC, 0, NULL, 0);
+  SWTimer_start(&link_p->retransmitTimer);
+}
+
+/**
+ * Determines whether a new message can be sent, which is the case when the
+ * session is started, the previous message was acknowledged and the peer is
+ * still there.
+ *
+ * @param link_p:   The link to check
+ *
+ * @return true if Link_send() will accept a message
+ */
+bool Link_canSend(Link* link_p) {
+  return !link_p->syncing && !link_p->awaitingAck && !link_p->lost;
+}
+
+/**
+ * Sends a message to the peer and keeps it until it is acknowledged.
+ *
+ * @param link_p:   The link to send on
+ * @param type:     The message type, any frame type but the LINK_MSG_* ones
+ * @param payload:  The message payload
+ * @param length:   The payload length, at most LINK_MAX_PAYLOAD
+ *
+ * @return true if the message was sent, false if the link is busy or lost
+ */
+bool Link_send(Link* link_p, uint8_t type, const uint8_t* payload,
+               uint16_t length) {
+  if (!Link_canSend(link_p) || length > LINK_MAX_PAYLOAD) {
+    return false;
+  }
+
+  link_p->txType = type;
+  memcpy(link_p->txPayload, payload, length);
+  link_p->txLength = length;
+  link_p->awaitingAck = true;
+  link_p->retries = 0;
+
+  Frame_send(link_p->uart_p, type, link_p->txSeq, payload, length);
+  SWTimer_start(&link_p->retransmitTimer);
+  SWTimer_start(&link_p->roundTripTimer);
+  link_p->messagesSent++;
+
+  return true;
+}
+
+/**
+ * Handles an acknowledgement from the peer. Acknowledgements for anything but
+ * the message in flight are late copies and are ignored.
+ *
+ * @param link_p:   The link which received the acknowledgement
+ * @param seq:      The acknowledged sequence number
+ */
+static void Link_handleAck(Link* link_p, uint8_t seq) {
+  if (!link_p->awaitingAck || seq != link_p->txSeq) {
+    return;
+  }
+
+  link_p->lastRoundTripUS =
+      (uint32_t)SWTimer_elapsedTimeUS(&link_p->roundTripTimer);
+  if (link_p->lastRoundTripUS > link_p->maxRoundTripUS) {
+    link_p->maxRoundTripUS = link_p->lastRoundTripUS;
+  }
+  METRIC_COUNT(METRIC_LINK_ACKS);
+  METRIC_ADD(METRIC_LINK_ROUND_TRIP_US, link_p->lastRoundTripUS);
+
+  link_p->txSeq++;
+  link_p->awaitingAck = false;
+}
+
+/**
+ * Follows the peer into the session it started. The message in flight, if
+ * any, is numbered anew and sent again once its retransmission is due.
+ *
+ * @param link_p:   The link which received the session start
+ */
+static void Link_handleSync(Link* link_p) {
+  Frame_send(link_p->uart_p, LINK_MSG_SYNC_ACK, 0, NULL, 0);
+
+  link_p->txSeq = 0;
+  link_p->rxSeq = 0;
+  link_p->retries = 0;
+}
+
+/**
+ * Reads every byte the peer sent so far. Acknowledgements are handled on the
+ * spot and every message is acknowledged, but only a message with the expected
+ * sequence number is delivered; anything else is a copy of a message which was
+ * already delivered. A session start from the peer numbers both directions
+ * from 0 again, and the answer to this board's session start ends the wait
+ * for it.
+ *
+ * @param link_p:       The link to receive on
+ * @param message_p:    Where the new message is stored
+ *
+ * @return true if a new message was stored in message_p
+ */
+bool Link_receive(Link* link_p, FrameMessage* message_p) {
+  while (UART_hasChar(link_p->uart_p)) {
+    uint8_t rxByte = (uint8_t)UART_getChar(link_p->uart_p);
+
+    // Nothing but frames travels over the link
+    if (!Frame_isReceiving(&link_p->frame, rxByte) ||
+        !Frame_receiveByte(&link_p->frame, rxByte, message_p)) {
+      continue;
+    }
+
+    if (message_p->type == LINK_MSG_ACK) {
+      Link_handleAck(link_p, message_p->seq);
+      continue;
+    }
+    if (message_p->type == LINK_MSG_SYNC) {
+      Link_handleSync(link_p);
+      continue;
+    }
+    if (message_p->type == LINK_MSG_SYNC_ACK) {
+      link_p->syncing = false;
+      continue;
+    }
+
+    Frame_send(link_p->uart_p, LINK_MSG_ACK, message_p->seq, NULL, 0);
+    if (message_p->seq != link_p->rxSeq) {
+      link_p->duplicates++;
+      continue;
+    }
+
+    link_p->rxSeq++;
+    link_p->messagesReceived++;
+    return true;
+  }
+
+  return false;
+}
+
+/**
+ * Sends the session start or the message in flight again if it was not
+ * acknowledged in time. The session start is sent for as long as the peer
+ * does not answer, while the peer is considered gone after LINK_MAX_RETRIES
+ * attempts at a message.
+ *
+ * @param link_p:   The link to refresh
+ */
+void Link_refresh(Link* link_p) {
+  if (link_p->syncing) {
+    if (SWTimer_expired(&link_p->retransmitTimer)) {
+      Frame_send(link_p->uart_p, LINK_MSG_SYNC, 0, NULL, 0);
+      SWTimer_start(&link_p->retransmitTimer);
+    }
+    return;
+  }
+
+  if (!link_p->awaitingAck || link_p->lost ||
+      !SWTimer_expired(&link_p->retransmitTimer)) {
+    return;
+  }
+
+  if (link_p->retries == LINK_MAX_RETRIES) {
+    link_p->awaitingAck = false;
+    link_p->lost = true;
+    return;
+  }
+
+  Frame_send(link_p->uart_p, link_p->txType, link_p->txSeq,
+             link_p->txPayload, link_p->txLength);
+  SWTimer_start(&link_p->retransmitTimer);
+  link_p->retries++;
+  link_p->retransmissions++;
+  METRIC_COUNT(METRIC_LINK_RETRANSMISSIONS);
+}
+
+/**
+ * Determines whether the peer stopped acknowledging messages.
+ *
+ * @param link_p:   The link to check
+ *
+ * @return true if the last message was not acknowledged after every retry
+ */
+bool Link_isLost(Link* link_p) { return link_p->lost; }
+
+/**
+ * A getter for the round-trip time of the last acknowledged message, from
+ * its first transmission to the acknowledgement.
+ *
+ * @param link_p:   The link to check
+ *
+ * @return the round-trip time in microseconds
+ */
+uint32_t Link_lastRoundTripUS(Link* link_p) { return link_p->lastRoundTripUS; }
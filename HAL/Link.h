@@ -0,0 +1,119 @@
+/*
+ * Link.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef HAL_LINK_H_
+#define HAL_LINK_H_
+
+#include <HAL/Frame.h>
+#include <HAL/Timer.h>
+#include <HAL/UART.h>
+
+// UART connecting this board to the other board of a linked game. This is the
+// same EUSCI_A3 port as seat 4, so seat links and board links exclude each
+// other. Cross TX and RX between the boards and connect their grounds.
+#define LINK_UART_INSTANCE EUSCI_A3_BASE
+#define LINK_UART_PORT GPIO_PORT_P9
+#define LINK_UART_PINS (GPIO_PIN6 | GPIO_PIN7)
+
+// Largest payload of a message exchanged between the boards
+#define LINK_MAX_PAYLOAD 16
+
+// Time after which an unacknowledged message is sent again, and the number of
+// attempts after which the peer is considered gone. Together they bound the
+// time a message can take to get across.
+#define LINK_RETRANSMIT_TIME_MS 20
+#define LINK_MAX_RETRIES 10
+
+// Frame type acknowledging the message with the same sequence number
+#define LINK_MSG_ACK 0x7F
+
+// Frame types starting a new session and acknowledging the start. The
+// sequence number of a session start is not used.
+#define LINK_MSG_SYNC 0x7E
+#define LINK_MSG_SYNC_ACK 0x7D
+
+/**=============================================================================
+ * A reliable, in-order message link to another board over a UART. Messages are
+ * sent as frames (see HAL/Frame.h) carrying a sequence number. The link is
+ * stop-and-wait: only one message is in flight at a time, and it is sent again
+ * every LINK_RETRANSMIT_TIME_MS until the peer acknowledges it. A message which
+ * arrives twice, because its acknowledgement was lost, is acknowledged again
+ * but only delivered once. A session starts with a SYNC frame, which is sent
+ * again every LINK_RETRANSMIT_TIME_MS until the peer answers it with a
+ * SYNC_ACK; both boards then number their messages from 0 in each direction.
+ * Either board can start a new session, such as after a reset or when the
+ * link was lost, and the peer follows it. The UART keeps frames in order, so
+ * every copy of a SYNC arrives before the first message of its session.
+ * =============================================================================
+ * USAGE WARNINGS
+ * =============================================================================
+ * Treat all members as PRIVATE. [Link_refresh()] must be called every loop for
+ * retransmissions to happen. Once [Link_isLost()] returns true no more
+ * messages are sent until [Link_reset()] is called. A message in flight when
+ * the peer starts a new session is sent again in that session, so the peer
+ * may receive it twice across sessions.
+ */
+struct _Link {
+  UART* uart_p;
+  Frame frame;
+
+  // Sequence number of the next message to send and to deliver
+  uint8_t txSeq;
+  uint8_t rxSeq;
+
+  // Flag indicating a new session was started and the peer did not answer yet
+  bool syncing;
+
+  // The message in flight, kept for retransmission
+  bool awaitingAck;
+  uint8_t txType;
+  uint8_t txPayload[LINK_MAX_PAYLOAD];
+  uint16_t txLength;
+  int retries;
+  bool lost;
+  SWTimer retransmitTimer;
+
+  // Time from first sending the message in flight to its acknowledgement
+  SWTimer roundTripTimer;
+  uint32_t lastRoundTripUS;
+  uint32_t maxRoundTripUS;
+
+  // Statistics of the link
+  uint32_t messagesSent;
+  uint32_t messagesReceived;
+  uint32_t retransmissions;
+  uint32_t duplicates;
+};
+typedef struct _Link Link;
+
+// Constructs a link over an already enabled UART
+Link Link_construct(UART* uart_p);
+
+// Starts a new session with no message in flight
+void Link_reset(Link* link_p);
+
+// Returns true if a new message can be sent, once the session is started
+bool Link_canSend(Link* link_p);
+
+// Sends a message. Returns false if another message is still in flight.
+bool Link_send(Link* link_p, uint8_t type, const uint8_t* payload,
+               uint16_t length);
+
+// Handles all received bytes. Returns true when a new message from the peer
+// was received, which is then stored in message_p.
+bool Link_receive(Link* link_p, FrameMessage* message_p);
+
+// Retransmits the session start or the message in flight when its
+// acknowledgement is overdue
+void Link_refresh(Link* link_p);
+
+// Returns true if the peer stopped acknowledging messages
+bool Link_isLost(Link* link_p);
+
+// Returns the round-trip time of the last acknowledged message
+uint32_t Link_lastRoundTripUS(Link* link_p);
+
+#endif /* HAL_LINK_H_ */
@@ -0,0 +1,100 @@
+/*
+ * Metrics.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <HAL/Metrics.h>
+
+// The lowest address of the stack, from the linker
+#if defined(__TI_ARM__)
+extern uint32_t __stack;
+#define STACK_BOTTOM (&__stack)
+#else
+extern uint32_t __StackLimit;
+#define STACK_BOTTOM (&__StackLimit)
+#endif
+
+// Bytes below the stack pointer left alone while painting, for the frames of
+// the painting itself
+#define STACK_PAINT_MARGIN 64
+
+volatile uint32_t Metrics_counters[NUM_METRICS];
+
+/** The loops counted at the start of the current period, and the gauge of
+ * the last complete period */
+static uint32_t periodLoops = 0;
+static uint32_t loopRate = 0;
+
+static SWTimer periodTimer;
+static bool periodStarted = false;
+
+/**
+ * Fills the part of the stack which is not in use yet with a known word. How
+ * much of it is still intact later tells how deep the stack ever grew.
+ */
+void Metrics_paintStack(void) {
+  uint32_t* word_p = STACK_BOTTOM;
+  uint32_t* end_p =
+      (uint32_t*)(uintptr_t)((__get_MSP() - STACK_PAINT_MARGIN) & ~3u);
+
+  while (word_p < end_p) {
+    *word_p++ = METRICS_STACK_PAINT;
+  }
+}
+
+/**
+ * Counts a pass of the main loop. Once every METRICS_PERIOD_MS, the loops of
+ * the period become the loop rate gauge.
+ */
+void Metrics_refresh(void) {
+  METRIC_COUNT(METRIC_LOOPS);
+
+  if (!periodStarted) {
+    periodTimer = SWTimer_construct(METRICS_PERIOD_MS);
+    SWTimer_start(&periodTimer);
+    periodStarted = true;
+  } else if (SWTimer_expired(&periodTimer)) {
+    loopRate = Metrics_counters[METRIC_LOOPS] - periodLoops;
+    periodLoops = Metrics_counters[METRIC_LOOPS];
+    SWTimer_start(&periodTimer);
+  }
+}
+
+/**
+ * Finds how many bytes at the bottom of the stack still hold the paint.
+ *
+ * @return the bytes of stack never used since Metrics_paintStack()
+ */
+static uint32_t Metrics_freeStack(void) {
+  uint32_t* word_p = STACK_BOTTOM;
+
+  while (*word_p == METRICS_STACK_PAINT) {
+    word_p++;
+  }
+
+  return (uint32_t)(word_p - STACK_BOTTOM) * sizeof(uint32_t);
+}
+
+/**
+ * Takes a snapshot of the registry. The counters are copied with interrupts
+ * disabled, so that the ones counted in interrupt handlers are consistent
+ * with the others.
+ *
+ * @param values_p:   Receives NUM_METRICS counters, then NUM_GAUGES gauges
+ */
+void Metrics_snapshot(uint32_t* values_p) {
+  bool enabled = !Interrupt_disableMaster();
+  int i;
+
+  for (i = 0; i < NUM_METRICS; i++) {
+    values_p[i] = Metrics_counters[i];
+  }
+
+  if (enabled) {
+    Interrupt_enableMaster();
+  }
+
+  values_p[NUM_METRICS + GAUGE_LOOP_RATE] = loopRate;
+  values_p[NUM_METRICS + GAUGE_FREE_STACK] = Metrics_freeStack();
+}
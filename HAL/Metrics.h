@@ -0,0 +1,72 @@
+/*
+ * Metrics.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef HAL_METRICS_H_
+#define HAL_METRICS_H_
+
+#include <HAL/Timer.h>
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+// Period over which the loop rate is measured
+#define METRICS_PERIOD_MS 1000
+
+// Word the unused stack is filled with, to find how deep it was ever used
+#define METRICS_STACK_PAINT 0xA5A5A5A5
+
+/**
+ * The counters, which only ever grow. tools/metrics.py names them in the same
+ * order.
+ */
+typedef enum {
+  METRIC_ROUNDS,          // Rounds played, by people or machine clients
+  METRIC_INVALID_INPUTS,  // Invalid moves answered by invalid_input()
+  METRIC_RX_DROPPED,      // Bytes dropped because a UART receive buffer was full
+  METRIC_REDRAWS,         // Display lists drawn or updated
+  METRIC_SPI_BYTES,       // Bytes sent to the LCD
+  METRIC_LOOPS,           // Passes of the main loop
+  METRIC_LINK_ACKS,       // Messages to a linked board it acknowledged
+  METRIC_LINK_ROUND_TRIP_US,  // Sum of the round-trip times of those messages
+  METRIC_LINK_RETRANSMISSIONS,  // Messages to a linked board sent again
+  NUM_METRICS
+} Metric;
+
+/**
+ * The gauges, which are measured anew.
+ */
+typedef enum {
+  GAUGE_LOOP_RATE,   // Loops in the last METRICS_PERIOD_MS
+  GAUGE_FREE_STACK,  // Bytes of stack never used since reset
+  NUM_GAUGES
+} Gauge;
+
+/**=============================================================================
+ * A registry of named counters and gauges. A counter is a word in a global
+ * array, which the METRIC_* macros increment in place: one load, add and
+ * store, with no lock. Every counter is only updated from one context, either
+ * the main loop or one interrupt handler, so no update is lost.
+ * =============================================================================
+ * USAGE WARNINGS
+ * =============================================================================
+ * A counter must not be updated from both the main loop and an interrupt
+ * handler. Call [Metrics_paintStack()] as early as possible after reset, and
+ * [Metrics_refresh()] once per loop.
+ */
+
+extern volatile uint32_t Metrics_counters[NUM_METRICS];
+
+#define METRIC_COUNT(metric) (Metrics_counters[metric]++)
+#define METRIC_ADD(metric, n) (Metrics_counters[metric] += (n))
+
+// Fills the stack below the current stack pointer with METRICS_STACK_PAINT
+void Metrics_paintStack(void);
+
+// Counts a loop and measures the loop rate
+void Metrics_refresh(void);
+
+// Copies all counters and then all gauges, in order, into values_p
+void Metrics_snapshot(uint32_t* values_p);
+
+#endif /* HAL_METRICS_H_ */
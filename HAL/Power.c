@@ -0,0 +1,183 @@
+/*
+ * Power.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <HAL/Clock.h>
+#include <HAL/Power.h>
+#include <HAL/RamFunc.h>
+#include <HAL/Timer.h>
+
+/** The time spent in each power mode, in microseconds */
+static uint64_t modeTimeUS[NUM_POWER_MODES];
+
+/** Started whenever time was last accounted. Never started, it counts from
+ * the start of the program. */
+static SWTimer accountTimer;
+
+// RT0PS divides BCLK by up to 2^8, and RT1PS the result by up to 2^8 again
+#define POWER_RT0PS_SHIFTS 8
+#define POWER_MAX_SHIFT 16
+
+// RT1PS counts of a second of the calendar
+#define POWER_RT1PS_SECOND 128
+
+// Ticks of BCLK in a minute of the calendar, over which sleeps are measured
+#define POWER_RTC_MINUTE_TICKS (60 * POWER_RTC_HZ)
+
+static uint32_t sleeps = 0;
+
+/** Prescale event dividers, the interval of the n-th being 2^(n+1) counts */
+static const uint_fast8_t eventDividers[POWER_RT0PS_SHIFTS] = {
+    RTC_C_PSEVENTDIVIDER_2,  RTC_C_PSEVENTDIVIDER_4,  RTC_C_PSEVENTDIVIDER_8,
+    RTC_C_PSEVENTDIVIDER_16, RTC_C_PSEVENTDIVIDER_32, RTC_C_PSEVENTDIVIDER_64,
+    RTC_C_PSEVENTDIVIDER_128, RTC_C_PSEVENTDIVIDER_256};
+
+/**
+ * The ISR of RTC_C's interval interrupts. The sleep is already over when it
+ * runs, so it only clears the flags. DO NOT DIRECTLY INVOKE THIS FUNCTION.
+ */
+RAMFUNC void RTC_C_IRQHandler() {
+  RTC_C_clearInterruptFlag(RTC_C_PRESCALE_TIMER0_INTERRUPT |
+                           RTC_C_PRESCALE_TIMER1_INTERRUPT);
+}
+
+/**
+ * Starts RTC_C, which ends and measures every sleep. BCLK is taken from REFO,
+ * as the LFXT crystal is never started.
+ */
+void Power_init(void) {
+  CS_initClockSignal(CS_BCLK, CS_REFOCLK_SELECT, CS_CLOCK_DIVIDER_1);
+  RTC_C_startClock();
+  Interrupt_enableInterrupt(INT_RTC_C);
+}
+
+/**
+ * Reads the time of RTC_C within the current minute. RT1PS changes whenever
+ * RT0PS wraps and whenever a second passes, so a read during which it stayed
+ * the same is consistent.
+ *
+ * @return the time in ticks of BCLK
+ */
+static uint32_t Power_rtcTicks(void) {
+  uint_fast8_t rt1ps, rt0ps;
+  RTC_C_Calendar calendar;
+
+  do {
+    rt1ps = RTC_C_getPrescaleValue(RTC_C_PRESCALE_1);
+    calendar = RTC_C_getCalendarTime();
+    rt0ps = RTC_C_getPrescaleValue(RTC_C_PRESCALE_0);
+  } while (rt1ps != RTC_C_getPrescaleValue(RTC_C_PRESCALE_1));
+
+  return calendar.seconds * POWER_RTC_HZ +
+         (rt1ps % POWER_RT1PS_SECOND) * (1 << POWER_RT0PS_SHIFTS) + rt0ps;
+}
+
+/**
+ * Arms the interval interrupt of RTC_C which fits a sleep best: the longest
+ * interval, a power of two ticks of BCLK, which is not longer than the sleep.
+ * Intervals up to 2^8 ticks come from RT0PS, longer ones from RT1PS.
+ *
+ * @param ticks:  The longest time to sleep, in ticks of BCLK
+ *
+ * @return the interrupt which was armed
+ */
+static uint_fast8_t Power_armWake(uint32_t ticks) {
+  int shift = 1;
+
+  while (shift < POWER_MAX_SHIFT && (2u << shift) <= ticks) {
+    shift++;
+  }
+
+  if (shift <= POWER_RT0PS_SHIFTS) {
+    RTC_C_definePrescaleEvent(RTC_C_PRESCALE_0, eventDividers[shift - 1]);
+    return RTC_C_PRESCALE_TIMER0_INTERRUPT;
+  }
+  RTC_C_definePrescaleEvent(RTC_C_PRESCALE_1,
+                            eventDividers[shift - POWER_RT0PS_SHIFTS - 1]);
+  return RTC_C_PRESCALE_TIMER1_INTERRUPT;
+}
+
+/**
+ * Adds the time since time was last accounted to a power mode.
+ *
+ * @param mode:   The mode the program was in since then
+ */
+static void Power_accountTo(PowerMode mode) {
+  modeTimeUS[mode] += SWTimer_elapsedTimeUS(&accountTimer);
+  SWTimer_start(&accountTimer);
+}
+
+/**
+ * Accounts the active time since time was last accounted to the current clock
+ * speed.
+ */
+void Power_account(void) {
+  Power_accountTo(Clock_speed() == CLOCK_FAST ? POWER_ACTIVE_FAST
+                                              : POWER_ACTIVE_SLOW);
+}
+
+/**
+ * Sleeps in LPM0 or LPM3. The sleep ends at the latest after sleep_ms, or
+ * earlier on any enabled interrupt. A sleep longer than the longest interval
+ * of RTC_C, 2 s, is cut short, and the caller sleeps again. Interrupts must be disabled when this is called, so that
+ * the caller can check for pending work without an interrupt slipping in
+ * before the sleep; an interrupt which is already pending ends the sleep at
+ * once. Interrupts are enabled again on return, and the pending ones run.
+ *
+ * @param mode:       POWER_LPM0 or POWER_LPM3
+ * @param sleep_ms:   The longest time to sleep, at most POWER_MAX_SLEEP_MS
+ * @param wake:       Run right after the wake-up, or NULL
+ */
+void Power_sleep(PowerMode mode, uint32_t sleep_ms, PowerWakeFunction wake) {
+  uint_fast8_t interrupt =
+      Power_armWake(sleep_ms * POWER_RTC_HZ / MS_DIVISION_FACTOR);
+
+  // Timer32 keeps counting in LPM0, so only LPM3 sleeps are measured. The
+  // UARTs still receive in LPM0, and their interrupts must not wait long.
+  Power_account();
+  uint32_t start = mode == POWER_LPM3 ? Power_rtcTicks() : 0;
+
+  RTC_C_clearInterruptFlag(interrupt);
+  RTC_C_enableInterrupt(interrupt);
+
+  bool slept = mode == POWER_LPM3 ? PCM_gotoLPM3() : PCM_gotoLPM0();
+
+  // Before anything else, as RTC_C measures the sleep on its own
+  if (wake != NULL) {
+    wake();
+  }
+
+  RTC_C_disableInterrupt(interrupt);
+  RTC_C_clearInterruptFlag(interrupt);
+
+  if (slept && mode == POWER_LPM3) {
+    uint32_t elapsed = (Power_rtcTicks() + POWER_RTC_MINUTE_TICKS - start) %
+                       POWER_RTC_MINUTE_TICKS;
+    Timer_addStoppedCycles((uint64_t)elapsed * SYSTEM_CLOCK / POWER_RTC_HZ);
+  }
+
+  if (slept) {
+    Power_accountTo(mode);
+    sleeps++;
+  } else {
+    Power_account();
+  }
+
+  Interrupt_enableMaster();
+}
+
+/**
+ * Returns the time spent in a power mode. Active time is only accounted up to
+ * the last sleep or clock switch.
+ *
+ * @param mode:   The power mode
+ *
+ * @return the time in milliseconds
+ */
+uint32_t Power_timeMS(PowerMode mode) {
+  return (uint32_t)(modeTimeUS[mode] / MS_DIVISION_FACTOR);
+}
+
+uint32_t Power_sleeps(void) { return sleeps; }
@@ -0,0 +1,70 @@
+/*
+ * Power.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef HAL_POWER_H_
+#define HAL_POWER_H_
+
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+// The modes the time of the program is accounted to. Active time is split by
+// clock speed (see Clock.h).
+typedef enum {
+  POWER_ACTIVE_FAST,
+  POWER_ACTIVE_SLOW,
+  POWER_LPM0,  // CPU off, all clocks and peripherals running
+  POWER_LPM3,  // Only BCLK, RTC_C and WDT_A running; all timers but RTC_C off
+  NUM_POWER_MODES
+} PowerMode;
+
+// Frequency of BCLK (REFO), which RTC_C counts in every power mode
+#define POWER_RTC_HZ 32768
+
+// Longest sleep, which must stay well below the minute of the calendar over
+// which RTC_C measures a sleep
+#define POWER_MAX_SLEEP_MS 15000
+
+/**=============================================================================
+ * Low power sleep with a scheduled wake-up, and accounting of the time spent
+ * in every power mode. RTC_C is the only timer which runs in LPM3, so it both
+ * ends and measures every sleep. [Power_sleep()] arms an interval interrupt
+ * of one of its prescale timers, the longest which fits in the given time;
+ * the intervals run freely, so the sleep may end sooner, and any other
+ * enabled interrupt ends it earlier too. Timer32 stops in LPM3, so after an
+ * LPM3 sleep the software timers are moved on by the time RTC_C measured, and
+ * keep their deadlines.
+ * =============================================================================
+ * USAGE WARNINGS
+ * =============================================================================
+ * The wake-up sources other than the timer, such as button and RX pin
+ * interrupts, are set up by the caller. HAL_sleep() does this; use it rather
+ * than calling [Power_sleep()] directly. Only GPIO interrupts and RTC_C can
+ * end LPM3: the UARTs are clocked from SMCLK, which is off. Call
+ * [Power_init()] once before the first sleep.
+ */
+
+// Work which must follow the end of a sleep at once, such as giving a wake-up
+// pin back to its peripheral before the next character on it starts
+typedef void (*PowerWakeFunction)(void);
+
+// Starts RTC_C on BCLK
+void Power_init(void);
+
+// Sleeps in LPM0 or LPM3 until an interrupt or for at most sleep_ms. Must be
+// called with interrupts disabled; they are enabled again on return. wake, if
+// not NULL, runs as soon as the CPU wakes up, before the time is accounted.
+void Power_sleep(PowerMode mode, uint32_t sleep_ms, PowerWakeFunction wake);
+
+// Accounts the active time since the last call to the current clock speed.
+// Call it before every clock speed switch.
+void Power_account(void);
+
+// Returns the time spent in a power mode so far, in milliseconds
+uint32_t Power_timeMS(PowerMode mode);
+
+// Returns the number of sleeps so far
+uint32_t Power_sleeps(void);
+
+#endif /* HAL_POWER_H_ */
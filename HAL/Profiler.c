@@ -0,0 +1,128 @@
+/*
+ * Profiler.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <HAL/Profiler.h>
+#include <HAL/RamFunc.h>
+#include <HAL/Timer.h>
+#include <string.h>
+
+/** The hash table of sampled places, keyed by PC and LR */
+static ProfilerSlot slots[PROFILER_SLOTS];
+
+/** Samples taken and samples which found no free slot */
+static volatile uint32_t samples = 0;
+static volatile uint32_t dropped = 0;
+
+static bool running = false;
+
+/**
+ * Counts one sample. Called from SysTick_Handler with the PC and LR the
+ * interrupted code had, which the processor stacked on exception entry. It
+ * is not static only so that the handler below can branch to it.
+ *
+ * @param pc:   The interrupted program counter
+ * @param lr:   The link register at the time of the interrupt
+ */
+RAMFUNC void Profiler_sample(uint32_t pc, uint32_t lr) {
+  uint32_t index = ((pc ^ (lr << 3)) * 2654435761u) >> 16;
+  int probe;
+
+  samples++;
+  for (probe = 0; probe < PROFILER_MAX_PROBES; probe++) {
+    ProfilerSlot* slot_p = &slots[(index + probe) & (PROFILER_SLOTS - 1)];
+
+    if (slot_p->count == 0) {
+      slot_p->pc = pc;
+      slot_p->lr = lr;
+      slot_p->count = 1;
+      return;
+    }
+    if (slot_p->pc == pc && slot_p->lr == lr) {
+      slot_p->count++;
+      return;
+    }
+  }
+  dropped++;
+}
+
+/**
+ * The SysTick ISR. The stacked exception frame holds r0-r3, r12, LR, PC and
+ * xPSR, on the main or the process stack as bit 2 of EXC_RETURN tells. The
+ * handler passes the stacked PC and LR to Profiler_sample(), which returns
+ * from the exception itself. DO NOT DIRECTLY INVOKE THIS FUNCTION. The host
+ * simulator has its own, as it has no exception frame.
+ */
+#if defined(__TI_COMPILER_VERSION__)
+__asm(
+    "    .thumb\n"
+    "    .sect \".text:SysTick_Handler\"\n"
+    "    .global SysTick_Handler\n"
+    "    .global Profiler_sample\n"
+    "    .thumbfunc SysTick_Handler\n"
+    "SysTick_Handler: .asmfunc\n"
+    "    tst lr, #4\n"
+    "    ite eq\n"
+    "    mrseq r0, msp\n"
+    "    mrsne r0, psp\n"
+    "    ldr r1, [r0, #20]\n"
+    "    ldr r0, [r0, #24]\n"
+    "    b Profiler_sample\n"
+    "    .endasmfunc\n");
+#elif defined(__GNUC__) && defined(__arm__)
+void __attribute__((naked)) SysTick_Handler(void) {
+  __asm(
+      "    tst lr, #4\n"
+      "    ite eq\n"
+      "    mrseq r0, msp\n"
+      "    mrsne r0, psp\n"
+      "    ldr r1, [r0, #20]\n"
+      "    ldr r0, [r0, #24]\n"
+      "    b Profiler_sample\n");
+}
+#endif
+
+/**
+ * Clears all counts and starts sampling at PROFILER_RATE_HZ.
+ */
+void Profiler_start(void) {
+  SysTick_disableModule();
+
+  memset(slots, 0, sizeof(slots));
+  samples = 0;
+  dropped = 0;
+
+  SysTick_setPeriod(SYSTEM_CLOCK / PROFILER_RATE_HZ);
+  SysTick_enableInterrupt();
+  SysTick_enableModule();
+  running = true;
+}
+
+/**
+ * Stops sampling. The counts stay readable until the next start.
+ */
+void Profiler_stop(void) {
+  SysTick_disableInterrupt();
+  SysTick_disableModule();
+  running = false;
+}
+
+/**
+ * Returns whether the profiler is sampling.
+ *
+ * @return true between Profiler_start() and Profiler_stop()
+ */
+bool Profiler_isRunning(void) { return running; }
+
+/**
+ * Returns the hash table of samples. Read it while the profiler is stopped.
+ *
+ * @return the PROFILER_SLOTS slots, unused ones with a count of 0
+ */
+const ProfilerSlot* Profiler_slots(void) { return slots; }
+
+uint32_t Profiler_samples(void) { return samples; }
+
+uint32_t Profiler_dropped(void) { return dropped; }
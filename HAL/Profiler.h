@@ -0,0 +1,62 @@
+/*
+ * Profiler.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef HAL_PROFILER_H_
+#define HAL_PROFILER_H_
+
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+// Samples taken per second while the profiler runs
+#define PROFILER_RATE_HZ 1000
+
+// Distinct (PC, LR) pairs the profiler can count, a power of two
+#define PROFILER_SLOTS 256
+
+// Slots tried for a pair before its sample is dropped
+#define PROFILER_MAX_PROBES 8
+
+/**
+ * The samples of one place in the program: the interrupted PC and the LR at
+ * that moment, which is the return address into the caller unless the
+ * interrupted function already reused LR.
+ */
+struct _ProfilerSlot {
+  uint32_t pc;
+  uint32_t lr;
+  uint32_t count;
+};
+typedef struct _ProfilerSlot ProfilerSlot;
+
+/**=============================================================================
+ * A statistical profiler. While it runs, the SysTick interrupt fires
+ * PROFILER_RATE_HZ times a second and counts the interrupted PC and LR in a
+ * hash table of PROFILER_SLOTS slots. The counts are read out with
+ * [Profiler_slots()] and symbolised on a host by tools/profiler.py.
+ * =============================================================================
+ * USAGE WARNINGS
+ * =============================================================================
+ * The profiler owns SysTick while it runs. When it is stopped SysTick is off,
+ * so the profiler costs nothing.
+ */
+
+// Clears the counts and starts sampling
+void Profiler_start(void);
+
+// Stops sampling, keeping the counts
+void Profiler_stop(void);
+
+// Returns true while the profiler samples
+bool Profiler_isRunning(void);
+
+// Returns the PROFILER_SLOTS slots; unused slots have a count of 0
+const ProfilerSlot* Profiler_slots(void);
+
+// Returns the number of samples taken and the number dropped because their
+// slots were taken
+uint32_t Profiler_samples(void);
+uint32_t Profiler_dropped(void);
+
+#endif /* HAL_PROFILER_H_ */
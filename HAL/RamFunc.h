@@ -0,0 +1,27 @@
+/*
+ * RamFunc.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef HAL_RAMFUNC_H_
+#define HAL_RAMFUNC_H_
+
+// Marks a function which runs from SRAM. At 48 MHz the flash needs two wait
+// states per fetch, while SRAM has none, so the interrupt handlers and the
+// loops which send every pixel to the LCD are placed in the .TI.ramfunc
+// section. msp432p401r.cmd loads that section into flash and has the boot
+// code copy it to SRAM_CODE before main() runs.
+//
+// The section is budgeted at RAMFUNC_BUDGET bytes of SRAM, which
+// tools/ramfunc_report.py checks against the linker map file. Functions called
+// from a RAMFUNC function, such as those of driverlib, still run from flash.
+#define RAMFUNC_BUDGET 2048
+
+#if defined(__TI_COMPILER_VERSION__) && __TI_COMPILER_VERSION__ >= 15009000
+#define RAMFUNC __attribute__((ramfunc))
+#else
+#define RAMFUNC
+#endif
+
+#endif /* HAL_RAMFUNC_H_ */
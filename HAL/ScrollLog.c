@@ -0,0 +1,95 @@
+/*
+ * ScrollLog.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <HAL/ScrollLog.h>
+#include <string.h>
+
+/**
+ * Constructs a log. Nothing is drawn until the log is started.
+ *
+ * @param top:      The first screen row of the band
+ * @param lines:    The number of lines the band holds
+ *
+ * @return the constructed log
+ */
+ScrollLog ScrollLog_construct(uint16_t top, uint16_t lines) {
+  ScrollLog log;
+
+  log.top = top;
+  log.lines = lines;
+  log.count = 0;
+
+  return log;
+}
+
+/**
+ * Clears the band and sets it up as the hardware scroll area, unscrolled.
+ *
+ * @param log_p:        The log to start
+ * @param context_p:    The graphics context the log is drawn with
+ */
+void ScrollLog_start(ScrollLog* log_p, Graphics_Context* context_p) {
+  Graphics_Rectangle band;
+
+  band.xMin = 0;
+  band.xMax = LCD_HORIZONTAL_MAX - 1;
+  band.yMin = log_p->top;
+  band.yMax = log_p->top + log_p->lines * SCROLL_LOG_LINE_HEIGHT - 1;
+
+  Graphics_setForegroundColor(context_p, GRAPHICS_COLOR_BLACK);
+  Graphics_fillRectangle(context_p, &band);
+  Graphics_setForegroundColor(context_p, GRAPHICS_COLOR_WHITE);
+
+  Crystalfontz128x128_SetScrollArea(log_p->top,
+                                    log_p->lines * SCROLL_LOG_LINE_HEIGHT);
+  Crystalfontz128x128_SetScrollStart(log_p->top);
+  log_p->count = 0;
+}
+
+/**
+ * Adds a line to the log. The line is drawn over the oldest line of the ring,
+ * padded to the full width so nothing of the old line is left, and once the
+ * band is full the band is scrolled so that the new line is at its bottom.
+ *
+ * @param log_p:        The log to add to
+ * @param context_p:    The graphics context the log is drawn with
+ * @param text:         The line, cut to SCROLL_LOG_LINE_LENGTH characters
+ */
+void ScrollLog_addLine(ScrollLog* log_p, Graphics_Context* context_p,
+                       const char* text) {
+  char line[SCROLL_LOG_LINE_LENGTH + 1];
+  uint16_t slot = log_p->count % log_p->lines;
+  size_t length = strlen(text);
+
+  if (length > SCROLL_LOG_LINE_LENGTH) {
+    length = SCROLL_LOG_LINE_LENGTH;
+  }
+  memcpy(line, text, length);
+  memset(line + length, ' ', SCROLL_LOG_LINE_LENGTH - length);
+  line[SCROLL_LOG_LINE_LENGTH] = '\0';
+
+  Graphics_drawString(context_p, (int8_t*)line, -1, 0,
+                      log_p->top + slot * SCROLL_LOG_LINE_HEIGHT, true);
+  log_p->count++;
+
+  // The oldest line left is the one after the new line in the ring. The line
+  // must reach the panel before the band scrolls to show it.
+  if (log_p->count >= log_p->lines) {
+    Graphics_flushBuffer(context_p);
+    Crystalfontz128x128_SetScrollStart(
+        log_p->top + (log_p->count % log_p->lines) * SCROLL_LOG_LINE_HEIGHT);
+  }
+}
+
+/**
+ * Shows the band unscrolled, so that the screen rows and the panel rows match
+ * again for whatever is drawn next.
+ *
+ * @param log_p:    The log to stop
+ */
+void ScrollLog_stop(ScrollLog* log_p) {
+  Crystalfontz128x128_SetScrollStart(log_p->top);
+}
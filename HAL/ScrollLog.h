@@ -0,0 +1,56 @@
+/*
+ * ScrollLog.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef HAL_SCROLLLOG_H_
+#define HAL_SCROLLLOG_H_
+
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+#include <ti/grlib/grlib.h>
+#include "LcdDriver/Crystalfontz128x128_ST7735.h"
+
+// Height of one line of the log, matching the fixed 6x8 font
+#define SCROLL_LOG_LINE_HEIGHT 8
+
+// Characters of a log line which fit on the panel
+#define SCROLL_LOG_LINE_LENGTH (LCD_HORIZONTAL_MAX / 6)
+
+/**=============================================================================
+ * A text log in a band of the LCD which scrolls in hardware. Lines are written
+ * into a ring of rows: while the band has room a line goes below the previous
+ * one, and once it is full the oldest line is overwritten and the band is
+ * scrolled by one line with a single scroll command. Adding a line therefore
+ * costs one line of pixels, however many lines are shown.
+ * =============================================================================
+ * USAGE WARNINGS
+ * =============================================================================
+ * Treat all members as PRIVATE. While a log is running the band is shown
+ * scrolled, so [ScrollLog_stop()] must be called before anything else is
+ * drawn in the band, such as a new screen.
+ */
+struct _ScrollLog {
+  // Screen rows of the band and the number of lines it holds
+  uint16_t top;
+  uint16_t lines;
+
+  // Lines written since the log started
+  uint32_t count;
+};
+typedef struct _ScrollLog ScrollLog;
+
+// Constructs a log in a band of lines starting at a screen row
+ScrollLog ScrollLog_construct(uint16_t top, uint16_t lines);
+
+// Clears the band and starts an empty log in it
+void ScrollLog_start(ScrollLog* log_p, Graphics_Context* context_p);
+
+// Adds a line at the bottom of the log
+void ScrollLog_addLine(ScrollLog* log_p, Graphics_Context* context_p,
+                       const char* text);
+
+// Shows the band unscrolled again
+void ScrollLog_stop(ScrollLog* log_p);
+
+#endif /* HAL_SCROLLLOG_H_ */
@@ -0,0 +1,30 @@
+/*
+ * Sprite.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <HAL/LcdDriver/Crystalfontz128x128_ST7735.h>
+#include <HAL/Sprite.h>
+
+/**
+ * Draws a sprite. The window of the whole sprite is set once and the runs are
+ * decoded straight into a single RAMWR, so the LCD receives nothing but pixel
+ * data after the window is set. With the offscreen framebuffer, the runs go
+ * into the framebuffer instead. The sprite must lie within the screen.
+ *
+ * @param sprite_p: The sprite to draw
+ * @param x:        The screen column of the sprite's left edge
+ * @param y:        The screen row of the sprite's top edge
+ */
+void Sprite_draw(const Sprite* sprite_p, uint16_t x, uint16_t y) {
+  const SpriteRun* run_p = sprite_p->runs;
+  const SpriteRun* end_p = run_p + sprite_p->runCount;
+
+  Crystalfontz128x128_BeginPixels(x, y, x + sprite_p->width - 1,
+                                  y + sprite_p->height - 1);
+
+  for (; run_p != end_p; run_p++) {
+    Crystalfontz128x128_WritePixels(run_p->color, run_p->length);
+  }
+}
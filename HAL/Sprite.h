@@ -0,0 +1,40 @@
+/*
+ * Sprite.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef HAL_SPRITE_H_
+#define HAL_SPRITE_H_
+
+#include <stdint.h>
+
+/**
+ * A run of pixels of the same RGB565 colour, in the colour format of the LCD
+ * driver's ColorTranslate function.
+ */
+struct _SpriteRun {
+  uint16_t length;
+  uint16_t color;
+};
+typedef struct _SpriteRun SpriteRun;
+
+/**=============================================================================
+ * A run-length encoded bitmap. The runs cover the pixels row by row, top to
+ * bottom and left to right, and a run may continue from one row into the
+ * next. Sprites are generated as const data by tools/encode_sprite.py, so they
+ * stay in flash.
+ * =============================================================================
+ */
+struct _Sprite {
+  uint8_t width;
+  uint8_t height;
+  const SpriteRun* runs;
+  uint16_t runCount;
+};
+typedef struct _Sprite Sprite;
+
+// Draws a sprite with its top left corner at a screen position
+void Sprite_draw(const Sprite* sprite_p, uint16_t x, uint16_t y);
+
+#endif /* HAL_SPRITE_H_ */
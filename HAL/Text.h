@@ -0,0 +1,36 @@
+/*
+ * Text.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef HAL_TEXT_H_
+#define HAL_TEXT_H_
+
+#include <ti/grlib/grlib.h>
+
+// Size of a character cell of the font, in pixels
+#define TEXT_FONT_WIDTH 6
+#define TEXT_FONT_HEIGHT 8
+
+// Characters of the font; all others are drawn as a space
+#define TEXT_FIRST_CHAR ' '
+#define TEXT_LAST_CHAR '~'
+
+/**=============================================================================
+ * Text drawn straight into a window of the LCD, with the classic 5x7 font in
+ * a 6x8 cell. Where grlib sets a window for every row of every glyph,
+ * [Text_draw()] sets the window once and streams its pixels row by row, so
+ * the LCD receives nothing but pixel data after the window is set. The text
+ * is opaque and fills the whole window: characters past its end are spaces.
+ * It does not go through a grlib context, so it draws the same with and
+ * without LCD_FRAMEBUFFER.
+ * =============================================================================
+ */
+
+// Draws a line of text into a window one character cell high, in 24-bit RGB
+// colours such as GRAPHICS_COLOR_WHITE
+void Text_draw(const Graphics_Rectangle* window_p, const char* text,
+               uint32_t foreground, uint32_t background);
+
+#endif /* HAL_TEXT_H_ */
@@ -5,19 +5,32 @@
  *      Author: Matthew Zhong
  */
 
+#include <HAL/RamFunc.h>
 #include <HAL/Timer.h>
 
 /** The reference counter which tracks how many rollovers have occurred. Used in
  * timing SWTimers. */
 static volatile uint64_t hwTimerRollovers = 0;
 
+/** The time, in SYSTEM_CLOCK cycles, at which the hardware timer last changed
+ * its clock, and the rollovers and counter value it had then. Software timers
+ * measure time in SYSTEM_CLOCK cycles whatever the current clock, so their
+ * timing carries over a clock change. */
+static uint64_t rebaseTime = 0;
+static uint64_t rebaseRollovers = 0;
+static uint32_t rebaseCounter = LOADVALUE;
+
+/** The number of SYSTEM_CLOCK cycles per hardware timer count at the current
+ * clock */
+static uint32_t cyclesPerCount = 1;
+
 /**
  * The ISR used to increment the total number of rollovers which have passed.
  * When the TIMER32_0_BASE timer expires, this ISR is automatically called. DO
  * NOT DIRECTLY INVOKE THIS FUNCTION FROM YOUR CODE, or you WILL destroy the
  * accuracy of ALL software timers in your code.
  */
-void T32_INT1_IRQHandler() {
+RAMFUNC void T32_INT1_IRQHandler() {
   hwTimerRollovers++;
   Timer32_clearInterruptFlag(TIMER32_0_BASE);
 }
@@ -92,8 +105,7 @@ void InitSystemTiming() {
 SWTimer SWTimer_construct(uint64_t waitTime_ms) {
   SWTimer timer;
 
-  timer.startCounter = 0;
-  timer.startRollovers = 0;
+  timer.startTime = 0;
 
   uint64_t counterClock = SYSTEM_CLOCK / PRESCALER;
   uint64_t cyclesPerMillisecond = counterClock / MS_DIVISION_FACTOR;
@@ -103,14 +115,62 @@ SWTimer SWTimer_construct(uint64_t waitTime_ms) {
 }
 
 /**
- * Starts a constructed timer by reading the current number of rollovers and
- * current load value in TIMER32_0_BASE.
+ * Returns the number of SYSTEM_CLOCK cycles since the program started running,
+ * counted from the number of rollovers and the current count of
+ * TIMER32_0_BASE since its clock last changed.
+ *
+ * @return the current time in SYSTEM_CLOCK cycles
+ */
+static uint64_t Timer_now() {
+  uint64_t rollovers = hwTimerRollovers - rebaseRollovers;
+  uint64_t currentCounter = Timer32_getValue(TIMER32_0_BASE);
+  uint64_t counts = (rollovers * (LOADVALUE + 1)) + rebaseCounter -
+                    currentCounter;
+
+  return rebaseTime + counts * cyclesPerCount;
+}
+
+/**
+ * Reads the time the software timers measure, for code which only needs a
+ * timestamp.
+ *
+ * @return the current time in SYSTEM_CLOCK cycles
+ */
+uint64_t Timer_cycles() { return Timer_now(); }
+
+/**
+ * Tells the software timers that TIMER32_0_BASE now counts at a different
+ * clock. Must be called right after MCLK changes, so that running timers keep
+ * expiring on time. The clock must divide SYSTEM_CLOCK.
+ *
+ * @param clockHz:    The new MCLK frequency, in Hz
+ */
+void Timer_setCounterClock(uint32_t clockHz) {
+  rebaseTime = Timer_now();
+  rebaseCounter = Timer32_getValue(TIMER32_0_BASE);
+  rebaseRollovers = hwTimerRollovers;
+  cyclesPerCount = SYSTEM_CLOCK / clockHz;
+}
+
+/**
+ * Tells the software timers that TIMER32_0_BASE was stopped for a while, as it
+ * is in LPM3 where MCLK is off. The time which passed meanwhile, measured by a
+ * timer which kept running, is added to the time base, so that running timers
+ * still expire on time. Call it with interrupts disabled, before the rollover
+ * interrupt can run again.
+ *
+ * @param cycles:   The time the hardware timer was stopped, in SYSTEM_CLOCK
+ *                  cycles
+ */
+void Timer_addStoppedCycles(uint64_t cycles) { rebaseTime += cycles; }
+
+/**
+ * Starts a constructed timer by reading the current time.
  *
  * @param timer_p:    The SWTimer to start
  */
 void SWTimer_start(SWTimer* timer_p) {
-  timer_p->startCounter = Timer32_getValue(TIMER32_0_BASE);
-  timer_p->startRollovers = hwTimerRollovers;
+  timer_p->startTime = Timer_now();
 }
 
 /**
@@ -126,13 +186,7 @@ void SWTimer_start(SWTimer* timer_p) {
  * @return the number of cycles elapsed since the timer started.
  */
 uint64_t SWTimer_elapsedCycles(SWTimer* timer_p) {
-  uint64_t rollovers = hwTimerRollovers - timer_p->startRollovers;
-  uint64_t startCounter = timer_p->startCounter;
-  uint64_t currentCounter = Timer32_getValue(TIMER32_0_BASE);
-  uint64_t elapsedCycles =
-      (rollovers * (LOADVALUE + 1)) + startCounter - currentCounter;
-
-  return elapsedCycles;
+  return Timer_now() - timer_p->startTime;
 }
 
 /**
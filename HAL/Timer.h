@@ -23,6 +23,9 @@
 #define LOADVALUE 0xFFFFFFFF
 #define PRESCALER 1
 
+// The frequency at which the TIMER32_0_BASE reference timer counts down
+#define HW_TIMER_CLOCK (SYSTEM_CLOCK / PRESCALER)
+
 /**=================================================================================================
  * A Software timer object, implemented in the C object-oriented style. Use the
  * constructor [SWTimer_construct()] to create a software timer. The only method
@@ -43,13 +46,9 @@ struct _SWTimer {
   // expires
   uint64_t cyclesToWait;
 
-  // The starting counter value of the hardware timer, set when the timer is
-  // started
-  uint32_t startCounter;
-
-  // The starting rollover value of the hardware timer, set when the timer is
-  // started
-  uint32_t startRollovers;
+  // The time, in SYSTEM_CLOCK cycles since the program started, at which the
+  // timer was started
+  uint64_t startTime;
 };
 typedef struct _SWTimer SWTimer;
 
@@ -67,6 +66,18 @@ uint64_t SWTimer_elapsedCycles(SWTimer* timer);
 // Returns true if the timer has expired, and false otherwise
 bool SWTimer_expired(SWTimer* timer);
 
+// Returns the number of microseconds elapsed since the timer was started
+uint64_t SWTimer_elapsedTimeUS(SWTimer* timer);
+
+// Returns the time since the program started, in SYSTEM_CLOCK cycles
+uint64_t Timer_cycles();
+
+// Rebases the software timers after the clock of the hardware timer changed
+void Timer_setCounterClock(uint32_t clockHz);
+
+// Adds time during which the hardware timer was stopped, as in LPM3
+void Timer_addStoppedCycles(uint64_t cycles);
+
 // Initializes the global clock system for the MSP432, as well as a hardware
 // timer under which all of the software timers are based.
 void InitSystemTiming();
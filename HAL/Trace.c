@@ -0,0 +1,68 @@
+/*
+ * Trace.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <HAL/Timer.h>
+#include <HAL/Trace.h>
+
+/** The ring buffer, and the number of records ever written to it */
+static TraceRecord records[TRACE_RECORDS];
+static uint32_t written = 0;
+
+/** The trace runs from reset, so that the first screens are recorded too */
+static bool running = true;
+
+/**
+ * Writes one record into the ring buffer, over the oldest one once the
+ * buffer is full.
+ *
+ * @param point:    Where the program is
+ * @param phase:    Whether the point is entered, left, or only passed
+ * @param arg:      A value belonging to the event
+ */
+void Trace_record(TracePoint point, TracePhase phase, uint16_t arg) {
+  TraceRecord* record_p;
+
+  if (!running) {
+    return;
+  }
+
+  record_p = &records[written & (TRACE_RECORDS - 1)];
+  record_p->time = (uint32_t)Timer_cycles();
+  record_p->point = point;
+  record_p->phase = phase;
+  record_p->arg = arg;
+  written++;
+}
+
+/**
+ * Empties the ring buffer and starts recording.
+ */
+void Trace_start(void) {
+  written = 0;
+  running = true;
+}
+
+/**
+ * Stops recording. The records stay readable until the next start.
+ */
+void Trace_stop(void) { running = false; }
+
+/**
+ * Returns whether the trace is recording.
+ *
+ * @return true from reset or Trace_start() until Trace_stop()
+ */
+bool Trace_isRunning(void) { return running; }
+
+/**
+ * Returns the ring buffer. Read it while the trace is stopped.
+ *
+ * @return the TRACE_RECORDS records, of which Trace_written() are valid
+ *         while it is smaller
+ */
+const TraceRecord* Trace_records(void) { return records; }
+
+uint32_t Trace_written(void) { return written; }
@@ -0,0 +1,97 @@
+/*
+ * Trace.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef HAL_TRACE_H_
+#define HAL_TRACE_H_
+
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+// Set to 0 to compile every trace point out
+#define TRACE_ENABLED 1
+
+// Records the ring buffer holds, a power of two. Each takes 8 bytes.
+#define TRACE_RECORDS 512
+
+/**
+ * The places the program is traced at. tools/trace.py names them in the same
+ * order.
+ */
+typedef enum {
+  TRACE_LOOP,                 // Application_loop()
+  TRACE_GAME_FSM,             // Game_FSM()
+  TRACE_TITLE_SCREEN,         // title_screen_state()
+  TRACE_INSTRUCTIONS_SCREEN,  // instructions_screen_state()
+  TRACE_SETTINGS_SCREEN,      // settings_screen_state()
+  TRACE_SELECTION_SCREEN,     // selection_screen_state()
+  TRACE_GAME_SCREEN,          // game_screen_state()
+  TRACE_END_SCREEN,           // end_screen_state()
+  TRACE_UART_SEND,            // A loop sending text; the argument is its length
+  TRACE_LCD_PIXELS,           // A row of pixels; the argument is the count
+  TRACE_LCD_LINE_H,           // A horizontal line; the argument is its length
+  TRACE_LCD_LINE_V,           // A vertical line; the argument is its length
+  TRACE_LCD_RECT,             // A filled rectangle; the argument is its area
+  TRACE_LCD_FLUSH,            // A framebuffer sent to the LCD
+  TRACE_RX_CHAR,              // A human's character; the argument is the byte
+  NUM_TRACE_POINTS
+} TracePoint;
+
+typedef enum { TRACE_BEGIN, TRACE_END, TRACE_MARK } TracePhase;
+
+/**
+ * One trace record. The time is the low 32 bits of the SYSTEM_CLOCK cycles
+ * the software timers count, which wrap around after 89 seconds.
+ */
+struct _TraceRecord {
+  uint32_t time;
+  uint8_t point;
+  uint8_t phase;
+  uint16_t arg;
+};
+typedef struct _TraceRecord TraceRecord;
+
+/**=============================================================================
+ * A flight recorder. Trace points write TraceRecords into a ring buffer in
+ * RAM, where the last TRACE_RECORDS of them are kept. The buffer is read out
+ * with [Trace_records()] and turned into Chrome trace JSON by tools/trace.py.
+ * =============================================================================
+ * USAGE WARNINGS
+ * =============================================================================
+ * Trace points must not be placed in interrupt handlers; the ring buffer is
+ * written without locking. Use the TRACE_* macros below rather than calling
+ * [Trace_record()], so that the points cost nothing when TRACE_ENABLED is 0.
+ */
+
+// Records one event if the trace runs
+void Trace_record(TracePoint point, TracePhase phase, uint16_t arg);
+
+// Clears the ring buffer and starts recording, as after reset
+void Trace_start(void);
+
+// Stops recording, keeping the records
+void Trace_stop(void);
+
+// Returns true while the trace records
+bool Trace_isRunning(void);
+
+// Returns the ring buffer and the number of records written to it since the
+// start; the oldest record kept is at that number modulo TRACE_RECORDS, once
+// it wrapped around
+const TraceRecord* Trace_records(void);
+uint32_t Trace_written(void);
+
+#if TRACE_ENABLED
+#define TRACE_ENTER(point) Trace_record(point, TRACE_BEGIN, 0)
+#define TRACE_EXIT(point) Trace_record(point, TRACE_END, 0)
+#define TRACE_ENTER_ARG(point, arg) Trace_record(point, TRACE_BEGIN, arg)
+#define TRACE_MARK_ARG(point, arg) Trace_record(point, TRACE_MARK, arg)
+#else
+#define TRACE_ENTER(point)
+#define TRACE_EXIT(point)
+#define TRACE_ENTER_ARG(point, arg)
+#define TRACE_MARK_ARG(point, arg)
+#endif
+
+#endif /* HAL_TRACE_H_ */
@@ -6,9 +6,82 @@
  *  Supervisor: Leyla Nazhand-Ali
  */
 
+#include <HAL/Clock.h>
+#include <HAL/Metrics.h>
+#include <HAL/RamFunc.h>
 #include <HAL/Timer.h>
 #include <HAL/UART.h>
 
+// The address distance between two eUSCI_A modules, used to number them
+#define EUSCI_A_MODULE_SPACING (EUSCI_A1_BASE - EUSCI_A0_BASE)
+#define NUM_EUSCI_A_MODULES 4
+
+/**
+ * A receive buffer filled by the receive interrupt of one eUSCI_A module. The
+ * ISR only ever moves head and the application only ever moves tail, so no
+ * locking is needed.
+ */
+struct _UART_RxBuffer {
+  volatile uint8_t data[UART_RX_BUFFER_SIZE];
+  volatile uint16_t head;
+  volatile uint16_t tail;
+  volatile uint32_t dropped;
+  volatile uint32_t framingErrors;
+};
+typedef struct _UART_RxBuffer UART_RxBuffer;
+
+/** One receive buffer per eUSCI_A module, indexed by module number */
+static UART_RxBuffer rxBuffers[NUM_EUSCI_A_MODULES];
+
+/** The interrupt number of each eUSCI_A module */
+static const uint32_t rxInterruptMapping[NUM_EUSCI_A_MODULES] = {
+    INT_EUSCIA0, INT_EUSCIA1, INT_EUSCIA2, INT_EUSCIA3};
+
+/**
+ * Returns the number (0 to 3) of the eUSCI_A module behind a UART.
+ */
+static uint32_t UART_moduleNumber(UART* uart_p) {
+  return (uart_p->moduleInstance - EUSCI_A0_BASE) / EUSCI_A_MODULE_SPACING;
+}
+
+/**
+ * Moves a received character from the module into its receive buffer. Called
+ * from the receive ISR of every eUSCI_A module. If the buffer is full, the
+ * character is dropped and counted.
+ *
+ * @param moduleInstance:   The eUSCI_A module which received a character
+ * @param buffer_p:         The receive buffer of that module
+ */
+RAMFUNC static void UART_receiveISR(uint32_t moduleInstance, UART_RxBuffer* buffer_p) {
+  if (UART_getEnabledInterruptStatus(moduleInstance) &
+      EUSCI_A_UART_RECEIVE_INTERRUPT_FLAG) {
+    // Reading the character clears the error flags, so check them first
+    if (UART_queryStatusFlags(moduleInstance, EUSCI_A_UART_FRAMING_ERROR)) {
+      buffer_p->framingErrors++;
+    }
+
+    uint8_t rxChar = UART_receiveData(moduleInstance);
+    uint16_t next = (buffer_p->head + 1) & (UART_RX_BUFFER_SIZE - 1);
+
+    if (next == buffer_p->tail) {
+      buffer_p->dropped++;
+      METRIC_COUNT(METRIC_RX_DROPPED);
+    } else {
+      buffer_p->data[buffer_p->head] = rxChar;
+      buffer_p->head = next;
+    }
+  }
+}
+
+/**
+ * The receive ISRs of the four eUSCI_A modules. DO NOT DIRECTLY INVOKE THESE
+ * FUNCTIONS FROM YOUR CODE.
+ */
+RAMFUNC void EUSCIA0_IRQHandler() { UART_receiveISR(EUSCI_A0_BASE, &rxBuffers[0]); }
+RAMFUNC void EUSCIA1_IRQHandler() { UART_receiveISR(EUSCI_A1_BASE, &rxBuffers[1]); }
+RAMFUNC void EUSCIA2_IRQHandler() { UART_receiveISR(EUSCI_A2_BASE, &rxBuffers[2]); }
+RAMFUNC void EUSCIA3_IRQHandler() { UART_receiveISR(EUSCI_A3_BASE, &rxBuffers[3]); }
+
 /**
  * Initializes the UART module except for the baudrate generation
  * Except for baudrate generation, all other uart configuration should match
@@ -44,42 +117,289 @@ UART UART_construct(uint32_t moduleInstance, uint32_t port, uint32_t pins) {
 
   uart.config.parity = EUSCI_A_UART_NO_PARITY;  // No Parity
 
+  // No baudrate has been generated yet
+  uart.baudRate = 0;
+  uart.baudErrorPPM = 0;
+  uart.framingErrors = 0;
+
+  // Characters are polled until UART_enableRxBuffer() is called
+  uart.rxBuffered = false;
+
 
   // Return the completed UART instance
   return uart;
 }
 
+// The baudrate, in bits per second, of each UART_Baudrate choice.
+static const uint32_t baudRateMapping[NUM_BAUD_CHOICES] = {
+    9600, 19200, 38400, 57600, 115200, 230400, 460800, 921600, 1500000};
+
+// Second modulation stage (UCBRSx) lookup, taken from the eUSCI baudrate
+// table of the MSP432P4xx Technical Reference Manual. Each entry pairs the
+// smallest fractional part of N = f_BRCLK / baudrate (in 1/10000ths) with the
+// UCBRSx pattern to use for it.
+#define NUM_UCBRS_ENTRIES 36
+static const uint16_t ucbrsFractionMapping[NUM_UCBRS_ENTRIES] = {
+    0,    529,  715,  835,  1001, 1252, 1430, 1670, 2147, 2224, 2503, 3000,
+    3335, 3575, 3753, 4003, 4286, 4378, 5002, 5715, 6003, 6254, 6432, 6667,
+    7001, 7147, 7503, 7861, 8004, 8333, 8464, 8572, 8751, 9004, 9170, 9288};
+static const uint8_t ucbrsPatternMapping[NUM_UCBRS_ENTRIES] = {
+    0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x11, 0x21, 0x22, 0x44, 0x25,
+    0x49, 0x4A, 0x52, 0x92, 0x53, 0x55, 0xAA, 0x6B, 0xAD, 0xB5, 0xB6, 0xD6,
+    0xB7, 0xBB, 0xDD, 0xED, 0xEE, 0xBF, 0xDF, 0xEF, 0xF7, 0xFB, 0xFD, 0xFE};
+
+// Fixed-point scale used for the divider N = f_BRCLK / baudrate
+#define BAUD_FRACTION_SCALE 10000
+
+/**
+ * Returns the baudrate, in bits per second, which a baudrate choice stands for.
+ *
+ * @param baudChoice:   The baudrate choice to look up
+ *
+ * @return the baudrate in bits per second
+ */
+uint32_t UART_baudRateValue(UART_Baudrate baudChoice) {
+  return baudRateMapping[baudChoice];
+}
+
+/**
+ * Computes the eUSCI baudrate generator settings for a baudrate, following the
+ * algorithm of the Technical Reference Manual: the clock prescaler UCBRx, the
+ * choice between oversampling and low-frequency generation, the first
+ * modulation stage UCBRFx and the second modulation stage UCBRSx.
+ *
+ * @param config:     The UART configuration whose baudrate fields get filled
+ * @param clockHz:    The frequency of the clock feeding the eUSCI (BRCLK)
+ * @param baudRate:   The desired baudrate in bits per second
+ *
+ * @return the average bit-time error of the generated rate, in ppm. If the
+ * clock is too slow to generate the rate at all, INT32_MAX is returned and the
+ * configuration is left untouched.
+ */
+int32_t UART_computeBaudConfig(UART_Config* config, uint32_t clockHz,
+                               uint32_t baudRate) {
+  // N, the number of clock cycles per bit, in fixed point
+  uint64_t n = ((uint64_t)clockHz * BAUD_FRACTION_SCALE) / baudRate;
+  uint32_t nInteger = n / BAUD_FRACTION_SCALE;
+  uint32_t nFraction = n % BAUD_FRACTION_SCALE;
+
+  // The eUSCI needs at least three clock cycles per bit
+  if (nInteger < 3) {
+    return INT32_MAX;
+  }
+
+  // Pick the second modulation pattern from the fractional part of N
+  int i = NUM_UCBRS_ENTRIES - 1;
+  while (ucbrsFractionMapping[i] > nFraction) {
+    i--;
+  }
+  uint8_t secondModReg = ucbrsPatternMapping[i];
+
+  // With oversampling, every bit is 16 BRCLK/UCBRx ticks plus the extra ticks
+  // requested by UCBRFx. Otherwise UCBRx itself is the bit length. Either way
+  // a bit lasts the integer part of N before the second modulation stage.
+  if (nInteger >= UART_OVERSAMPLING_MIN_RATIO) {
+    config->overSampling = EUSCI_A_UART_OVERSAMPLING_BAUDRATE_GENERATION;
+    config->clockPrescalar = nInteger / 16;
+    config->firstModReg = nInteger % 16;
+  } else {
+    config->overSampling = EUSCI_A_UART_LOW_FREQUENCY_BAUDRATE_GENERATION;
+    config->clockPrescalar = nInteger;
+    config->firstModReg = 0;
+  }
+  config->secondModReg = secondModReg;
+
+  // Each set bit in UCBRSx stretches one of eight bits by one BRCLK tick
+  uint32_t stretchedBits = 0;
+  for (; secondModReg != 0; secondModReg >>= 1) {
+    stretchedBits += secondModReg & 1;
+  }
+  uint64_t effectiveN = (uint64_t)nInteger * BAUD_FRACTION_SCALE +
+                        stretchedBits * (BAUD_FRACTION_SCALE / 8);
+
+  // The real rate is clockHz / effectiveN, so the relative error is
+  // n / effectiveN - 1
+  int64_t errorPPM = (((int64_t)n - (int64_t)effectiveN) * 1000000) /
+                     (int64_t)effectiveN;
+
+  return (int32_t)errorPPM;
+}
+
+/**
+ * Computes the settings of a UART for a baudrate at a given clock, and keeps
+ * them in the UART only if the baudrate can be generated accurately enough.
+ *
+ * @param uart_p:     The UART to configure
+ * @param clockHz:    The frequency of SMCLK the settings are for
+ * @param baudRate:   The baudrate, in bits per second
+ *
+ * @return true if the settings were kept
+ */
+static bool UART_configureBaud(UART* uart_p, uint32_t clockHz,
+                               uint32_t baudRate) {
+  UART_Config config = uart_p->config;
+  config.selectClockSource = EUSCI_A_UART_CLOCKSOURCE_SMCLK;
+
+  int32_t errorPPM = UART_computeBaudConfig(&config, clockHz, baudRate);
+
+  if (errorPPM > UART_MAX_BAUD_ERROR_PPM ||
+      errorPPM < -UART_MAX_BAUD_ERROR_PPM) {
+    return false;
+  }
+
+  uart_p->config = config;
+  uart_p->baudRate = baudRate;
+  uart_p->baudErrorPPM = errorPPM;
+  return true;
+}
+
+/**
+ * Initializes and enables the module with the settings kept in the UART.
+ *
+ * @param uart_p:   The UART to enable
+ */
+static void UART_enable(UART* uart_p) {
+  UART_initModule(uart_p->moduleInstance, &uart_p->config);
+  UART_enableModule(uart_p->moduleInstance);
+
+  // Re-initializing the module clears its interrupt enables
+  if (uart_p->rxBuffered) {
+    UART_enableInterrupt(uart_p->moduleInstance,
+                         EUSCI_A_UART_RECEIVE_INTERRUPT);
+  }
+}
+
 /**
  * (Re)initializes and (re)enable the UART module to use a desired baudrate.
+ * The divider settings are computed from the current clock (see Clock_hz())
+ * rather than looked up, so every entry of UART_Baudrate is supported at
+ * SYSTEM_CLOCK.
  *
  * @param uart_p        The pointer to the uart struct that needs a baudrate and
  * should be enabled
  * @param baudChoice:   The new baud choice with which to update the module
+ *
+ * @return true if the module was enabled at the new baudrate, false if the
+ * baudrate cannot be generated accurately enough (the module is left as is)
  */
-void UART_SetBaud_Enable(UART* uart_p, UART_Baudrate baudChoice) {
-  // We use the system clock for baudrate generation.
-  // The processor clock runs at 48MHz in the project. In other words, system
-  // clock is 48MHz.
-  uart_p->config.selectClockSource = EUSCI_A_UART_CLOCKSOURCE_SMCLK;
+bool UART_SetBaud_Enable(UART* uart_p, UART_Baudrate baudChoice) {
+  // We use SMCLK, which runs at the system clock, for baudrate generation
+  if (!UART_configureBaud(uart_p, Clock_hz(), baudRateMapping[baudChoice])) {
+    return false;
+  }
 
-  // Fortunately for us, for all the baudrates we are working with with f =
-  // 48MHz, we use oversampling mode N>16
-  uart_p->config.overSampling = EUSCI_A_UART_OVERSAMPLING_BAUDRATE_GENERATION;
+  UART_enable(uart_p);
+  return true;
+}
 
-  // When using the baudChoice to index the array, we are effectively saying
-  // that different baudrate choices correspond with different numbers
-  // without requiring excessive amounts of if-statements.
+/**
+ * Returns whether the UART's baudrate can be generated accurately enough from
+ * a different clock. A UART which was never enabled supports every clock.
+ *
+ * @param uart_p:     The UART to check
+ * @param clockHz:    The frequency of SMCLK to check
+ *
+ * @return true if UART_setClock() would succeed
+ */
+bool UART_supportsClock(UART* uart_p, uint32_t clockHz) {
+  if (uart_p->baudRate == 0) {
+    return true;
+  }
+
+  UART_Config config = uart_p->config;
+  int32_t errorPPM = UART_computeBaudConfig(&config, clockHz, uart_p->baudRate);
+
+  return errorPPM <= UART_MAX_BAUD_ERROR_PPM &&
+         errorPPM >= -UART_MAX_BAUD_ERROR_PPM;
+}
 
-  uint32_t clockPrescalerMapping[NUM_BAUD_CHOICES] = {312, 156, 78, 52};
-  uint32_t firstModRegMapping[NUM_BAUD_CHOICES] = {8, 4, 2, 1};
-  uint32_t secondModRegMapping[NUM_BAUD_CHOICES] = {0, 0, 0, 0x25};
+/**
+ * Re-derives the divider settings of an enabled UART after SMCLK changed, and
+ * re-enables it at the same baudrate. The receive buffer is kept. Must be
+ * called right after the clock changes, which should only be done once
+ * UART_waitIdle() returned, so that no character is cut.
+ *
+ * @param uart_p:     The UART to reconfigure
+ * @param clockHz:    The new frequency of SMCLK
+ *
+ * @return false if the baudrate cannot be generated from the new clock
+ */
+bool UART_setClock(UART* uart_p, uint32_t clockHz) {
+  if (uart_p->baudRate == 0) {
+    return true;
+  }
 
-  uart_p->config.clockPrescalar = clockPrescalerMapping[baudChoice];
-  uart_p->config.firstModReg = firstModRegMapping[baudChoice];
-  uart_p->config.secondModReg = secondModRegMapping[baudChoice];
+  if (!UART_configureBaud(uart_p, clockHz, uart_p->baudRate)) {
+    return false;
+  }
 
-  UART_initModule(USB_UART_INSTANCE, &uart_p->config);
-  UART_enableModule(USB_UART_INSTANCE);
+  UART_enable(uart_p);
+  return true;
+}
+
+/**
+ * Waits until the UART is neither sending nor receiving a character.
+ *
+ * @param uart_p:   The UART to wait for
+ */
+void UART_waitIdle(UART* uart_p) {
+  if (uart_p->baudRate == 0) {
+    return;
+  }
+
+  while (UART_queryStatusFlags(uart_p->moduleInstance, EUSCI_A_UART_BUSY))
+    ;
+}
+
+/**
+ * Switches a UART from polling to interrupt-driven reception. From then on,
+ * every received character is moved into the module's receive buffer by its
+ * ISR, so characters arriving on several UARTs at once are all kept, and
+ * UART_hasChar()/UART_getChar() read from that buffer.
+ *
+ * @param uart_p:   The UART to switch to buffered reception
+ */
+void UART_enableRxBuffer(UART* uart_p) {
+  uint32_t moduleNumber = UART_moduleNumber(uart_p);
+  UART_RxBuffer* buffer_p = &rxBuffers[moduleNumber];
+
+  buffer_p->head = 0;
+  buffer_p->tail = 0;
+  uart_p->rxBuffered = true;
+
+  UART_enableInterrupt(uart_p->moduleInstance, EUSCI_A_UART_RECEIVE_INTERRUPT);
+  Interrupt_enableInterrupt(rxInterruptMapping[moduleNumber]);
+}
+
+/**
+ * Returns the number of characters the UART received with a framing error,
+ * whether it is polled or buffered.
+ *
+ * @param uart_p:   The UART to query
+ *
+ * @return the number of framing errors so far
+ */
+uint32_t UART_getFramingErrors(UART* uart_p) {
+  if (uart_p->rxBuffered) {
+    return uart_p->framingErrors +
+           rxBuffers[UART_moduleNumber(uart_p)].framingErrors;
+  }
+  return uart_p->framingErrors;
+}
+
+/**
+ * Returns the number of characters the UART had to drop because its receive
+ * buffer was full. A polled UART never counts dropped characters.
+ *
+ * @param uart_p:   The UART to query
+ *
+ * @return the number of dropped characters so far
+ */
+uint32_t UART_getDroppedChars(UART* uart_p) {
+  if (uart_p->rxBuffered) {
+    return rxBuffers[UART_moduleNumber(uart_p)].dropped;
+  }
+  return 0;
 }
 
 
@@ -93,6 +413,11 @@ void UART_SetBaud_Enable(UART* uart_p, UART_Baudrate baudChoice) {
  * @return true if the user has entered a character, and false otherwise
  */
 bool UART_hasChar(UART* uart_p) {
+  if (uart_p->rxBuffered) {
+    UART_RxBuffer* buffer_p = &rxBuffers[UART_moduleNumber(uart_p)];
+    return buffer_p->head != buffer_p->tail;
+  }
+
   uint8_t interruptStatus = UART_getInterruptStatus(
       uart_p->moduleInstance, EUSCI_A_UART_RECEIVE_INTERRUPT_FLAG);
 
@@ -103,12 +428,26 @@ bool UART_hasChar(UART* uart_p) {
  * Retrieves a character from the UART receive buffer.
  *
  * This function  retrieves and returns the first character
- * from the buffer.
+ * from the buffer. Reading the buffer clears the receive error flags, so a
+ * framing error on the character is counted before the read.
  *
  * @param uart_p A pointer to the UART instance.
  * @return The received character,
  */
 char UART_getChar(UART* uart_p) {
+    // Buffered characters were already checked for errors by the ISR
+    if (uart_p->rxBuffered) {
+        UART_RxBuffer* buffer_p = &rxBuffers[UART_moduleNumber(uart_p)];
+        char rxChar = buffer_p->data[buffer_p->tail];
+        buffer_p->tail = (buffer_p->tail + 1) & (UART_RX_BUFFER_SIZE - 1);
+        return rxChar;
+    }
+
+    // Count characters which arrived with a broken stop bit
+    if (UART_queryStatusFlags(uart_p->moduleInstance,
+                              EUSCI_A_UART_FRAMING_ERROR))
+        uart_p->framingErrors++;
+
     // Read and return the received character
     return UART_receiveData(uart_p->moduleInstance);
 }
@@ -26,6 +26,28 @@
   (GPIO_PIN2 | GPIO_PIN3)  // The pins are given to you for guidance. Also,
                            // because many students miss the parentheses
 #define USB_UART_INSTANCE EUSCI_A0_BASE
+#define USB_UART_RX_PIN GPIO_PIN2
+
+// Dedicated links for seats 2 to 4, one eUSCI_A module each. Seat 1 uses the
+// USB UART above. Note that P2.2 also drives the blue channel of Launchpad
+// LED2, and P3.2/P3.3 are the BoosterPack header UART pins.
+#define NUM_SEAT_UARTS 3
+
+#define SEAT2_UART_INSTANCE EUSCI_A1_BASE
+#define SEAT2_UART_PORT GPIO_PORT_P2
+#define SEAT2_UART_PINS (GPIO_PIN2 | GPIO_PIN3)
+
+#define SEAT3_UART_INSTANCE EUSCI_A2_BASE
+#define SEAT3_UART_PORT GPIO_PORT_P3
+#define SEAT3_UART_PINS (GPIO_PIN2 | GPIO_PIN3)
+
+#define SEAT4_UART_INSTANCE EUSCI_A3_BASE
+#define SEAT4_UART_PORT GPIO_PORT_P9
+#define SEAT4_UART_PINS (GPIO_PIN6 | GPIO_PIN7)
+
+// Size of the receive buffer of an interrupt-driven UART. Must be a power of
+// two.
+#define UART_RX_BUFFER_SIZE 64
 
 // An enum outlining what baud rates the UART_construct() function can use in
 // its initialization.
@@ -34,10 +56,24 @@ enum _UART_Baudrate {
   BAUD_19200,
   BAUD_38400,
   BAUD_57600,
+  BAUD_115200,
+  BAUD_230400,
+  BAUD_460800,
+  BAUD_921600,
+  BAUD_1500000,
   NUM_BAUD_CHOICES
 };
 typedef enum _UART_Baudrate UART_Baudrate;
 
+// The largest average bit-time error, in parts per million, which we accept
+// when generating a baudrate. Anything above roughly 2% starts to corrupt the
+// last bits of a frame on the receiving side.
+#define UART_MAX_BAUD_ERROR_PPM 20000
+
+// Below this ratio of clock to baudrate the eUSCI cannot oversample, so the
+// low-frequency baudrate generator has to be used instead.
+#define UART_OVERSAMPLING_MIN_RATIO 16
+
 /*
  * UART Struct:
  *
@@ -49,6 +85,14 @@ typedef enum _UART_Baudrate UART_Baudrate;
  * 2. moduleInstance: An argument for identifying the specific instance of the UART module to be activated.
  * 3. port: An argument for connecting the program to the corresponding port on the launchpad.
  * 4. pin: An argument for configuring the pins used for UART communication.
+ * 5. baudRate: The baudrate, in bits per second, the module was last set to.
+ * 6. baudErrorPPM: The average bit-time error of that baudrate, in parts per
+ *                  million. Positive values mean the real rate is too fast.
+ * 7. framingErrors: The number of received characters which had a framing
+ *                   error, a telltale sign of a baudrate mismatch. Only
+ *                   counted here while the UART is polled.
+ * 8. rxBuffered: Whether received characters are collected by the receive
+ *                interrupt into a buffer instead of being polled.
  */
 struct _UART {
   UART_Config config;
@@ -56,15 +100,48 @@ struct _UART {
   uint32_t moduleInstance;
   uint32_t port;
   uint32_t pins;
+
+  uint32_t baudRate;
+  int32_t baudErrorPPM;
+
+  uint32_t framingErrors;
+
+  bool rxBuffered;
 };
 typedef struct _UART UART;
 
 // Constructs a uart using the moduleInstance at the given port and pin
 UART UART_construct(uint32_t moduleInstance, uint32_t port, uint32_t pins);
 
-// Sets the baudrate and enables a UART based on the given baudrate enum
-void UART_SetBaud_Enable(UART*, UART_Baudrate baudrate);
+// Sets the baudrate and enables a UART based on the given baudrate enum.
+// Returns false if the rate cannot be generated within UART_MAX_BAUD_ERROR_PPM.
+bool UART_SetBaud_Enable(UART*, UART_Baudrate baudrate);
+
+// Returns the baudrate, in bits per second, of a baudrate enum.
+uint32_t UART_baudRateValue(UART_Baudrate baudChoice);
+
+// Computes the divider, oversampling and modulation settings for a baudrate
+// from a given clock and returns the resulting bit-time error in ppm.
+int32_t UART_computeBaudConfig(UART_Config* config, uint32_t clockHz,
+                               uint32_t baudRate);
+
+// Returns true if the UART's baudrate can be generated from the given clock.
+bool UART_supportsClock(UART* uart_p, uint32_t clockHz);
+
+// Re-derives the baudrate settings of the UART after the system clock changed.
+bool UART_setClock(UART* uart_p, uint32_t clockHz);
+
+// Waits until the UART is neither sending nor receiving a character.
+void UART_waitIdle(UART* uart_p);
+
+// Switches the UART to interrupt-driven reception into a receive buffer.
+void UART_enableRxBuffer(UART* uart_p);
+
+// Returns the number of characters received with a framing error.
+uint32_t UART_getFramingErrors(UART* uart_p);
 
+// Returns the number of characters dropped because the receive buffer was full.
+uint32_t UART_getDroppedChars(UART* uart_p);
 
 // Returns true if a character is available, false otherwise.
 bool UART_hasChar(UART* uart_p);
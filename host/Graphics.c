@@ -0,0 +1,275 @@
+/*
+ * Graphics.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+// The part of the TI graphics library which the firmware uses. As in grlib,
+// everything is drawn through the display driver functions, so the LCD driver
+// sends the panel what it sends on the board.
+
+#include <string.h>
+#include <ti/grlib/grlib.h>
+
+#include "Machine.h"
+
+#define GRAPHICS_FIRST_CHAR ' '
+#define GRAPHICS_LAST_CHAR '~'
+
+/** The classic 5x7 font with a blank column after every glyph */
+static const uint8_t fontFixed6x8Data[] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // ' '
+    0x00, 0x00, 0x5F, 0x00, 0x00, 0x00, // '!'
+    0x00, 0x07, 0x00, 0x07, 0x00, 0x00, // '"'
+    0x14, 0x7F, 0x14, 0x7F, 0x14, 0x00, // '#'
+    0x24, 0x2A, 0x7F, 0x2A, 0x12, 0x00, // '$'
+    0x23, 0x13, 0x08, 0x64, 0x62, 0x00, // '%'
+    0x36, 0x49, 0x55, 0x22, 0x50, 0x00, // '&'
+    0x00, 0x05, 0x03, 0x00, 0x00, 0x00, // quote
+    0x00, 0x1C, 0x22, 0x41, 0x00, 0x00, // '('
+    0x00, 0x41, 0x22, 0x1C, 0x00, 0x00, // ')'
+    0x08, 0x2A, 0x1C, 0x2A, 0x08, 0x00, // '*'
+    0x08, 0x08, 0x3E, 0x08, 0x08, 0x00, // '+'
+    0x00, 0x50, 0x30, 0x00, 0x00, 0x00, // ','
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x00, // '-'
+    0x00, 0x60, 0x60, 0x00, 0x00, 0x00, // '.'
+    0x20, 0x10, 0x08, 0x04, 0x02, 0x00, // '/'
+    0x3E, 0x51, 0x49, 0x45, 0x3E, 0x00, // '0'
+    0x00, 0x42, 0x7F, 0x40, 0x00, 0x00, // '1'
+    0x42, 0x61, 0x51, 0x49, 0x46, 0x00, // '2'
+    0x21, 0x41, 0x45, 0x4B, 0x31, 0x00, // '3'
+    0x18, 0x14, 0x12, 0x7F, 0x10, 0x00, // '4'
+    0x27, 0x45, 0x45, 0x45, 0x39, 0x00, // '5'
+    0x3C, 0x4A, 0x49, 0x49, 0x30, 0x00, // '6'
+    0x01, 0x71, 0x09, 0x05, 0x03, 0x00, // '7'
+    0x36, 0x49, 0x49, 0x49, 0x36, 0x00, // '8'
+    0x06, 0x49, 0x49, 0x29, 0x1E, 0x00, // '9'
+    0x00, 0x36, 0x36, 0x00, 0x00, 0x00, // ':'
+    0x00, 0x56, 0x36, 0x00, 0x00, 0x00, // ';'
+    0x08, 0x14, 0x22, 0x41, 0x00, 0x00, // '<'
+    0x14, 0x14, 0x14, 0x14, 0x14, 0x00, // '='
+    0x00, 0x41, 0x22, 0x14, 0x08, 0x00, // '>'
+    0x02, 0x01, 0x51, 0x09, 0x06, 0x00, // '?'
+    0x32, 0x49, 0x79, 0x41, 0x3E, 0x00, // '@'
+    0x7E, 0x11, 0x11, 0x11, 0x7E, 0x00, // 'A'
+    0x7F, 0x49, 0x49, 0x49, 0x36, 0x00, // 'B'
+    0x3E, 0x41, 0x41, 0x41, 0x22, 0x00, // 'C'
+    0x7F, 0x41, 0x41, 0x22, 0x1C, 0x00, // 'D'
+    0x7F, 0x49, 0x49, 0x49, 0x41, 0x00, // 'E'
+    0x7F, 0x09, 0x09, 0x01, 0x01, 0x00, // 'F'
+    0x3E, 0x41, 0x41, 0x51, 0x32, 0x00, // 'G'
+    0x7F, 0x08, 0x08, 0x08, 0x7F, 0x00, // 'H'
+    0x00, 0x41, 0x7F, 0x41, 0x00, 0x00, // 'I'
+    0x20, 0x40, 0x41, 0x3F, 0x01, 0x00, // 'J'
+    0x7F, 0x08, 0x14, 0x22, 0x41, 0x00, // 'K'
+    0x7F, 0x40, 0x40, 0x40, 0x40, 0x00, // 'L'
+    0x7F, 0x02, 0x04, 0x02, 0x7F, 0x00, // 'M'
+    0x7F, 0x04, 0x08, 0x10, 0x7F, 0x00, // 'N'
+    0x3E, 0x41, 0x41, 0x41, 0x3E, 0x00, // 'O'
+    0x7F, 0x09, 0x09, 0x09, 0x06, 0x00, // 'P'
+    0x3E, 0x41, 0x51, 0x21, 0x5E, 0x00, // 'Q'
+    0x7F, 0x09, 0x19, 0x29, 0x46, 0x00, // 'R'
+    0x46, 0x49, 0x49, 0x49, 0x31, 0x00, // 'S'
+    0x01, 0x01, 0x7F, 0x01, 0x01, 0x00, // 'T'
+    0x3F, 0x40, 0x40, 0x40, 0x3F, 0x00, // 'U'
+    0x1F, 0x20, 0x40, 0x20, 0x1F, 0x00, // 'V'
+    0x7F, 0x20, 0x18, 0x20, 0x7F, 0x00, // 'W'
+    0x63, 0x14, 0x08, 0x14, 0x63, 0x00, // 'X'
+    0x03, 0x04, 0x78, 0x04, 0x03, 0x00, // 'Y'
+    0x61, 0x51, 0x49, 0x45, 0x43, 0x00, // 'Z'
+    0x00, 0x00, 0x7F, 0x41, 0x41, 0x00, // '['
+    0x02, 0x04, 0x08, 0x10, 0x20, 0x00, // backslash
+    0x41, 0x41, 0x7F, 0x00, 0x00, 0x00, // ']'
+    0x04, 0x02, 0x01, 0x02, 0x04, 0x00, // '^'
+    0x40, 0x40, 0x40, 0x40, 0x40, 0x00, // '_'
+    0x00, 0x01, 0x02, 0x04, 0x00, 0x00, // '`'
+    0x20, 0x54, 0x54, 0x54, 0x78, 0x00, // 'a'
+    0x7F, 0x48, 0x44, 0x44, 0x38, 0x00, // 'b'
+    0x38, 0x44, 0x44, 0x44, 0x20, 0x00, // 'c'
+    0x38, 0x44, 0x44, 0x48, 0x7F, 0x00, // 'd'
+    0x38, 0x54, 0x54, 0x54, 0x18, 0x00, // 'e'
+    0x08, 0x7E, 0x09, 0x01, 0x02, 0x00, // 'f'
+    0x08, 0x14, 0x54, 0x54, 0x3C, 0x00, // 'g'
+    0x7F, 0x08, 0x04, 0x04, 0x78, 0x00, // 'h'
+    0x00, 0x44, 0x7D, 0x40, 0x00, 0x00, // 'i'
+    0x20, 0x40, 0x44, 0x3D, 0x00, 0x00, // 'j'
+    0x00, 0x7F, 0x10, 0x28, 0x44, 0x00, // 'k'
+    0x00, 0x41, 0x7F, 0x40, 0x00, 0x00, // 'l'
+    0x7C, 0x04, 0x18, 0x04, 0x78, 0x00, // 'm'
+    0x7C, 0x08, 0x04, 0x04, 0x78, 0x00, // 'n'
+    0x38, 0x44, 0x44, 0x44, 0x38, 0x00, // 'o'
+    0x7C, 0x14, 0x14, 0x14, 0x08, 0x00, // 'p'
+    0x08, 0x14, 0x14, 0x18, 0x7C, 0x00, // 'q'
+    0x7C, 0x08, 0x04, 0x04, 0x08, 0x00, // 'r'
+    0x48, 0x54, 0x54, 0x54, 0x20, 0x00, // 's'
+    0x04, 0x3F, 0x44, 0x40, 0x20, 0x00, // 't'
+    0x3C, 0x40, 0x40, 0x20, 0x7C, 0x00, // 'u'
+    0x1C, 0x20, 0x40, 0x20, 0x1C, 0x00, // 'v'
+    0x3C, 0x40, 0x30, 0x40, 0x3C, 0x00, // 'w'
+    0x44, 0x28, 0x10, 0x28, 0x44, 0x00, // 'x'
+    0x0C, 0x50, 0x50, 0x50, 0x3C, 0x00, // 'y'
+    0x44, 0x64, 0x54, 0x4C, 0x44, 0x00, // 'z'
+    0x00, 0x08, 0x36, 0x41, 0x00, 0x00, // '{'
+    0x00, 0x00, 0x7F, 0x00, 0x00, 0x00, // '|'
+    0x00, 0x41, 0x36, 0x08, 0x00, 0x00, // '}'
+    0x08, 0x04, 0x08, 0x10, 0x08, 0x00, // '~'
+};
+
+const Graphics_Font g_sFontFixed6x8 = {0, 6, 8, 7, fontFixed6x8Data};
+
+void Graphics_initContext(Graphics_Context *context, Graphics_Display *display,
+                          const Graphics_Display_Functions *pFxns) {
+  MACHINE_ENTER();
+  display->pFxns = pFxns;
+
+  context->size = sizeof(Graphics_Context);
+  context->display = display;
+  context->clipRegion.xMin = 0;
+  context->clipRegion.yMin = 0;
+  context->clipRegion.xMax = (int16_t)(display->width - 1);
+  context->clipRegion.yMax = (int16_t)(display->heigth - 1);
+  context->foreground = 0;
+  context->background = 0;
+  context->font = NULL;
+}
+
+void Graphics_setForegroundColor(Graphics_Context *context, int32_t value) {
+  MACHINE_ENTER();
+  context->foreground = context->display->pFxns->pfnColorTranslate(
+      context->display, (uint32_t)value);
+}
+
+void Graphics_setBackgroundColor(Graphics_Context *context, int32_t value) {
+  MACHINE_ENTER();
+  context->background = context->display->pFxns->pfnColorTranslate(
+      context->display, (uint32_t)value);
+}
+
+void Graphics_setFont(Graphics_Context *context, const Graphics_Font *font) {
+  MACHINE_ENTER();
+  context->font = font;
+}
+
+void Graphics_clearDisplay(const Graphics_Context *context) {
+  MACHINE_ENTER();
+  context->display->pFxns->pfnClearDisplay(context->display,
+                                           (uint16_t)context->background);
+}
+
+void Graphics_flushBuffer(const Graphics_Context *context) {
+  MACHINE_ENTER();
+  context->display->pFxns->pfnFlush(context->display);
+}
+
+void Graphics_drawPixel(const Graphics_Context *context, int32_t x,
+                        int32_t y) {
+  const Graphics_Rectangle *clip = &context->clipRegion;
+
+  MACHINE_ENTER();
+  if (x >= clip->xMin && x <= clip->xMax && y >= clip->yMin &&
+      y <= clip->yMax) {
+    context->display->pFxns->pfnPixelDraw(context->display, (int16_t)x,
+                                          (int16_t)y,
+                                          (uint16_t)context->foreground);
+  }
+}
+
+void Graphics_fillRectangle(const Graphics_Context *context,
+                            const Graphics_Rectangle *rect) {
+  const Graphics_Rectangle *clip = &context->clipRegion;
+  Graphics_Rectangle clipped = *rect;
+
+  MACHINE_ENTER();
+  if (clipped.xMin < clip->xMin) clipped.xMin = clip->xMin;
+  if (clipped.yMin < clip->yMin) clipped.yMin = clip->yMin;
+  if (clipped.xMax > clip->xMax) clipped.xMax = clip->xMax;
+  if (clipped.yMax > clip->yMax) clipped.yMax = clip->yMax;
+
+  if (clipped.xMin <= clipped.xMax && clipped.yMin <= clipped.yMax) {
+    context->display->pFxns->pfnRectFill(context->display, &clipped,
+                                         (uint16_t)context->foreground);
+  }
+}
+
+/**
+ * Draws one row of a glyph from column first to column last. An opaque row
+ * goes to the display as 1 bit per pixel data with the two colors as its
+ * palette, and a transparent one as a line per run of foreground pixels.
+ */
+static void Graphics_drawGlyphRow(const Graphics_Context *context,
+                                  const uint8_t *glyph, int row, int32_t x,
+                                  int32_t y, int first, int last,
+                                  bool opaque) {
+  const Graphics_Display_Functions *pFxns = context->display->pFxns;
+  int column;
+
+  if (opaque) {
+    uint32_t palette[2] = {context->background, context->foreground};
+    uint8_t bits = 0;
+
+    for (column = first; column <= last; column++) {
+      if (glyph[column] & (1 << row)) {
+        bits |= 0x80 >> (column - first);
+      }
+    }
+    pFxns->pfnPixelDrawMultiple(context->display, (int16_t)(x + first),
+                                (int16_t)y, 0, (int16_t)(last - first + 1), 1,
+                                &bits, palette);
+    return;
+  }
+
+  for (column = first; column <= last; column++) {
+    int end = column;
+
+    if (!(glyph[column] & (1 << row))) {
+      continue;
+    }
+    while (end < last && (glyph[end + 1] & (1 << row))) {
+      end++;
+    }
+    pFxns->pfnLineDrawH(context->display, (int16_t)(x + column),
+                        (int16_t)(x + end), (int16_t)y,
+                        (uint16_t)context->foreground);
+    column = end;
+  }
+}
+
+/**
+ * Draws a string with its top left corner at (x, y), clipped to the clip
+ * region. A length of -1 draws up to the terminating zero.
+ */
+void Graphics_drawString(const Graphics_Context *context, int8_t *string,
+                         int32_t length, int32_t x, int32_t y, bool opaque) {
+  const Graphics_Font *font = context->font;
+  const Graphics_Rectangle *clip = &context->clipRegion;
+  int32_t i;
+
+  MACHINE_ENTER();
+  if (length < 0) {
+    length = (int32_t)strlen((const char *)string);
+  }
+
+  for (i = 0; i < length; i++, x += font->maxWidth) {
+    char c = (char)string[i];
+    const uint8_t *glyph;
+    int first = 0, last = font->maxWidth - 1, row;
+
+    if (c < GRAPHICS_FIRST_CHAR || c > GRAPHICS_LAST_CHAR) {
+      c = ' ';
+    }
+    glyph = &font->data[(c - GRAPHICS_FIRST_CHAR) * font->maxWidth];
+
+    if (x + first < clip->xMin) first = clip->xMin - x;
+    if (x + last > clip->xMax) last = clip->xMax - x;
+    if (first > last) {
+      continue;
+    }
+
+    for (row = 0; row < font->height; row++) {
+      if (y + row >= clip->yMin && y + row <= clip->yMax) {
+        Graphics_drawGlyphRow(context, glyph, row, x, y + row, first, last,
+                              opaque);
+      }
+    }
+  }
+}
@@ -0,0 +1,624 @@
+/*
+ * Machine.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+// The virtual CPU of the simulator. The firmware runs natively, and only its
+// calls into the hardware take virtual time: each one is charged a fixed
+// number of cycles at the current MCLK, and busy waits jump ahead to the next
+// event of a model. The events fire in time order, and the interrupts they
+// raise run nested inside the hardware call which was in progress, as they
+// would interrupt the CPU there. Virtual time is held back to the wall clock
+// times --speed, so that tools on the pseudo-terminals see the real timing.
+
+#define _GNU_SOURCE
+#include "Machine.h"
+
+#include <poll.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MACHINE_MAX_EVENTS 64
+#define MACHINE_MAX_FDS 16
+
+// How often the host side is looked at while the firmware runs, and how far
+// virtual time may run ahead of the wall clock before the simulator waits
+#define MACHINE_PACE_PS MACHINE_PS_PER_MS
+#define MACHINE_PACE_SLACK_PS (2 * MACHINE_PS_PER_MS)
+
+// Longest wait for the host in one poll(), so that a quit is seen in time
+#define MACHINE_MAX_POLL_MS 100
+
+#define MACHINE_NEVER UINT64_MAX
+
+// Environment variable which carries the session counters across a reset
+#define MACHINE_STATS_ENV "SIM_STATS"
+
+MachineStats Machine_stats;
+uintptr_t Machine_pc, Machine_lr;
+CoreDebug_Type Machine_coreDebug;
+
+// The interrupt handlers of the firmware. Vectors it has no handler for
+// stay NULL, as long as they are never enabled and raised.
+void SysTick_Handler(void) __attribute__((weak));
+void TA1_0_IRQHandler(void) __attribute__((weak));
+void EUSCIA0_IRQHandler(void) __attribute__((weak));
+void EUSCIA1_IRQHandler(void) __attribute__((weak));
+void EUSCIA2_IRQHandler(void) __attribute__((weak));
+void EUSCIA3_IRQHandler(void) __attribute__((weak));
+void T32_INT1_IRQHandler(void) __attribute__((weak));
+void RTC_C_IRQHandler(void) __attribute__((weak));
+void PORT1_IRQHandler(void) __attribute__((weak));
+void PORT2_IRQHandler(void) __attribute__((weak));
+void PORT3_IRQHandler(void) __attribute__((weak));
+void PORT4_IRQHandler(void) __attribute__((weak));
+void PORT5_IRQHandler(void) __attribute__((weak));
+void PORT6_IRQHandler(void) __attribute__((weak));
+
+static void (*handlers[MACHINE_NUM_VECTORS])(void) = {
+    [MACHINE_VECTOR_SYSTICK] = SysTick_Handler,
+    [INT_TA1_0] = TA1_0_IRQHandler,
+    [INT_EUSCIA0] = EUSCIA0_IRQHandler,
+    [INT_EUSCIA1] = EUSCIA1_IRQHandler,
+    [INT_EUSCIA2] = EUSCIA2_IRQHandler,
+    [INT_EUSCIA3] = EUSCIA3_IRQHandler,
+    [INT_T32_INT1] = T32_INT1_IRQHandler,
+    [INT_RTC_C] = RTC_C_IRQHandler,
+    [INT_PORT1] = PORT1_IRQHandler,
+    [INT_PORT2] = PORT2_IRQHandler,
+    [INT_PORT3] = PORT3_IRQHandler,
+    [INT_PORT4] = PORT4_IRQHandler,
+    [INT_PORT5] = PORT5_IRQHandler,
+    [INT_PORT6] = PORT6_IRQHandler,
+};
+
+/** Virtual time, the cycles the CPU ran, and the clock it runs at */
+static uint64_t now = 0;
+static uint64_t cycles = 0;
+static uint64_t psRemainder = 0;
+static uint32_t mclkHz = MACHINE_RESET_DCO_HZ;
+static MachineMode mode = MACHINE_ACTIVE;
+
+/** All events, and the earliest scheduled one if known */
+static MachineEvent* events[MACHINE_MAX_EVENTS];
+static int numEvents = 0;
+static MachineEvent* nextEvent_p = NULL;
+static bool nextKnown = false;
+
+/** The interrupt lines, their NVIC enables, and the enabled vectors which
+ * have a line, in the order they are taken */
+static bool (*lines[MACHINE_NUM_VECTORS])(void);
+static bool vectorEnabled[MACHINE_NUM_VECTORS];
+static int activeVectors[MACHINE_NUM_VECTORS];
+static int numActiveVectors = 0;
+static bool masterEnabled = true;
+static bool inHandler = false;
+
+/** The host side: pacing against the wall clock and the watched fds */
+static double speed = 1.0;
+static double cpuScale = 0.0;
+static uint64_t wallStartNs;
+static uint64_t nextPace = 0;
+static uint64_t lastCpuNs = 0;
+
+typedef struct {
+  int fd;
+  void (*ready)(int fd, void* context_p);
+  void* context_p;
+  bool isReady;
+} HostFd;
+
+static HostFd hostFds[MACHINE_MAX_FDS];
+static int numHostFds = 0;
+
+static uint64_t Machine_clockNs(clockid_t clock) {
+  struct timespec ts;
+  clock_gettime(clock, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+uint64_t Machine_now(void) { return now; }
+
+uint64_t Machine_cycles(void) { return cycles; }
+
+uint32_t Machine_mclkHz(void) { return mclkHz; }
+
+MachineMode Machine_mode(void) { return mode; }
+
+uint64_t Machine_cyclesToPS(uint64_t count, uint32_t hz) {
+  return (uint64_t)(((unsigned __int128)count * MACHINE_PS_PER_S + hz - 1) /
+                    hz);
+}
+
+uint64_t Machine_psToCycles(uint64_t ps, uint32_t hz) {
+  return (uint64_t)(((unsigned __int128)ps * hz) / MACHINE_PS_PER_S);
+}
+
+void Machine_setMclkHz(uint32_t hz) {
+  mclkHz = hz;
+  psRemainder = 0;
+}
+
+/**
+ * Moves virtual time forward, accounting the time to the current mode.
+ */
+static void Machine_setNow(uint64_t time) {
+  uint64_t elapsed = time - now;
+
+  Machine_stats.timePS += elapsed;
+  if (mode == MACHINE_ACTIVE) {
+    Machine_stats.activePS += elapsed;
+  } else if (mode == MACHINE_LPM0) {
+    Machine_stats.lpm0PS += elapsed;
+  } else {
+    Machine_stats.lpm3PS += elapsed;
+  }
+  now = time;
+}
+
+void Machine_addEvent(MachineEvent* event_p, void (*fire)(MachineEvent*),
+                      void* context_p) {
+  if (numEvents == MACHINE_MAX_EVENTS) {
+    fprintf(stderr, "sim: too many events\n");
+    exit(1);
+  }
+  event_p->when = 0;
+  event_p->scheduled = false;
+  event_p->fire = fire;
+  event_p->context_p = context_p;
+  events[numEvents++] = event_p;
+}
+
+void Machine_schedule(MachineEvent* event_p, uint64_t when) {
+  event_p->when = when;
+  event_p->scheduled = true;
+
+  if (event_p == nextEvent_p) {
+    nextKnown = false;
+  } else if (nextKnown && (nextEvent_p == NULL || when < nextEvent_p->when)) {
+    nextEvent_p = event_p;
+  }
+}
+
+void Machine_cancel(MachineEvent* event_p) {
+  event_p->scheduled = false;
+  if (event_p == nextEvent_p) {
+    nextKnown = false;
+  }
+}
+
+static MachineEvent* Machine_nextEvent(void) {
+  int i;
+
+  if (!nextKnown) {
+    nextEvent_p = NULL;
+    for (i = 0; i < numEvents; i++) {
+      if (events[i]->scheduled &&
+          (nextEvent_p == NULL || events[i]->when < nextEvent_p->when)) {
+        nextEvent_p = events[i];
+      }
+    }
+    nextKnown = true;
+  }
+  return nextEvent_p;
+}
+
+static uint64_t Machine_nextEventTime(void) {
+  MachineEvent* event_p = Machine_nextEvent();
+  return event_p == NULL ? MACHINE_NEVER : event_p->when;
+}
+
+/**
+ * Returns the first vector which is enabled and pending, or -1.
+ */
+static int Machine_pendingVector(void) {
+  int i;
+
+  for (i = 0; i < numActiveVectors; i++) {
+    if (lines[activeVectors[i]]()) {
+      return activeVectors[i];
+    }
+  }
+  return -1;
+}
+
+/**
+ * Runs the handlers of the pending interrupts, unless interrupts are masked
+ * or a handler is already running. Handlers do not nest, as all interrupts
+ * of the firmware have the same priority.
+ */
+static void Machine_dispatch(void) {
+  int vector;
+
+  if (!masterEnabled || inHandler || mode != MACHINE_ACTIVE) {
+    return;
+  }
+
+  while ((vector = Machine_pendingVector()) >= 0) {
+    if (handlers[vector] == NULL) {
+      fprintf(stderr, "sim: interrupt %d has no handler\n", vector);
+      Machine_exit(1);
+    }
+
+    inHandler = true;
+    Machine_stats.interrupts++;
+    Machine_spend(MACHINE_EXCEPTION_CYCLES);
+    handlers[vector]();
+    Machine_spend(MACHINE_EXCEPTION_CYCLES);
+    inHandler = false;
+  }
+}
+
+/**
+ * Waits until the host has input or the wall clock reaches a virtual time,
+ * whichever comes first.
+ */
+static int Machine_pollHost(int timeoutMs) {
+  struct pollfd fds[MACHINE_MAX_FDS];
+  int i, ready;
+
+  for (i = 0; i < numHostFds; i++) {
+    fds[i].fd = hostFds[i].fd;
+    fds[i].events = POLLIN;
+    fds[i].revents = 0;
+  }
+
+  ready = poll(fds, numHostFds, timeoutMs);
+  for (i = 0; ready > 0 && i < numHostFds; i++) {
+    if (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+      hostFds[i].isReady = true;
+    }
+  }
+  return ready;
+}
+
+static uint64_t Machine_wallTime(void) {
+  uint64_t ns = Machine_clockNs(CLOCK_MONOTONIC) - wallStartNs;
+  return (uint64_t)((double)ns * 1000.0 * speed);
+}
+
+static void Machine_waitHost(uint64_t until) {
+  for (;;) {
+    uint64_t wall = Machine_wallTime();
+    uint64_t waitMs;
+
+    if (wall >= until) {
+      Machine_pollHost(0);
+      return;
+    }
+
+    waitMs = (uint64_t)((double)(until - wall) / speed / MACHINE_PS_PER_MS) + 1;
+    if (waitMs > MACHINE_MAX_POLL_MS) {
+      waitMs = MACHINE_MAX_POLL_MS;
+    }
+    if (Machine_pollHost((int)waitMs) > 0) {
+      return;
+    }
+  }
+}
+
+/**
+ * Lets the models take the input which arrived on the host fds, now that
+ * virtual time has caught up with its arrival.
+ */
+static void Machine_runHost(void) {
+  int i;
+
+  for (i = 0; i < numHostFds; i++) {
+    if (hostFds[i].isReady) {
+      hostFds[i].isReady = false;
+      hostFds[i].ready(hostFds[i].fd, hostFds[i].context_p);
+    }
+  }
+}
+
+/**
+ * Looks at the host while the firmware runs. Virtual time running ahead of
+ * the wall clock is held back here.
+ */
+static void Machine_pace(void) {
+  nextPace = now + MACHINE_PACE_PS;
+
+  if (speed > 0 && now > Machine_wallTime() + MACHINE_PACE_SLACK_PS) {
+    Machine_waitHost(now);
+  } else {
+    Machine_pollHost(0);
+  }
+  Machine_runHost();
+}
+
+/**
+ * Fires the events up to a time, with the interrupts they raise, and moves
+ * virtual time there.
+ */
+static void Machine_advanceTo(uint64_t target) {
+  for (;;) {
+    MachineEvent* event_p = Machine_nextEvent();
+
+    if (event_p == NULL || event_p->when > target) {
+      break;
+    }
+    if (event_p->when > now) {
+      Machine_setNow(event_p->when);
+    }
+    Machine_cancel(event_p);
+    event_p->fire(event_p);
+    Machine_dispatch();
+  }
+
+  if (target > now) {
+    Machine_setNow(target);
+  }
+  if (now >= nextPace) {
+    Machine_pace();
+  }
+}
+
+void Machine_spend(uint64_t count) {
+  unsigned __int128 ps =
+      (unsigned __int128)count * MACHINE_PS_PER_S + psRemainder;
+
+  cycles += count;
+  psRemainder = (uint64_t)(ps % mclkHz);
+  Machine_advanceTo(now + (uint64_t)(ps / mclkHz));
+}
+
+/**
+ * Charges the cycles the firmware took since it last touched the hardware,
+ * when its host CPU time is scaled to the board's.
+ */
+static void Machine_chargeCode(void) {
+  uint64_t cpuNs = Machine_clockNs(CLOCK_THREAD_CPUTIME_ID);
+  uint64_t elapsed = cpuNs - lastCpuNs;
+
+  if (lastCpuNs != 0) {
+    Machine_spend((uint64_t)((double)elapsed * cpuScale * mclkHz / 1e9));
+  }
+}
+
+void Machine_enter(uintptr_t pc, uintptr_t lr) {
+  Machine_pc = pc;
+  Machine_lr = lr;
+
+  if (cpuScale > 0) {
+    Machine_chargeCode();
+  }
+  if (Machine_ucb0TxBuf != MACHINE_NO_WRITE) {
+    Panel_commit();
+  }
+  Machine_spend(MACHINE_CALL_CYCLES);
+  Machine_dispatch();
+
+  if (cpuScale > 0) {
+    lastCpuNs = Machine_clockNs(CLOCK_THREAD_CPUTIME_ID);
+  }
+}
+
+void Machine_access(void) {
+  if (cpuScale > 0) {
+    Machine_chargeCode();
+  }
+  if (Machine_ucb0TxBuf != MACHINE_NO_WRITE) {
+    Panel_commit();
+  }
+  Machine_spend(MACHINE_REGISTER_CYCLES);
+  Machine_dispatch();
+
+  if (cpuScale > 0) {
+    lastCpuNs = Machine_clockNs(CLOCK_THREAD_CPUTIME_ID);
+  }
+}
+
+/**
+ * Waits for the next event, for a busy wait of the firmware or a sleep. The
+ * CPU spins, or sleeps, until then, so virtual time jumps there. Paced, the
+ * wait ends early when input arrives on the host.
+ */
+void Machine_idle(void) {
+  uint64_t next = Machine_nextEventTime();
+  uint64_t target;
+
+  if (speed > 0) {
+    uint64_t wall;
+
+    Machine_waitHost(next);
+    wall = Machine_wallTime();
+    target = next < wall ? next : wall;
+  } else {
+    Machine_pollHost(next == MACHINE_NEVER ? -1 : 0);
+    target = next;
+  }
+
+  if (target != MACHINE_NEVER) {
+    uint64_t elapsed = target > now ? target - now : 0;
+
+    // The CPU keeps counting cycles while it spins, not while it sleeps
+    if (mode == MACHINE_ACTIVE) {
+      cycles += Machine_psToCycles(elapsed, mclkHz);
+    }
+    Machine_advanceTo(target > now ? target : now);
+  }
+  Machine_runHost();
+}
+
+static bool Machine_anyPending(void) {
+  return Machine_pendingVector() >= 0;
+}
+
+/**
+ * Sleeps until an enabled interrupt is pending, as WFI does. The interrupt
+ * wakes the CPU even while interrupts are masked; it only runs here if they
+ * are not.
+ *
+ * @return true, as the sleep always happens
+ */
+bool Machine_sleep(MachineMode sleepMode) {
+  mode = sleepMode;
+  Timers_modeChanged(mode);
+
+  while (!Machine_anyPending()) {
+    Machine_idle();
+  }
+
+  mode = MACHINE_ACTIVE;
+  Timers_modeChanged(mode);
+  Machine_dispatch();
+  return true;
+}
+
+static void Machine_updateActiveVectors(void) {
+  int vector;
+
+  numActiveVectors = 0;
+  for (vector = 0; vector < MACHINE_NUM_VECTORS; vector++) {
+    if (vectorEnabled[vector] && lines[vector] != NULL) {
+      activeVectors[numActiveVectors++] = vector;
+    }
+  }
+}
+
+void Machine_setLine(int vector, bool (*line)(void)) {
+  lines[vector] = line;
+  Machine_updateActiveVectors();
+}
+
+bool Machine_masterEnabled(void) { return masterEnabled; }
+
+void Machine_setMasterEnabled(bool enabled) {
+  masterEnabled = enabled;
+  Machine_dispatch();
+}
+
+void Machine_setVectorEnabled(int vector, bool enabled) {
+  vectorEnabled[vector] = enabled;
+  Machine_updateActiveVectors();
+  Machine_dispatch();
+}
+
+void Machine_addHostFd(int fd, void (*ready)(int fd, void* context_p),
+                       void* context_p) {
+  if (numHostFds == MACHINE_MAX_FDS) {
+    fprintf(stderr, "sim: too many host files\n");
+    exit(1);
+  }
+  hostFds[numHostFds].fd = fd;
+  hostFds[numHostFds].ready = ready;
+  hostFds[numHostFds].context_p = context_p;
+  hostFds[numHostFds].isReady = false;
+  numHostFds++;
+}
+
+/**
+ * Stops watching a host fd, as at its end of file. poll() skips the entry.
+ */
+void Machine_removeHostFd(int fd) {
+  int i;
+
+  for (i = 0; i < numHostFds; i++) {
+    if (hostFds[i].fd == fd) {
+      hostFds[i].fd = -1;
+      hostFds[i].isReady = false;
+    }
+  }
+}
+
+void Machine_warn(const char* format, ...) {
+  va_list args;
+
+  Machine_stats.warnings++;
+  fprintf(stderr, "sim: %.3f ms: ", (double)now / MACHINE_PS_PER_MS);
+  va_start(args, format);
+  vfprintf(stderr, format, args);
+  va_end(args);
+  fputc('\n', stderr);
+}
+
+void Machine_exit(int status) { exit(status); }
+
+/**
+ * Puts the session counters into the environment, for the program which a
+ * simulated reset executes.
+ */
+void Machine_saveStats(void) {
+  const uint64_t* fields = (const uint64_t*)&Machine_stats;
+  size_t count = sizeof(Machine_stats) / sizeof(uint64_t);
+  char text[sizeof(Machine_stats) / sizeof(uint64_t) * 21 + 1];
+  size_t used = 0;
+  size_t i;
+
+  for (i = 0; i < count; i++) {
+    used += (size_t)snprintf(text + used, sizeof(text) - used, "%s%llu",
+                             i ? "," : "", (unsigned long long)fields[i]);
+  }
+  setenv(MACHINE_STATS_ENV, text, 1);
+}
+
+static void Machine_loadStats(void) {
+  uint64_t* fields = (uint64_t*)&Machine_stats;
+  size_t count = sizeof(Machine_stats) / sizeof(uint64_t);
+  const char* text = getenv(MACHINE_STATS_ENV);
+  size_t i;
+
+  for (i = 0; text != NULL && *text != '\0' && i < count; i++) {
+    char* end;
+    fields[i] = strtoull(text, &end, 10);
+    text = *end == ',' ? end + 1 : end;
+  }
+}
+
+void Machine_printStats(FILE* out) {
+  const MachineStats* s = &Machine_stats;
+  int i;
+
+  fprintf(out, "time_ms %.3f\n", (double)s->timePS / MACHINE_PS_PER_MS);
+  fprintf(out, "active_ms %.3f\n", (double)s->activePS / MACHINE_PS_PER_MS);
+  fprintf(out, "lpm0_ms %.3f\n", (double)s->lpm0PS / MACHINE_PS_PER_MS);
+  fprintf(out, "lpm3_ms %.3f\n", (double)s->lpm3PS / MACHINE_PS_PER_MS);
+  fprintf(out, "resets %llu\n", (unsigned long long)s->resets);
+  fprintf(out, "interrupts %llu\n", (unsigned long long)s->interrupts);
+  fprintf(out, "spi_bytes %llu\n", (unsigned long long)s->spiBytes);
+  fprintf(out, "spi_commands %llu\n", (unsigned long long)s->spiCommands);
+  fprintf(out, "spi_pixel_bytes %llu\n",
+          (unsigned long long)s->spiPixelBytes);
+  fprintf(out, "spi_ignored_bytes %llu\n",
+          (unsigned long long)s->spiIgnoredBytes);
+  fprintf(out, "dma_bytes %llu\n", (unsigned long long)s->dmaBytes);
+  fprintf(out, "lcd_updates %llu\n", (unsigned long long)s->lcdUpdates);
+  fprintf(out, "lcd_update_start_ms %.3f\n",
+          (double)s->lcdUpdateStartPS / MACHINE_PS_PER_MS);
+  fprintf(out, "lcd_update_end_ms %.3f\n",
+          (double)s->lcdUpdateEndPS / MACHINE_PS_PER_MS);
+  for (i = 0; i < 4; i++) {
+    fprintf(out, "uart%d_tx %llu\n", i, (unsigned long long)s->uartTx[i]);
+    fprintf(out, "uart%d_rx %llu\n", i, (unsigned long long)s->uartRx[i]);
+    fprintf(out, "uart%d_framing_errors %llu\n", i,
+            (unsigned long long)s->uartFramingErrors[i]);
+    fprintf(out, "uart%d_overruns %llu\n", i,
+            (unsigned long long)s->uartOverruns[i]);
+  }
+  fprintf(out, "warnings %llu\n", (unsigned long long)s->warnings);
+  fflush(out);
+}
+
+void Machine_init(double paceSpeed, double codeScale) {
+  speed = paceSpeed;
+  cpuScale = codeScale;
+  wallStartNs = Machine_clockNs(CLOCK_MONOTONIC);
+  nextPace = MACHINE_PACE_PS;
+  Machine_loadStats();
+}
+
+DWT_Type* Machine_dwt(void) {
+  static DWT_Type dwt;
+
+  Machine_access();
+  if ((Machine_coreDebug.DEMCR & CoreDebug_DEMCR_TRCENA_Msk) &&
+      (dwt.CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+    dwt.CYCCNT = (uint32_t)cycles;
+  }
+  return &dwt;
+}
@@ -0,0 +1,131 @@
+/*
+ * Machine.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef HOST_MACHINE_H_
+#define HOST_MACHINE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <ti/devices/msp432p4xx/driverlib/driverlib.h>
+
+// Virtual time is counted in picoseconds
+#define MACHINE_PS_PER_S 1000000000000ULL
+#define MACHINE_PS_PER_MS 1000000000ULL
+#define MACHINE_PS_PER_US 1000000ULL
+
+// Cycles charged for a call into driverlib, for a register access, and for
+// entering or leaving an interrupt handler
+#define MACHINE_CALL_CYCLES 24
+#define MACHINE_REGISTER_CYCLES 2
+#define MACHINE_EXCEPTION_CYCLES 12
+
+// Clocks out of reset: the DCO runs at 3 MHz, and ACLK and BCLK come from
+// REFO
+#define MACHINE_RESET_DCO_HZ 3000000
+#define MACHINE_ACLK_HZ 32768
+
+// Number of vectors, numbered as the INT_ constants of driverlib: the 16
+// system exceptions and the 64 interrupts. Lower numbers run first.
+#define MACHINE_NUM_VECTORS 80
+
+// The vector of SysTick, which is a system exception
+#define MACHINE_VECTOR_SYSTICK 15
+
+/** The power modes the CPU can be in */
+typedef enum { MACHINE_ACTIVE, MACHINE_LPM0, MACHINE_LPM3 } MachineMode;
+
+/**
+ * A point in virtual time at which a model changes state. Events are set up
+ * with Machine_addEvent() once and then scheduled any number of times.
+ */
+typedef struct _MachineEvent MachineEvent;
+struct _MachineEvent {
+  uint64_t when;
+  bool scheduled;
+  void (*fire)(MachineEvent* event_p);
+  void* context_p;
+};
+
+/** Counters of the whole session, kept across simulated resets */
+typedef struct {
+  uint64_t resets;
+  uint64_t timePS;
+  uint64_t activePS;
+  uint64_t lpm0PS;
+  uint64_t lpm3PS;
+  uint64_t interrupts;
+  uint64_t spiBytes;
+  uint64_t spiCommands;
+  uint64_t spiPixelBytes;
+  uint64_t spiIgnoredBytes;
+  uint64_t dmaBytes;
+  uint64_t lcdUpdates;
+  uint64_t lcdUpdateStartPS;  // The first and last pixel of the last update
+  uint64_t lcdUpdateEndPS;
+  uint64_t uartTx[4];
+  uint64_t uartRx[4];
+  uint64_t uartFramingErrors[4];
+  uint64_t uartOverruns[4];
+  uint64_t warnings;
+} MachineStats;
+
+extern MachineStats Machine_stats;
+
+/** The address of the last call into the simulated hardware, and the
+ * address its caller returns to, which the profiler samples */
+extern uintptr_t Machine_pc, Machine_lr;
+
+// Time and clocks
+uint64_t Machine_now(void);
+uint64_t Machine_cycles(void);
+uint32_t Machine_mclkHz(void);
+MachineMode Machine_mode(void);
+void Machine_setMclkHz(uint32_t hz);
+uint64_t Machine_cyclesToPS(uint64_t cycles, uint32_t hz);
+uint64_t Machine_psToCycles(uint64_t ps, uint32_t hz);
+
+// Events
+void Machine_addEvent(MachineEvent* event_p, void (*fire)(MachineEvent*),
+                      void* context_p);
+void Machine_schedule(MachineEvent* event_p, uint64_t when);
+void Machine_cancel(MachineEvent* event_p);
+
+// Running the firmware
+#define MACHINE_ENTER() \
+  Machine_enter((uintptr_t)__builtin_return_address(0), \
+                (uintptr_t)__builtin_return_address(1))
+
+void Machine_enter(uintptr_t pc, uintptr_t lr);
+void Machine_access(void);
+void Machine_spend(uint64_t cycles);
+void Machine_idle(void);
+bool Machine_sleep(MachineMode mode);
+
+// Interrupts. A vector is pending while its line function returns true.
+void Machine_setLine(int vector, bool (*line)(void));
+bool Machine_masterEnabled(void);
+void Machine_setMasterEnabled(bool enabled);
+void Machine_setVectorEnabled(int vector, bool enabled);
+
+// Setup and the host side
+void Machine_init(double speed, double cpuScale);
+void Machine_addHostFd(int fd, void (*ready)(int fd, void* context_p),
+                       void* context_p);
+void Machine_removeHostFd(int fd);
+void Machine_warn(const char* format, ...)
+    __attribute__((format(printf, 1, 2)));
+void Machine_exit(int status);
+void Machine_saveStats(void);
+void Machine_printStats(FILE* out);
+
+// What the machine calls in the models: a pending write to UCB0TXBUF, and a
+// change of the power mode, which stops or starts the clocks of the timers
+#define MACHINE_NO_WRITE 0xFFFF
+void Panel_commit(void);
+void Timers_modeChanged(MachineMode mode);
+
+#endif /* HOST_MACHINE_H_ */
@@ -0,0 +1,613 @@
+/*
+ * Panel.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+// The LCD: EUSCI_B0 in SPI mode, the DMA channel which feeds it, and the
+// ST7735 controller of the Crystalfontz panel. A byte written to the
+// transmit buffer takes 8 SPI clocks to shift out, and the controller takes
+// it when it is complete, with the level DC and CS have then. The controller
+// keeps the frame memory and the modes which decide what the panel shows,
+// and warns when the firmware does not wait as long as the controller needs
+// after a reset or SLPOUT.
+
+#include "Panel.h"
+
+#include <stdlib.h>
+
+#include "Pins.h"
+#include "System.h"
+
+// The pins of the LCD (see HAL_MSP_EXP432P401R_Crystalfontz128x128_ST7735.h)
+#define PANEL_RST_PORT GPIO_PORT_P5
+#define PANEL_RST_PIN GPIO_PIN7
+#define PANEL_CS_PORT GPIO_PORT_P5
+#define PANEL_CS_PIN GPIO_PIN0
+#define PANEL_DC_PORT GPIO_PORT_P3
+#define PANEL_DC_PIN GPIO_PIN7
+
+// The frame memory the controller has for this panel, and the part of it
+// the panel shows
+#define PANEL_MEMORY_SIZE 132
+#define PANEL_SIZE 128
+#define PANEL_FIRST_COLUMN 2
+#define PANEL_FIRST_ROW 1
+
+// Waits the controller needs: after a reset before SLPOUT, after SLPOUT
+// before any other command, and after SLPOUT before DISPON
+#define PANEL_RESET_PS (120 * MACHINE_PS_PER_MS)
+#define PANEL_SLEEP_OUT_PS (5 * MACHINE_PS_PER_MS)
+#define PANEL_DISPLAY_ON_PS (120 * MACHINE_PS_PER_MS)
+
+// Pixels written less than this apart belong to one update of the panel,
+// such as the drawing of a screen
+#define PANEL_UPDATE_GAP_PS (10 * MACHINE_PS_PER_MS)
+
+// Commands of the ST7735 which the model acts on
+#define PANEL_SWRESET 0x01
+#define PANEL_SLPIN 0x10
+#define PANEL_SLPOUT 0x11
+#define PANEL_PTLON 0x12
+#define PANEL_NORON 0x13
+#define PANEL_DISPOFF 0x28
+#define PANEL_DISPON 0x29
+#define PANEL_CASET 0x2A
+#define PANEL_RASET 0x2B
+#define PANEL_RAMWR 0x2C
+#define PANEL_PTLAR 0x30
+#define PANEL_VSCRDEF 0x33
+#define PANEL_MADCTL 0x36
+#define PANEL_VSCSAD 0x37
+#define PANEL_IDMOFF 0x38
+#define PANEL_IDMON 0x39
+#define PANEL_COLMOD 0x3A
+
+#define PANEL_MADCTL_MY 0x80
+#define PANEL_MADCTL_MX 0x40
+#define PANEL_MADCTL_MV 0x20
+#define PANEL_MADCTL_BGR 0x08
+
+// The only pixel format the model draws: 16 bits per pixel
+#define PANEL_COLMOD_16BIT 0x05
+
+#define PANEL_MAX_PARAMETERS 6
+
+/** What the firmware last wrote to UCB0TXBUF, if not yet taken */
+volatile uint16_t Machine_ucb0TxBuf = MACHINE_NO_WRITE;
+
+/** EUSCI_B0: its clock prescaler, the transmit buffer and the shifter */
+static struct {
+  bool enabled;
+  uint32_t prescaler;
+  bool txBufFull;
+  uint8_t txBuf;
+  bool shifting;
+  uint8_t shift;
+  MachineEvent shifted;
+} spi;
+
+/** The DMA channel which feeds the transmit buffer */
+static struct {
+  bool active;
+  const volatile uint8_t* source_p;
+  uint32_t remaining;
+} dma;
+
+/** The ST7735 controller */
+static struct {
+  bool inReset;
+  uint64_t resetAt;
+  bool asleep;
+  uint64_t sleepOutAt;
+  bool displayOn;
+  bool partial;
+  bool idle;
+  uint8_t madctl;
+  uint8_t colmod;
+
+  uint8_t command;
+  uint8_t parameters[PANEL_MAX_PARAMETERS];
+  int numParameters;
+
+  uint16_t columnStart, columnEnd, rowStart, rowEnd;
+  uint16_t column, row;
+  bool writing;
+  bool highByte;
+  uint8_t pixelHigh;
+
+  uint16_t topFixed, scrollRows, scrollStart;
+  uint16_t partialStart, partialEnd;
+
+  /** Warnings given since the last reset */
+  bool warnedSleepOut, warnedCommand, warnedDisplayOn, warnedColmod;
+
+  uint16_t memory[PANEL_MEMORY_SIZE][PANEL_MEMORY_SIZE];
+} lcd;
+
+/******************************************************************************
+ * The ST7735 controller
+ ******************************************************************************/
+
+static void Panel_reset(void) {
+  lcd.resetAt = Machine_now();
+  lcd.asleep = true;
+  lcd.displayOn = false;
+  lcd.partial = false;
+  lcd.idle = false;
+  lcd.madctl = 0;
+  lcd.colmod = 0x06;
+  lcd.writing = false;
+  lcd.columnStart = 0;
+  lcd.columnEnd = PANEL_MEMORY_SIZE - 1;
+  lcd.rowStart = 0;
+  lcd.rowEnd = PANEL_MEMORY_SIZE - 1;
+  lcd.topFixed = 0;
+  lcd.scrollRows = PANEL_MEMORY_SIZE;
+  lcd.scrollStart = 0;
+  lcd.partialStart = 0;
+  lcd.partialEnd = PANEL_MEMORY_SIZE - 1;
+  lcd.warnedSleepOut = false;
+  lcd.warnedCommand = false;
+  lcd.warnedDisplayOn = false;
+  lcd.warnedColmod = false;
+}
+
+/**
+ * The reset pin: the controller is held in reset while it is low and
+ * starts over when it goes high.
+ */
+static void Panel_resetChanged(uint_fast8_t port, uint_fast16_t pins) {
+  (void)pins;
+  lcd.inReset = !Pins_level(port, PANEL_RST_PIN);
+  if (!lcd.inReset) {
+    Panel_reset();
+  }
+}
+
+static uint16_t Panel_parameter16(int index) {
+  return (uint16_t)(lcd.parameters[index] << 8 | lcd.parameters[index + 1]);
+}
+
+/**
+ * Stores a pixel at the write pointer, which moves along the window set with
+ * CASET and RASET. MADCTL exchanges and mirrors the addresses on the way to
+ * the frame memory. The pixel also extends the current update of the panel,
+ * or starts a new one.
+ */
+static void Panel_writePixel(uint16_t color) {
+  uint16_t x = lcd.column, y = lcd.row;
+  uint64_t now = Machine_stats.timePS;
+
+  if (Machine_stats.lcdUpdates == 0 ||
+      now - Machine_stats.lcdUpdateEndPS > PANEL_UPDATE_GAP_PS) {
+    Machine_stats.lcdUpdates++;
+    Machine_stats.lcdUpdateStartPS = now;
+  }
+  Machine_stats.lcdUpdateEndPS = now;
+
+  if (lcd.madctl & PANEL_MADCTL_MV) {
+    uint16_t swap = x;
+    x = y;
+    y = swap;
+  }
+  if (lcd.madctl & PANEL_MADCTL_MX) {
+    x = PANEL_MEMORY_SIZE - 1 - x;
+  }
+  if (lcd.madctl & PANEL_MADCTL_MY) {
+    y = PANEL_MEMORY_SIZE - 1 - y;
+  }
+  if (x < PANEL_MEMORY_SIZE && y < PANEL_MEMORY_SIZE) {
+    lcd.memory[y][x] = color;
+  }
+
+  if (lcd.column < lcd.columnEnd) {
+    lcd.column++;
+  } else {
+    lcd.column = lcd.columnStart;
+    lcd.row = lcd.row < lcd.rowEnd ? lcd.row + 1 : lcd.rowStart;
+  }
+}
+
+/**
+ * Applies a command once all its parameters have arrived.
+ */
+static void Panel_applyParameters(void) {
+  switch (lcd.command) {
+    case PANEL_CASET:
+      lcd.columnStart = Panel_parameter16(0);
+      lcd.columnEnd = Panel_parameter16(2);
+      break;
+    case PANEL_RASET:
+      lcd.rowStart = Panel_parameter16(0);
+      lcd.rowEnd = Panel_parameter16(2);
+      break;
+    case PANEL_PTLAR:
+      lcd.partialStart = Panel_parameter16(0);
+      lcd.partialEnd = Panel_parameter16(2);
+      break;
+    case PANEL_VSCRDEF:
+      lcd.topFixed = Panel_parameter16(0);
+      lcd.scrollRows = Panel_parameter16(2);
+      break;
+    case PANEL_VSCSAD:
+      lcd.scrollStart = Panel_parameter16(0);
+      break;
+    case PANEL_MADCTL:
+      lcd.madctl = lcd.parameters[0];
+      break;
+    case PANEL_COLMOD:
+      lcd.colmod = lcd.parameters[0];
+      break;
+    default:
+      break;
+  }
+}
+
+static int Panel_parameterCount(uint8_t command) {
+  switch (command) {
+    case PANEL_CASET:
+    case PANEL_RASET:
+    case PANEL_PTLAR:
+      return 4;
+    case PANEL_VSCRDEF:
+      return 6;
+    case PANEL_VSCSAD:
+      return 2;
+    case PANEL_MADCTL:
+    case PANEL_COLMOD:
+      return 1;
+    default:
+      return 0;
+  }
+}
+
+static void Panel_command(uint8_t command) {
+  uint64_t sinceReset = Machine_now() - lcd.resetAt;
+  uint64_t sinceSleepOut = Machine_now() - lcd.sleepOutAt;
+
+  Machine_stats.spiCommands++;
+
+  if (command == PANEL_SLPOUT) {
+    if (sinceReset < PANEL_RESET_PS && !lcd.warnedSleepOut) {
+      lcd.warnedSleepOut = true;
+      Machine_warn("lcd: SLPOUT %.3f ms after the reset, which needs %llu ms",
+                   (double)sinceReset / MACHINE_PS_PER_MS,
+                   PANEL_RESET_PS / MACHINE_PS_PER_MS);
+    }
+    lcd.asleep = false;
+    lcd.sleepOutAt = Machine_now();
+  } else if (!lcd.asleep && sinceSleepOut < PANEL_SLEEP_OUT_PS &&
+             !lcd.warnedCommand) {
+    lcd.warnedCommand = true;
+    Machine_warn("lcd: command 0x%02X %.3f ms after SLPOUT, which needs "
+                 "%llu ms",
+                 command, (double)sinceSleepOut / MACHINE_PS_PER_MS,
+                 PANEL_SLEEP_OUT_PS / MACHINE_PS_PER_MS);
+  }
+
+  lcd.command = command;
+  lcd.numParameters = 0;
+  lcd.writing = false;
+
+  switch (command) {
+    case PANEL_SWRESET:
+      Panel_reset();
+      break;
+    case PANEL_SLPIN:
+      lcd.asleep = true;
+      break;
+    case PANEL_PTLON:
+      lcd.partial = true;
+      break;
+    case PANEL_NORON:
+      lcd.partial = false;
+      break;
+    case PANEL_IDMON:
+      lcd.idle = true;
+      break;
+    case PANEL_IDMOFF:
+      lcd.idle = false;
+      break;
+    case PANEL_DISPOFF:
+      lcd.displayOn = false;
+      break;
+    case PANEL_DISPON:
+      if (sinceSleepOut < PANEL_DISPLAY_ON_PS && !lcd.warnedDisplayOn) {
+        lcd.warnedDisplayOn = true;
+        Machine_warn("lcd: DISPON %.3f ms after SLPOUT, which needs %llu ms",
+                     (double)sinceSleepOut / MACHINE_PS_PER_MS,
+                     PANEL_DISPLAY_ON_PS / MACHINE_PS_PER_MS);
+      }
+      lcd.displayOn = true;
+      break;
+    case PANEL_RAMWR:
+      if (lcd.colmod != PANEL_COLMOD_16BIT && !lcd.warnedColmod) {
+        lcd.warnedColmod = true;
+        Machine_warn("lcd: RAMWR with COLMOD 0x%02X, the model only draws "
+                     "16 bit pixels",
+                     lcd.colmod);
+      }
+      lcd.writing = true;
+      lcd.highByte = true;
+      lcd.column = lcd.columnStart;
+      lcd.row = lcd.rowStart;
+      break;
+    default:
+      break;
+  }
+}
+
+static void Panel_data(uint8_t data) {
+  if (lcd.writing) {
+    Machine_stats.spiPixelBytes++;
+    if (lcd.highByte) {
+      lcd.pixelHigh = data;
+    } else {
+      Panel_writePixel((uint16_t)(lcd.pixelHigh << 8 | data));
+    }
+    lcd.highByte = !lcd.highByte;
+    return;
+  }
+
+  if (lcd.numParameters < Panel_parameterCount(lcd.command)) {
+    lcd.parameters[lcd.numParameters++] = data;
+    if (lcd.numParameters == Panel_parameterCount(lcd.command)) {
+      Panel_applyParameters();
+    }
+  }
+}
+
+/**
+ * Takes a byte which the SPI module shifted out. The controller only listens
+ * while it is selected, and DC tells commands from data.
+ */
+static void Panel_receive(uint8_t data) {
+  Machine_stats.spiBytes++;
+
+  if (Pins_level(PANEL_CS_PORT, PANEL_CS_PIN) || lcd.inReset) {
+    Machine_stats.spiIgnoredBytes++;
+    return;
+  }
+
+  if (Pins_level(PANEL_DC_PORT, PANEL_DC_PIN)) {
+    Panel_data(data);
+  } else {
+    Panel_command(data);
+  }
+}
+
+/**
+ * Returns the color a pixel of the panel shows, as 8 bit red, green and
+ * blue. The panel shows the frame memory row which vertical scrolling maps
+ * to its line; lines outside the partial area, and the whole panel while it
+ * is off or asleep, stay dark.
+ */
+static void Panel_pixel(uint16_t line, uint16_t column, uint8_t rgb[3]) {
+  uint16_t row = line;
+  uint16_t color, red, green, blue;
+
+  rgb[0] = rgb[1] = rgb[2] = 0;
+  if (!lcd.displayOn || lcd.asleep || lcd.inReset ||
+      (lcd.partial && (line < lcd.partialStart || line > lcd.partialEnd))) {
+    return;
+  }
+
+  if (line >= lcd.topFixed && line < lcd.topFixed + lcd.scrollRows &&
+      lcd.scrollStart >= lcd.topFixed) {
+    row = lcd.topFixed + (line - lcd.topFixed + lcd.scrollStart -
+                          lcd.topFixed) %
+                             lcd.scrollRows;
+  }
+  if (row >= PANEL_MEMORY_SIZE) {
+    return;
+  }
+
+  color = lcd.memory[row][column];
+  red = color >> 11;
+  green = (color >> 5) & 0x3F;
+  blue = color & 0x1F;
+  if (lcd.idle) {
+    red = red & 0x10 ? 0x1F : 0;
+    green = green & 0x20 ? 0x3F : 0;
+    blue = blue & 0x10 ? 0x1F : 0;
+  }
+
+  // The panel's subpixels are in BGR order, which MADCTL BGR accounts for
+  if (!(lcd.madctl & PANEL_MADCTL_BGR)) {
+    uint16_t swap = red;
+    red = blue;
+    blue = swap;
+  }
+  rgb[0] = (uint8_t)(red << 3 | red >> 2);
+  rgb[1] = (uint8_t)(green << 2 | green >> 4);
+  rgb[2] = (uint8_t)(blue << 3 | blue >> 2);
+}
+
+bool Panel_dump(const char* path) {
+  FILE* file = fopen(path, "wb");
+  int x, y;
+
+  if (file == NULL) {
+    return false;
+  }
+
+  // In the UP orientation the screen is the panel turned by 180 degrees
+  fprintf(file, "P6\n%d %d\n255\n", PANEL_SIZE, PANEL_SIZE);
+  for (y = 0; y < PANEL_SIZE; y++) {
+    for (x = 0; x < PANEL_SIZE; x++) {
+      uint8_t rgb[3];
+      Panel_pixel(PANEL_FIRST_ROW + PANEL_SIZE - 1 - y,
+                  PANEL_FIRST_COLUMN + PANEL_SIZE - 1 - x, rgb);
+      fwrite(rgb, 1, sizeof(rgb), file);
+    }
+  }
+  return fclose(file) == 0;
+}
+
+/******************************************************************************
+ * EUSCI_B0 and the DMA
+ ******************************************************************************/
+
+static void Panel_shiftNext(void);
+
+static void Panel_write(uint8_t data) {
+  if (!spi.enabled) {
+    Machine_stats.spiIgnoredBytes++;
+    return;
+  }
+  spi.txBuf = data;
+  spi.txBufFull = true;
+  Panel_shiftNext();
+}
+
+/**
+ * Feeds the transmit buffer from the DMA channel whenever it is free, which
+ * is the transmit request of the channel.
+ */
+static void Panel_feedDma(void) {
+  if (!dma.active || spi.txBufFull || !spi.enabled) {
+    return;
+  }
+
+  Machine_stats.dmaBytes++;
+  dma.remaining--;
+  if (dma.remaining == 0) {
+    dma.active = false;
+  }
+  Panel_write(*dma.source_p++);
+}
+
+/**
+ * Moves the transmit buffer into the shifter once it is free.
+ */
+static void Panel_shiftNext(void) {
+  if (spi.shifting || !spi.txBufFull) {
+    return;
+  }
+
+  spi.shifting = true;
+  spi.shift = spi.txBuf;
+  spi.txBufFull = false;
+  Machine_schedule(&spi.shifted,
+                   Machine_now() + Machine_cyclesToPS(8 * spi.prescaler,
+                                                      System_smclkHz()));
+  Panel_feedDma();
+}
+
+static void Panel_shifted(MachineEvent* event_p) {
+  (void)event_p;
+  spi.shifting = false;
+  Panel_receive(spi.shift);
+  Panel_shiftNext();
+  Panel_feedDma();
+}
+
+void Panel_commit(void) {
+  uint8_t data = (uint8_t)Machine_ucb0TxBuf;
+
+  Machine_ucb0TxBuf = MACHINE_NO_WRITE;
+  Panel_write(data);
+}
+
+uint16_t Machine_ucb0Statw(void) {
+  Machine_access();
+  return spi.shifting || spi.txBufFull ? UCBUSY : 0;
+}
+
+bool SPI_initMaster(uint32_t moduleInstance,
+                    const eUSCI_SPI_MasterConfig* config) {
+  MACHINE_ENTER();
+  (void)moduleInstance;
+  spi.enabled = false;
+  spi.prescaler = config->clockSourceFrequency / config->desiredSpiClock;
+  if (spi.prescaler == 0) {
+    spi.prescaler = 1;
+  }
+  return true;
+}
+
+void SPI_enableModule(uint32_t moduleInstance) {
+  MACHINE_ENTER();
+  (void)moduleInstance;
+  spi.enabled = true;
+}
+
+/**
+ * Puts the module into reset, which cuts a byte which is still shifting.
+ */
+void SPI_disableModule(uint32_t moduleInstance) {
+  MACHINE_ENTER();
+  (void)moduleInstance;
+  if (spi.shifting || spi.txBufFull) {
+    Machine_warn("spi: module stopped while sending");
+  }
+  spi.enabled = false;
+  spi.shifting = false;
+  spi.txBufFull = false;
+  Machine_cancel(&spi.shifted);
+}
+
+uintptr_t SPI_getTransmitBufferAddressForDMA(uint32_t moduleInstance) {
+  MACHINE_ENTER();
+  (void)moduleInstance;
+  return (uintptr_t)&Machine_ucb0TxBuf;
+}
+
+void DMA_enableModule(void) { MACHINE_ENTER(); }
+
+void DMA_setControlBase(void* controlTable) {
+  MACHINE_ENTER();
+  (void)controlTable;
+}
+
+void DMA_assignChannel(uint32_t mapping) {
+  MACHINE_ENTER();
+  (void)mapping;
+}
+
+void DMA_disableChannelAttribute(uint32_t channelNum, uint32_t attr) {
+  MACHINE_ENTER();
+  (void)channelNum;
+  (void)attr;
+}
+
+void DMA_setChannelControl(uint32_t channelStructIndex, uint32_t control) {
+  MACHINE_ENTER();
+  (void)channelStructIndex;
+  (void)control;
+}
+
+void DMA_setChannelTransfer(uint32_t channelStructIndex, uint32_t mode,
+                            void* srcAddr, void* dstAddr,
+                            uint32_t transferSize) {
+  MACHINE_ENTER();
+  (void)channelStructIndex;
+  (void)mode;
+  if ((uintptr_t)dstAddr != (uintptr_t)&Machine_ucb0TxBuf) {
+    Machine_warn("dma: only transfers to UCB0TXBUF are modelled");
+  }
+  dma.source_p = (const volatile uint8_t*)srcAddr;
+  dma.remaining = transferSize;
+}
+
+void DMA_enableChannel(uint32_t channelNum) {
+  MACHINE_ENTER();
+  (void)channelNum;
+  dma.active = dma.remaining > 0;
+  Panel_feedDma();
+}
+
+bool DMA_isChannelEnabled(uint32_t channelNum) {
+  MACHINE_ENTER();
+  (void)channelNum;
+  return dma.active;
+}
+
+void Panel_init(void) {
+  Machine_addEvent(&spi.shifted, Panel_shifted, NULL);
+  spi.prescaler = 1;
+  lcd.inReset = true;
+  Panel_reset();
+  Pins_watch(PANEL_RST_PORT, PANEL_RST_PIN, Panel_resetChanged);
+}
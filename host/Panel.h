@@ -0,0 +1,22 @@
+/*
+ * Panel.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef HOST_PANEL_H_
+#define HOST_PANEL_H_
+
+#include "Machine.h"
+
+/**
+ * Writes what the panel shows, as seen in the LCD_ORIENTATION_UP orientation,
+ * to a binary PPM file.
+ *
+ * @return false if the file cannot be written
+ */
+bool Panel_dump(const char* path);
+
+void Panel_init(void);
+
+#endif /* HOST_PANEL_H_ */
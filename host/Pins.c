@@ -0,0 +1,249 @@
+/*
+ * Pins.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+// The GPIO ports: their direction, output, pull, function select and edge
+// interrupt registers, and what drives the pins from outside the chip, which
+// is the buttons and the RX lines of the UARTs.
+
+#include "Pins.h"
+
+#define PINS_MAX_WATCHES 8
+
+typedef struct {
+  uint16_t dir;
+  uint16_t out;
+  uint16_t ren;
+  uint16_t sel;
+  uint16_t ie;
+  uint16_t ies;
+  uint16_t ifg;
+
+  /** Pins driven from outside, and the level they are driven to */
+  uint16_t driven;
+  uint16_t drivenHigh;
+
+  /** The level of the pins as last seen, for edge detection */
+  uint16_t level;
+} Port;
+
+typedef struct {
+  uint_fast8_t port;
+  uint_fast16_t pins;
+  void (*changed)(uint_fast8_t port, uint_fast16_t pins);
+} Watch;
+
+static Port ports[PINS_NUM_PORTS + 1];
+static Watch watches[PINS_MAX_WATCHES];
+static int numWatches = 0;
+
+/**
+ * Returns the level of every pin of a port: an output drives its own level,
+ * and an input has the level it is driven to from outside. Undriven inputs
+ * float high, as the board only has pull-ups or external pull-ups on them.
+ */
+static uint16_t Pins_levels(const Port* port_p) {
+  uint16_t outputs = port_p->dir & ~port_p->sel;
+  uint16_t external = port_p->driven & ~outputs;
+
+  return (port_p->out & outputs) | (port_p->drivenHigh & external) |
+         (uint16_t)~(outputs | external);
+}
+
+/**
+ * Looks for edges after a change to a port. An edge on a GPIO pin sets its
+ * interrupt flag if it goes the way its edge select asks for.
+ */
+static void Pins_update(uint_fast8_t port) {
+  Port* port_p = &ports[port];
+  uint16_t level = Pins_levels(port_p);
+  uint16_t changed = level ^ port_p->level;
+  uint16_t falling = changed & ~level;
+  uint16_t rising = changed & level;
+  int i;
+
+  port_p->level = level;
+  port_p->ifg |= ((falling & port_p->ies) | (rising & ~port_p->ies)) &
+                 ~port_p->sel;
+
+  for (i = 0; changed && i < numWatches; i++) {
+    if (watches[i].port == port && (watches[i].pins & changed)) {
+      watches[i].changed(port, watches[i].pins & changed);
+    }
+  }
+}
+
+void Pins_drive(uint_fast8_t port, uint_fast16_t pins, bool high) {
+  ports[port].driven |= pins;
+  if (high) {
+    ports[port].drivenHigh |= pins;
+  } else {
+    ports[port].drivenHigh &= ~pins;
+  }
+  Pins_update(port);
+}
+
+void Pins_release(uint_fast8_t port, uint_fast16_t pins) {
+  ports[port].driven &= ~pins;
+  Pins_update(port);
+}
+
+bool Pins_level(uint_fast8_t port, uint_fast16_t pin) {
+  return (ports[port].level & pin) != 0;
+}
+
+bool Pins_isPeripheral(uint_fast8_t port, uint_fast16_t pin) {
+  return (ports[port].sel & pin) != 0;
+}
+
+void Pins_watch(uint_fast8_t port, uint_fast16_t pins,
+                void (*changed)(uint_fast8_t port, uint_fast16_t pins)) {
+  watches[numWatches].port = port;
+  watches[numWatches].pins = pins;
+  watches[numWatches].changed = changed;
+  numWatches++;
+}
+
+/** The interrupt lines of the ports which have vectors */
+#define PINS_LINE(n)                                      \
+  static bool Pins_line##n(void) {                        \
+    return (ports[n].ifg & ports[n].ie) != 0;             \
+  }
+PINS_LINE(1)
+PINS_LINE(2)
+PINS_LINE(3)
+PINS_LINE(4)
+PINS_LINE(5)
+PINS_LINE(6)
+
+void Pins_init(void) {
+  uint_fast8_t port;
+
+  for (port = 1; port <= PINS_NUM_PORTS; port++) {
+    ports[port].level = Pins_levels(&ports[port]);
+  }
+
+  Machine_setLine(INT_PORT1, Pins_line1);
+  Machine_setLine(INT_PORT2, Pins_line2);
+  Machine_setLine(INT_PORT3, Pins_line3);
+  Machine_setLine(INT_PORT4, Pins_line4);
+  Machine_setLine(INT_PORT5, Pins_line5);
+  Machine_setLine(INT_PORT6, Pins_line6);
+}
+
+void GPIO_setAsOutputPin(uint_fast8_t selectedPort,
+                         uint_fast16_t selectedPins) {
+  MACHINE_ENTER();
+  ports[selectedPort].sel &= ~selectedPins;
+  ports[selectedPort].dir |= selectedPins;
+  Pins_update(selectedPort);
+}
+
+void GPIO_setOutputHighOnPin(uint_fast8_t selectedPort,
+                             uint_fast16_t selectedPins) {
+  MACHINE_ENTER();
+  ports[selectedPort].out |= selectedPins;
+  Pins_update(selectedPort);
+}
+
+void GPIO_setOutputLowOnPin(uint_fast8_t selectedPort,
+                            uint_fast16_t selectedPins) {
+  MACHINE_ENTER();
+  ports[selectedPort].out &= ~selectedPins;
+  Pins_update(selectedPort);
+}
+
+void GPIO_toggleOutputOnPin(uint_fast8_t selectedPort,
+                            uint_fast16_t selectedPins) {
+  MACHINE_ENTER();
+  ports[selectedPort].out ^= selectedPins;
+  Pins_update(selectedPort);
+}
+
+void GPIO_setAsInputPin(uint_fast8_t selectedPort,
+                        uint_fast16_t selectedPins) {
+  MACHINE_ENTER();
+  ports[selectedPort].sel &= ~selectedPins;
+  ports[selectedPort].dir &= ~selectedPins;
+  ports[selectedPort].ren &= ~selectedPins;
+  Pins_update(selectedPort);
+}
+
+void GPIO_setAsInputPinWithPullUpResistor(uint_fast8_t selectedPort,
+                                          uint_fast16_t selectedPins) {
+  MACHINE_ENTER();
+  ports[selectedPort].sel &= ~selectedPins;
+  ports[selectedPort].dir &= ~selectedPins;
+  ports[selectedPort].ren |= selectedPins;
+  ports[selectedPort].out |= selectedPins;
+  Pins_update(selectedPort);
+}
+
+void GPIO_setAsPeripheralModuleFunctionOutputPin(uint_fast8_t selectedPort,
+                                                 uint_fast16_t selectedPins,
+                                                 uint_fast8_t mode) {
+  MACHINE_ENTER();
+  (void)mode;
+  ports[selectedPort].sel |= selectedPins;
+  ports[selectedPort].dir |= selectedPins;
+  Pins_update(selectedPort);
+}
+
+void GPIO_setAsPeripheralModuleFunctionInputPin(uint_fast8_t selectedPort,
+                                                uint_fast16_t selectedPins,
+                                                uint_fast8_t mode) {
+  MACHINE_ENTER();
+  (void)mode;
+  ports[selectedPort].sel |= selectedPins;
+  ports[selectedPort].dir &= ~selectedPins;
+  Pins_update(selectedPort);
+}
+
+uint8_t GPIO_getInputPinValue(uint_fast8_t selectedPort,
+                              uint_fast16_t selectedPins) {
+  MACHINE_ENTER();
+  return (ports[selectedPort].level & selectedPins) ? GPIO_INPUT_PIN_HIGH
+                                                    : GPIO_INPUT_PIN_LOW;
+}
+
+void GPIO_enableInterrupt(uint_fast8_t selectedPort,
+                          uint_fast16_t selectedPins) {
+  MACHINE_ENTER();
+  ports[selectedPort].ie |= selectedPins;
+}
+
+void GPIO_disableInterrupt(uint_fast8_t selectedPort,
+                           uint_fast16_t selectedPins) {
+  MACHINE_ENTER();
+  ports[selectedPort].ie &= ~selectedPins;
+}
+
+uint_fast16_t GPIO_getInterruptStatus(uint_fast8_t selectedPort,
+                                      uint_fast16_t selectedPins) {
+  MACHINE_ENTER();
+  return ports[selectedPort].ifg & selectedPins;
+}
+
+uint_fast16_t GPIO_getEnabledInterruptStatus(uint_fast8_t selectedPort) {
+  MACHINE_ENTER();
+  return ports[selectedPort].ifg & ports[selectedPort].ie;
+}
+
+void GPIO_clearInterruptFlag(uint_fast8_t selectedPort,
+                             uint_fast16_t selectedPins) {
+  MACHINE_ENTER();
+  ports[selectedPort].ifg &= ~selectedPins;
+}
+
+void GPIO_interruptEdgeSelect(uint_fast8_t selectedPort,
+                              uint_fast16_t selectedPins,
+                              uint_fast8_t edgeSelect) {
+  MACHINE_ENTER();
+  if (edgeSelect == GPIO_HIGH_TO_LOW_TRANSITION) {
+    ports[selectedPort].ies |= selectedPins;
+  } else {
+    ports[selectedPort].ies &= ~selectedPins;
+  }
+}
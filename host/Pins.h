@@ -0,0 +1,30 @@
+/*
+ * Pins.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef HOST_PINS_H_
+#define HOST_PINS_H_
+
+#include "Machine.h"
+
+// The GPIO ports of the board. Pins which nothing drives read as high, as
+// all inputs of the firmware have their pull-up on.
+#define PINS_NUM_PORTS 10
+
+/** Drives pins of a port from outside the chip, or lets them go again */
+void Pins_drive(uint_fast8_t port, uint_fast16_t pins, bool high);
+void Pins_release(uint_fast8_t port, uint_fast16_t pins);
+
+/** Reads the level of a pin, and whether it is given to a peripheral */
+bool Pins_level(uint_fast8_t port, uint_fast16_t pin);
+bool Pins_isPeripheral(uint_fast8_t port, uint_fast16_t pin);
+
+/** Calls back when the level of watched pins may have changed */
+void Pins_watch(uint_fast8_t port, uint_fast16_t pins,
+                void (*changed)(uint_fast8_t port, uint_fast16_t pins));
+
+void Pins_init(void);
+
+#endif /* HOST_PINS_H_ */
@@ -0,0 +1,752 @@
+/*
+ * Serial.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+// The eUSCI_A modules in UART mode and the serial lines they drive. A line
+// carries the level changes of the characters sent on it, at the bit time of
+// the sender, and a receiver samples it in the middle of each bit at its own
+// bit time, like the eUSCI does. A sender and a receiver at different
+// baudrates therefore lose characters or see framing errors, as on the
+// board. The RX line of a module is also the level of its RX pin, so the
+// auto-baud detector and the wake-up from LPM3 see its edges.
+//
+// The host side of a module is a terminal: bytes written to it are sent on
+// the RX line at the baudrate set on the terminal, and characters on the TX
+// line are decoded at that baudrate and written to it.
+
+#define _GNU_SOURCE
+#include "Serial.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "Pins.h"
+#include "System.h"
+
+// Level changes of one character: the start bit, 8 data bits and the stop bit
+#define SERIAL_CHAR_BITS 10
+#define SERIAL_LINE_QUEUE 16
+
+// Bytes read from a terminal and not yet sent to the module
+#define SERIAL_HOST_QUEUE 65536
+
+// Environment variable which carries the terminals across a reset
+#define SERIAL_FDS_ENV "SIM_SERIAL_FDS"
+
+struct _Receiver;
+
+typedef struct {
+  bool level;
+  uint64_t when[SERIAL_LINE_QUEUE];
+  bool levels[SERIAL_LINE_QUEUE];
+  int head;
+  int count;
+
+  /** The pin the line drives, if any, and the receiver at its other end */
+  uint_fast8_t port;
+  uint_fast16_t pin;
+  struct _Receiver* receiver_p;
+
+  MachineEvent change;
+} Line;
+
+typedef struct _Receiver {
+  Line* line_p;
+  uint64_t (*bitPS)(struct _Receiver* receiver_p);
+  bool (*listening)(struct _Receiver* receiver_p);
+  void (*received)(struct _Receiver* receiver_p, uint8_t data,
+                   bool framingError);
+  void* context_p;
+
+  /** The bit being sampled next: -1 while the line is idle, 0 for the
+   * start bit and 9 for the stop bit */
+  int bit;
+  uint8_t shift;
+  uint64_t startTime;
+  uint64_t bitTime;
+
+  MachineEvent sample;
+} Receiver;
+
+struct _HostPort;
+
+typedef struct {
+  int index;
+  uint_fast8_t port;
+  uint_fast16_t rxPin;
+
+  eUSCI_UART_ConfigV1 config;
+  bool enabled;
+  bool dormant;
+  uint8_t ie;
+  uint8_t ifg;
+  uint8_t errors;
+  uint8_t rxBuf;
+  uint8_t txBuf;
+  bool txBufFull;
+  bool shifting;
+
+  Line rxLine;
+  Line txLine;
+  Receiver receiver;
+  MachineEvent txDone;
+
+  struct _HostPort* host_p;
+} Module;
+
+typedef struct _HostPort {
+  Module* module_p;
+  int fd;
+  int slaveFd;
+  bool attached;
+  speed_t speed;
+
+  uint8_t queue[SERIAL_HOST_QUEUE];
+  size_t head;
+  size_t count;
+  bool sending;
+
+  Receiver receiver;
+  MachineEvent sent;
+} HostPort;
+
+static Module modules[SERIAL_NUM_MODULES];
+static HostPort hostPorts[SERIAL_NUM_MODULES];
+
+static const uint_fast8_t modulePorts[SERIAL_NUM_MODULES] = {
+    GPIO_PORT_P1, GPIO_PORT_P2, GPIO_PORT_P3, GPIO_PORT_P9};
+static const uint_fast16_t moduleRxPins[SERIAL_NUM_MODULES] = {
+    GPIO_PIN2, GPIO_PIN2, GPIO_PIN2, GPIO_PIN6};
+static const uint32_t moduleVectors[SERIAL_NUM_MODULES] = {
+    INT_EUSCIA0, INT_EUSCIA1, INT_EUSCIA2, INT_EUSCIA3};
+
+/** The baudrates a terminal can be set to, as numbers and as speeds */
+#define SERIAL_NUM_SPEEDS 9
+static const uint32_t baudRates[SERIAL_NUM_SPEEDS] = {
+    9600, 19200, 38400, 57600, 115200, 230400, 460800, 921600, 1500000};
+static const speed_t speeds[SERIAL_NUM_SPEEDS] = {
+    B9600, B19200, B38400, B57600, B115200, B230400, B460800, B921600,
+    B1500000};
+
+/******************************************************************************
+ * Lines and receivers
+ ******************************************************************************/
+
+static void Serial_lineChanged(MachineEvent* event_p);
+
+static void Serial_initLine(Line* line_p, uint_fast8_t port,
+                            uint_fast16_t pin) {
+  line_p->level = true;
+  line_p->port = port;
+  line_p->pin = pin;
+  Machine_addEvent(&line_p->change, Serial_lineChanged, line_p);
+
+  if (pin != 0) {
+    Pins_drive(port, pin, true);
+  }
+}
+
+/**
+ * Queues the level changes of one character on a line.
+ */
+static void Serial_sendChar(Line* line_p, uint64_t bitTime, uint8_t data) {
+  uint64_t start = Machine_now();
+  bool previous = true;
+  int bit;
+
+  for (bit = 0; bit < SERIAL_CHAR_BITS; bit++) {
+    bool level = bit == 0                      ? false
+                 : bit == SERIAL_CHAR_BITS - 1 ? true
+                                               : (data >> (bit - 1)) & 1;
+    int tail;
+
+    if (level == previous) {
+      continue;
+    }
+    previous = level;
+
+    tail = (line_p->head + line_p->count) % SERIAL_LINE_QUEUE;
+    line_p->when[tail] = start + bit * bitTime;
+    line_p->levels[tail] = level;
+    line_p->count++;
+  }
+
+  if (line_p->count > 0 && !line_p->change.scheduled) {
+    Machine_schedule(&line_p->change, line_p->when[line_p->head]);
+  }
+}
+
+/**
+ * Applies the next level change of a line. A falling edge on an idle line
+ * is a start bit to its receiver.
+ */
+static void Serial_lineChanged(MachineEvent* event_p) {
+  Line* line_p = (Line*)event_p->context_p;
+  Receiver* receiver_p = line_p->receiver_p;
+
+  line_p->level = line_p->levels[line_p->head];
+  line_p->head = (line_p->head + 1) % SERIAL_LINE_QUEUE;
+  line_p->count--;
+  if (line_p->count > 0) {
+    Machine_schedule(&line_p->change, line_p->when[line_p->head]);
+  }
+
+  if (line_p->pin != 0) {
+    Pins_drive(line_p->port, line_p->pin, line_p->level);
+  }
+
+  if (receiver_p != NULL && receiver_p->bit < 0 && !line_p->level &&
+      receiver_p->listening(receiver_p)) {
+    receiver_p->bit = 0;
+    receiver_p->shift = 0;
+    receiver_p->startTime = Machine_now();
+    receiver_p->bitTime = receiver_p->bitPS(receiver_p);
+    Machine_schedule(&receiver_p->sample,
+                     Machine_now() + receiver_p->bitTime / 2);
+  }
+}
+
+/**
+ * Samples a line in the middle of a bit. A start bit which is no longer low
+ * was a glitch, and a stop bit which is low is a framing error.
+ */
+static void Serial_sample(MachineEvent* event_p) {
+  Receiver* receiver_p = (Receiver*)event_p->context_p;
+  bool level = receiver_p->line_p->level;
+
+  if (!receiver_p->listening(receiver_p) ||
+      (receiver_p->bit == 0 && level)) {
+    receiver_p->bit = -1;
+    return;
+  }
+
+  if (receiver_p->bit == SERIAL_CHAR_BITS - 1) {
+    receiver_p->bit = -1;
+    receiver_p->received(receiver_p, receiver_p->shift, !level);
+    return;
+  }
+
+  if (receiver_p->bit > 0) {
+    receiver_p->shift |= (uint8_t)(level << (receiver_p->bit - 1));
+  }
+  receiver_p->bit++;
+  Machine_schedule(&receiver_p->sample,
+                   receiver_p->startTime + receiver_p->bitTime / 2 +
+                       receiver_p->bit * receiver_p->bitTime);
+}
+
+static void Serial_initReceiver(
+    Receiver* receiver_p, Line* line_p,
+    uint64_t (*bitPS)(Receiver*), bool (*listening)(Receiver*),
+    void (*received)(Receiver*, uint8_t, bool), void* context_p) {
+  receiver_p->line_p = line_p;
+  receiver_p->bitPS = bitPS;
+  receiver_p->listening = listening;
+  receiver_p->received = received;
+  receiver_p->context_p = context_p;
+  receiver_p->bit = -1;
+  line_p->receiver_p = receiver_p;
+  Machine_addEvent(&receiver_p->sample, Serial_sample, receiver_p);
+}
+
+/******************************************************************************
+ * The terminals of the host
+ ******************************************************************************/
+
+static uint64_t Serial_moduleBitPS(const Module* module_p);
+
+static uint32_t Serial_speedBaud(speed_t speed) {
+  int i;
+
+  for (i = 0; i < SERIAL_NUM_SPEEDS; i++) {
+    if (speeds[i] == speed) {
+      return baudRates[i];
+    }
+  }
+  return baudRates[0];
+}
+
+/**
+ * Sets an attached terminal to the baudrate of its module, so that the
+ * simulator on the other end hears it at that rate.
+ */
+static void Serial_followModule(HostPort* host_p) {
+  uint64_t bitTime = Serial_moduleBitPS(host_p->module_p);
+  struct termios settings;
+  speed_t speed = speeds[0];
+  uint64_t bestError = UINT64_MAX;
+  int i;
+
+  if (bitTime == 0) {
+    return;
+  }
+  for (i = 0; i < SERIAL_NUM_SPEEDS; i++) {
+    uint64_t rateBitTime = MACHINE_PS_PER_S / baudRates[i];
+    uint64_t error = rateBitTime > bitTime ? rateBitTime - bitTime
+                                           : bitTime - rateBitTime;
+    if (error < bestError) {
+      bestError = error;
+      speed = speeds[i];
+    }
+  }
+
+  if (speed != host_p->speed && tcgetattr(host_p->fd, &settings) == 0) {
+    cfsetispeed(&settings, speed);
+    cfsetospeed(&settings, speed);
+    tcsetattr(host_p->fd, TCSANOW, &settings);
+    host_p->speed = speed;
+  }
+}
+
+/** The bit time of the terminal, at the baudrate last set on it */
+static uint64_t Serial_hostBitPS(Receiver* receiver_p) {
+  HostPort* host_p = (HostPort*)receiver_p->context_p;
+  struct termios settings;
+
+  if (host_p->attached) {
+    Serial_followModule(host_p);
+  }
+  if (tcgetattr(host_p->attached ? host_p->fd : host_p->slaveFd,
+                &settings) == 0) {
+    host_p->speed = cfgetospeed(&settings);
+  }
+  return MACHINE_PS_PER_S / Serial_speedBaud(host_p->speed);
+}
+
+static bool Serial_hostListening(Receiver* receiver_p) {
+  (void)receiver_p;
+  return true;
+}
+
+static void Serial_hostReceived(Receiver* receiver_p, uint8_t data,
+                                bool framingError) {
+  HostPort* host_p = (HostPort*)receiver_p->context_p;
+
+  (void)framingError;
+  if (write(host_p->fd, &data, 1) != 1 && errno != EAGAIN) {
+    Machine_warn("uart%d: cannot write to the host: %s",
+                 host_p->module_p->index, strerror(errno));
+  }
+}
+
+/**
+ * Sends the next byte from the terminal on the RX line of the module, once
+ * the line is free.
+ */
+static void Serial_hostSend(HostPort* host_p) {
+  uint64_t bitTime;
+  uint8_t data;
+
+  if (host_p->sending || host_p->count == 0) {
+    return;
+  }
+
+  data = host_p->queue[host_p->head];
+  host_p->head = (host_p->head + 1) % SERIAL_HOST_QUEUE;
+  host_p->count--;
+
+  bitTime = Serial_hostBitPS(&host_p->receiver);
+  Serial_sendChar(&host_p->module_p->rxLine, bitTime, data);
+  host_p->sending = true;
+  Machine_schedule(&host_p->sent,
+                   Machine_now() + SERIAL_CHAR_BITS * bitTime);
+}
+
+static void Serial_hostSent(MachineEvent* event_p) {
+  HostPort* host_p = (HostPort*)event_p->context_p;
+
+  host_p->sending = false;
+  Serial_hostSend(host_p);
+}
+
+static void Serial_hostReady(int fd, void* context_p) {
+  HostPort* host_p = (HostPort*)context_p;
+
+  while (host_p->count < SERIAL_HOST_QUEUE) {
+    size_t tail = (host_p->head + host_p->count) % SERIAL_HOST_QUEUE;
+    size_t room = tail >= host_p->head ? SERIAL_HOST_QUEUE - tail
+                                       : host_p->head - tail;
+    ssize_t got = read(fd, &host_p->queue[tail], room);
+
+    if (got <= 0) {
+      break;
+    }
+    host_p->count += (size_t)got;
+  }
+  Serial_hostSend(host_p);
+}
+
+static HostPort* Serial_addHostPort(int module, int fd, int slaveFd,
+                                    bool attached) {
+  HostPort* host_p = &hostPorts[module];
+  Module* module_p = &modules[module];
+
+  host_p->module_p = module_p;
+  host_p->fd = fd;
+  host_p->slaveFd = slaveFd;
+  host_p->attached = attached;
+  host_p->speed = attached ? (speed_t)0 : speeds[0];
+  module_p->host_p = host_p;
+
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+  Serial_initReceiver(&host_p->receiver, &module_p->txLine, Serial_hostBitPS,
+                      Serial_hostListening, Serial_hostReceived, host_p);
+  Machine_addEvent(&host_p->sent, Serial_hostSent, host_p);
+  Machine_addHostFd(fd, Serial_hostReady, host_p);
+  return host_p;
+}
+
+/**
+ * Finds the terminal a module had before a reset, which stays connected.
+ */
+static bool Serial_restore(int module) {
+  const char* text = getenv(SERIAL_FDS_ENV);
+  int index, fd, slaveFd, attached, used;
+
+  while (text != NULL &&
+         sscanf(text, "%d:%d:%d:%d%n", &index, &fd, &slaveFd, &attached,
+                &used) == 4) {
+    if (index == module) {
+      Serial_addHostPort(module, fd, slaveFd, attached != 0);
+      return true;
+    }
+    text += used;
+    text += *text == ',';
+  }
+  return false;
+}
+
+bool Serial_openPty(int module, const char* linkPath) {
+  struct termios settings;
+  const char* slaveName;
+  int fd, slaveFd;
+
+  if (Serial_restore(module)) {
+    return true;
+  }
+
+  fd = posix_openpt(O_RDWR | O_NOCTTY);
+  if (fd < 0 || grantpt(fd) != 0 || unlockpt(fd) != 0 ||
+      (slaveName = ptsname(fd)) == NULL) {
+    fprintf(stderr, "sim: cannot open a pseudo-terminal: %s\n",
+            strerror(errno));
+    return false;
+  }
+
+  // The simulator keeps the slave open, so that the terminal stays up while
+  // no program has it open, and makes it raw like a serial port
+  slaveFd = open(slaveName, O_RDWR | O_NOCTTY);
+  if (slaveFd < 0 || tcgetattr(slaveFd, &settings) != 0) {
+    fprintf(stderr, "sim: cannot open %s: %s\n", slaveName, strerror(errno));
+    return false;
+  }
+  cfmakeraw(&settings);
+  cfsetispeed(&settings, speeds[0]);
+  cfsetospeed(&settings, speeds[0]);
+  tcsetattr(slaveFd, TCSANOW, &settings);
+
+  unlink(linkPath);
+  if (symlink(slaveName, linkPath) != 0) {
+    fprintf(stderr, "sim: cannot link %s to %s: %s\n", linkPath, slaveName,
+            strerror(errno));
+    return false;
+  }
+
+  Serial_addHostPort(module, fd, slaveFd, false);
+  return true;
+}
+
+bool Serial_attach(int module, const char* path) {
+  struct termios settings;
+  int fd;
+
+  if (Serial_restore(module)) {
+    return true;
+  }
+
+  fd = open(path, O_RDWR | O_NOCTTY);
+  if (fd < 0 || tcgetattr(fd, &settings) != 0) {
+    fprintf(stderr, "sim: cannot open %s: %s\n", path, strerror(errno));
+    return false;
+  }
+  cfmakeraw(&settings);
+  tcsetattr(fd, TCSANOW, &settings);
+
+  Serial_addHostPort(module, fd, -1, true);
+  return true;
+}
+
+/**
+ * Puts the terminals into the environment, for the program which a reset
+ * executes. They are inherited, as none is opened close-on-exec.
+ */
+void Serial_saveFds(void) {
+  char text[SERIAL_NUM_MODULES * 48] = "";
+  size_t used = 0;
+  int i;
+
+  for (i = 0; i < SERIAL_NUM_MODULES; i++) {
+    if (modules[i].host_p != NULL) {
+      used += (size_t)snprintf(text + used, sizeof(text) - used,
+                               "%s%d:%d:%d:%d", used ? "," : "", i,
+                               hostPorts[i].fd, hostPorts[i].slaveFd,
+                               hostPorts[i].attached);
+    }
+  }
+  setenv(SERIAL_FDS_ENV, text, 1);
+}
+
+/******************************************************************************
+ * The eUSCI_A modules
+ ******************************************************************************/
+
+static Module* Serial_module(uint32_t moduleInstance) {
+  return &modules[(moduleInstance - EUSCI_A0_BASE) /
+                  (EUSCI_A1_BASE - EUSCI_A0_BASE)];
+}
+
+/**
+ * Returns the bit time the module generates from SMCLK: UCBRx ticks, or 16
+ * times them plus UCBRFx with oversampling, and one more tick on each bit
+ * UCBRSx sets, which averages over 8 bits.
+ */
+static uint64_t Serial_moduleBitPS(const Module* module_p) {
+  const eUSCI_UART_ConfigV1* config_p = &module_p->config;
+  uint64_t eighths;
+  uint8_t pattern;
+
+  if (config_p->clockPrescalar == 0) {
+    return 0;
+  }
+
+  eighths = config_p->overSampling ==
+                    EUSCI_A_UART_OVERSAMPLING_BAUDRATE_GENERATION
+                ? 8 * (16 * (uint64_t)config_p->clockPrescalar +
+                       config_p->firstModReg)
+                : 8 * (uint64_t)config_p->clockPrescalar;
+  for (pattern = config_p->secondModReg; pattern != 0; pattern >>= 1) {
+    eighths += pattern & 1;
+  }
+
+  return (uint64_t)(((unsigned __int128)eighths * MACHINE_PS_PER_S) /
+                    (8 * (uint64_t)System_smclkHz()));
+}
+
+static uint64_t Serial_moduleReceiverBitPS(Receiver* receiver_p) {
+  return Serial_moduleBitPS((Module*)receiver_p->context_p);
+}
+
+/**
+ * The module hears its RX line while the pin is given to it, it is out of
+ * reset and SMCLK runs, which it does not in LPM3.
+ */
+static bool Serial_moduleListening(Receiver* receiver_p) {
+  Module* module_p = (Module*)receiver_p->context_p;
+
+  return module_p->enabled && Machine_mode() != MACHINE_LPM3 &&
+         Pins_isPeripheral(module_p->port, module_p->rxPin);
+}
+
+static void Serial_moduleReceived(Receiver* receiver_p, uint8_t data,
+                                  bool framingError) {
+  Module* module_p = (Module*)receiver_p->context_p;
+
+  Machine_stats.uartRx[module_p->index]++;
+  if (module_p->dormant) {
+    return;
+  }
+
+  if (module_p->ifg & EUSCI_A_UART_RECEIVE_INTERRUPT_FLAG) {
+    module_p->errors |= EUSCI_A_UART_OVERRUN_ERROR;
+    Machine_stats.uartOverruns[module_p->index]++;
+  }
+  if (framingError) {
+    module_p->errors |= EUSCI_A_UART_FRAMING_ERROR;
+    Machine_stats.uartFramingErrors[module_p->index]++;
+  }
+  module_p->rxBuf = data;
+  module_p->ifg |= EUSCI_A_UART_RECEIVE_INTERRUPT_FLAG;
+}
+
+/**
+ * Moves the transmit buffer into the shift register once it is free, which
+ * frees the buffer for the next character.
+ */
+static void Serial_moduleTransmit(Module* module_p) {
+  uint64_t bitTime;
+
+  if (module_p->shifting || !module_p->txBufFull || !module_p->enabled) {
+    return;
+  }
+
+  bitTime = Serial_moduleBitPS(module_p);
+  if (module_p->host_p != NULL && module_p->host_p->attached) {
+    Serial_followModule(module_p->host_p);
+  }
+
+  module_p->txBufFull = false;
+  module_p->shifting = true;
+  module_p->ifg |= EUSCI_A_UART_TRANSMIT_INTERRUPT_FLAG;
+  Serial_sendChar(&module_p->txLine, bitTime, module_p->txBuf);
+  Machine_schedule(&module_p->txDone,
+                   Machine_now() + SERIAL_CHAR_BITS * bitTime);
+  Machine_stats.uartTx[module_p->index]++;
+}
+
+static void Serial_moduleShifted(MachineEvent* event_p) {
+  Module* module_p = (Module*)event_p->context_p;
+
+  module_p->shifting = false;
+  Serial_moduleTransmit(module_p);
+}
+
+#define SERIAL_MODULE_LINE(n)                                       \
+  static bool Serial_line##n(void) {                                \
+    return (modules[n].ifg & modules[n].ie &                        \
+            EUSCI_A_UART_RECEIVE_INTERRUPT_FLAG) != 0;              \
+  }
+SERIAL_MODULE_LINE(0)
+SERIAL_MODULE_LINE(1)
+SERIAL_MODULE_LINE(2)
+SERIAL_MODULE_LINE(3)
+
+static bool (*const moduleLines[SERIAL_NUM_MODULES])(void) = {
+    Serial_line0, Serial_line1, Serial_line2, Serial_line3};
+
+void Serial_init(void) {
+  int i;
+
+  for (i = 0; i < SERIAL_NUM_MODULES; i++) {
+    Module* module_p = &modules[i];
+
+    module_p->index = i;
+    module_p->port = modulePorts[i];
+    module_p->rxPin = moduleRxPins[i];
+    module_p->ifg = EUSCI_A_UART_TRANSMIT_INTERRUPT_FLAG;
+
+    Serial_initLine(&module_p->rxLine, module_p->port, module_p->rxPin);
+    Serial_initLine(&module_p->txLine, 0, 0);
+    Serial_initReceiver(&module_p->receiver, &module_p->rxLine,
+                        Serial_moduleReceiverBitPS, Serial_moduleListening,
+                        Serial_moduleReceived, module_p);
+    Machine_addEvent(&module_p->txDone, Serial_moduleShifted, module_p);
+    Machine_setLine(moduleVectors[i], moduleLines[i]);
+  }
+}
+
+/**
+ * Initializes a module, which leaves it in reset: the interrupt enables and
+ * the receive flags are cleared, and the transmit buffer is free.
+ */
+bool UART_initModule(uint32_t moduleInstance,
+                     const eUSCI_UART_ConfigV1* config) {
+  Module* module_p = Serial_module(moduleInstance);
+
+  MACHINE_ENTER();
+  module_p->config = *config;
+  module_p->enabled = false;
+  module_p->ie = 0;
+  module_p->ifg = EUSCI_A_UART_TRANSMIT_INTERRUPT_FLAG;
+  module_p->errors = 0;
+  module_p->txBufFull = false;
+  module_p->receiver.bit = -1;
+  Machine_cancel(&module_p->receiver.sample);
+  return true;
+}
+
+void UART_enableModule(uint32_t moduleInstance) {
+  Module* module_p = Serial_module(moduleInstance);
+
+  MACHINE_ENTER();
+  module_p->enabled = true;
+  Serial_moduleTransmit(module_p);
+}
+
+void UART_disableModule(uint32_t moduleInstance) {
+  Module* module_p = Serial_module(moduleInstance);
+
+  MACHINE_ENTER();
+  module_p->enabled = false;
+  module_p->ie = 0;
+  module_p->ifg = EUSCI_A_UART_TRANSMIT_INTERRUPT_FLAG;
+  module_p->txBufFull = false;
+}
+
+/**
+ * Writes a character to the transmit buffer, waiting until it is free as
+ * driverlib does.
+ */
+void UART_transmitData(uint32_t moduleInstance, uint_fast8_t transmitData) {
+  Module* module_p = Serial_module(moduleInstance);
+
+  MACHINE_ENTER();
+  while (!(module_p->ifg & EUSCI_A_UART_TRANSMIT_INTERRUPT_FLAG)) {
+    Machine_idle();
+  }
+
+  module_p->ifg &= ~EUSCI_A_UART_TRANSMIT_INTERRUPT_FLAG;
+  module_p->txBuf = (uint8_t)transmitData;
+  module_p->txBufFull = true;
+  Serial_moduleTransmit(module_p);
+}
+
+uint8_t UART_receiveData(uint32_t moduleInstance) {
+  Module* module_p = Serial_module(moduleInstance);
+
+  MACHINE_ENTER();
+  module_p->ifg &= ~EUSCI_A_UART_RECEIVE_INTERRUPT_FLAG;
+  module_p->errors = 0;
+  return module_p->rxBuf;
+}
+
+void UART_enableInterrupt(uint32_t moduleInstance, uint_fast8_t mask) {
+  MACHINE_ENTER();
+  Serial_module(moduleInstance)->ie |= mask;
+}
+
+void UART_disableInterrupt(uint32_t moduleInstance, uint_fast8_t mask) {
+  MACHINE_ENTER();
+  Serial_module(moduleInstance)->ie &= ~mask;
+}
+
+uint_fast8_t UART_getInterruptStatus(uint32_t moduleInstance, uint8_t mask) {
+  MACHINE_ENTER();
+  return Serial_module(moduleInstance)->ifg & mask;
+}
+
+uint_fast8_t UART_getEnabledInterruptStatus(uint32_t moduleInstance) {
+  Module* module_p = Serial_module(moduleInstance);
+
+  MACHINE_ENTER();
+  return module_p->ifg & module_p->ie;
+}
+
+uint_fast8_t UART_queryStatusFlags(uint32_t moduleInstance,
+                                   uint_fast8_t mask) {
+  Module* module_p = Serial_module(moduleInstance);
+  uint_fast8_t status;
+
+  MACHINE_ENTER();
+  status = module_p->errors;
+  if (module_p->shifting || module_p->txBufFull ||
+      module_p->receiver.bit >= 0) {
+    status |= EUSCI_A_UART_BUSY;
+  }
+  return status & mask;
+}
+
+void UART_setDormant(uint32_t moduleInstance) {
+  MACHINE_ENTER();
+  Serial_module(moduleInstance)->dormant = true;
+}
+
+void UART_resetDormant(uint32_t moduleInstance) {
+  MACHINE_ENTER();
+  Serial_module(moduleInstance)->dormant = false;
+}
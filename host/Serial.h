@@ -0,0 +1,35 @@
+/*
+ * Serial.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef HOST_SERIAL_H_
+#define HOST_SERIAL_H_
+
+#include "Machine.h"
+
+#define SERIAL_NUM_MODULES 4
+
+/**
+ * Connects the lines of an eUSCI_A module to a new pseudo-terminal, whose
+ * slave is linked at linkPath. A program on the slave talks to the module at
+ * the baudrate it sets there; characters at another baudrate arrive broken,
+ * as they would on the board.
+ */
+bool Serial_openPty(int module, const char* linkPath);
+
+/**
+ * Connects the lines of an eUSCI_A module to an existing terminal, typically
+ * the pseudo-terminal of a module of another simulator. The terminal follows
+ * the baudrate of the module, so that the two simulated boards talk over it.
+ */
+bool Serial_attach(int module, const char* path);
+
+/** Keeps the terminals open across a reset, which executes the simulator
+ * again */
+void Serial_saveFds(void);
+
+void Serial_init(void);
+
+#endif /* HOST_SERIAL_H_ */
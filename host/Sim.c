@@ -0,0 +1,320 @@
+/*
+ * Sim.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+// The host simulator of the board. It runs the firmware natively against
+// models of the hardware it uses: Timer32, Timer_A1, SysTick and RTC_C, the
+// eUSCI UARTs on pseudo-terminals, the ST7735 panel on eUSCI_B0 and DMA, the
+// buttons, the clock system, the power modes, the reset, and the CRC32 and
+// AES256 accelerators. See "Host Builds" in README.md.
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#include "Machine.h"
+#include "Panel.h"
+#include "Pins.h"
+#include "Serial.h"
+#include "System.h"
+#include "Timers.h"
+
+// The stack of the firmware. HAL/Metrics.c paints it from __StackLimit,
+// which the Makefile places at its bottom.
+#define SIM_STACK_BYTES (1024 * 1024)
+
+#define SIM_DEFAULT_TAP_MS 100
+#define SIM_MAX_COMMAND 256
+
+typedef struct {
+  const char* name;
+  uint_fast8_t port;
+  uint_fast16_t pin;
+} SimButton;
+
+/** The buttons of the board and the BoosterPack, which pull their pin low */
+static const SimButton buttons[] = {
+    {"LS1", GPIO_PORT_P1, GPIO_PIN1}, {"LS2", GPIO_PORT_P1, GPIO_PIN4},
+    {"BB1", GPIO_PORT_P5, GPIO_PIN1}, {"BB2", GPIO_PORT_P3, GPIO_PIN5},
+    {"JS", GPIO_PORT_P4, GPIO_PIN1},
+};
+
+uint8_t Machine_stack[SIM_STACK_BYTES] __attribute__((aligned(16)));
+
+int firmware_main(void);
+
+static ucontext_t hostContext, firmwareContext;
+
+static const char* lcdPath = NULL;
+static bool quiet = false;
+
+/** Commands read from stdin which have not run yet */
+static char commands[4096];
+static size_t commandsUsed = 0;
+static bool commandsWaiting = false;
+static bool commandsEnded = false;
+
+static MachineEvent runForEvent, waitEvent, releaseEvent;
+static const SimButton* tapped_p = NULL;
+static uint64_t tapMs;
+
+static void Sim_usage(void) {
+  fprintf(stderr,
+          "usage: sim [options]\n"
+          "  --speed X       virtual time runs at X times the wall clock, "
+          "0 runs\n"
+          "                  unpaced (default 1)\n"
+          "  --cpu-scale X   also charge the host CPU time of the firmware, "
+          "times X\n"
+          "  --run-for MS    exit after MS of virtual time\n"
+          "  --lcd FILE      write the panel to FILE as a PPM at exit\n"
+          "  --quiet         do not print the counters at exit\n"
+          "  --uartN PATH    give eUSCI_AN a pseudo-terminal, linked at "
+          "PATH\n"
+          "  --attachN PATH  connect eUSCI_AN to the terminal at PATH\n"
+          "commands on stdin:\n"
+          "  press NAME, release NAME, tap NAME [MS]   for LS1 LS2 BB1 BB2 "
+          "JS\n"
+          "  wait MS, lcd FILE, stats, quit\n");
+  exit(2);
+}
+
+static void Sim_atExit(void) {
+  if (lcdPath != NULL) {
+    Panel_dump(lcdPath);
+  }
+  if (!quiet) {
+    Machine_printStats(stdout);
+  }
+}
+
+static void Sim_runForEnded(MachineEvent* event_p) {
+  (void)event_p;
+  Machine_exit(0);
+}
+
+static const SimButton* Sim_findButton(const char* name) {
+  size_t i;
+
+  for (i = 0; name != NULL && i < sizeof(buttons) / sizeof(buttons[0]); i++) {
+    if (strcasecmp(name, buttons[i].name) == 0) {
+      return &buttons[i];
+    }
+  }
+  fprintf(stderr, "sim: no button %s\n", name != NULL ? name : "given");
+  return NULL;
+}
+
+static void Sim_runCommands(void);
+
+static void Sim_waitFor(MachineEvent* event_p, uint64_t ms) {
+  commandsWaiting = true;
+  Machine_schedule(event_p, Machine_now() + ms * MACHINE_PS_PER_MS);
+}
+
+static void Sim_waitEnded(MachineEvent* event_p) {
+  (void)event_p;
+  commandsWaiting = false;
+  Sim_runCommands();
+}
+
+/**
+ * Releases a tapped button, and keeps it released as long as it was held, so
+ * that the debouncing of the firmware sees a following tap as a new one.
+ */
+static void Sim_tapEnded(MachineEvent* event_p) {
+  (void)event_p;
+  Pins_release(tapped_p->port, tapped_p->pin);
+  tapped_p = NULL;
+  Sim_waitFor(&waitEvent, tapMs);
+}
+
+static void Sim_runCommand(char* line) {
+  char* verb = strtok(line, " \t");
+  char* arg = strtok(NULL, " \t");
+  char* extra = strtok(NULL, " \t");
+  const SimButton* button_p;
+
+  if (verb == NULL) {
+    return;
+  }
+
+  if (strcmp(verb, "press") == 0 || strcmp(verb, "release") == 0 ||
+      strcmp(verb, "tap") == 0) {
+    button_p = Sim_findButton(arg);
+    if (button_p == NULL) {
+      return;
+    }
+    if (verb[0] == 'r') {
+      Pins_release(button_p->port, button_p->pin);
+    } else {
+      Pins_drive(button_p->port, button_p->pin, false);
+    }
+    if (verb[0] == 't') {
+      tapped_p = button_p;
+      tapMs = extra != NULL ? strtoull(extra, NULL, 10) : SIM_DEFAULT_TAP_MS;
+      Sim_waitFor(&releaseEvent, tapMs);
+    }
+  } else if (strcmp(verb, "wait") == 0 && arg != NULL) {
+    Sim_waitFor(&waitEvent, strtoull(arg, NULL, 10));
+  } else if (strcmp(verb, "lcd") == 0 && arg != NULL) {
+    Panel_dump(arg);
+  } else if (strcmp(verb, "stats") == 0) {
+    Machine_printStats(stdout);
+  } else if (strcmp(verb, "quit") == 0) {
+    Machine_exit(0);
+  } else {
+    fprintf(stderr, "sim: unknown command %s\n", verb);
+  }
+}
+
+/**
+ * Runs the commands read so far, up to the first wait.
+ */
+static void Sim_runCommands(void) {
+  char* newline_p;
+
+  while (!commandsWaiting &&
+         (newline_p = memchr(commands, '\n', commandsUsed)) != NULL) {
+    char line[SIM_MAX_COMMAND];
+    size_t length = (size_t)(newline_p - commands);
+
+    if (length >= sizeof(line)) {
+      length = sizeof(line) - 1;
+    }
+    memcpy(line, commands, length);
+    line[length] = '\0';
+
+    commandsUsed -= (size_t)(newline_p - commands) + 1;
+    memmove(commands, newline_p + 1, commandsUsed);
+
+    Sim_runCommand(line);
+  }
+
+  // The end of the input ends the session, unless a run time was given
+  if (commandsEnded && !commandsWaiting && !runForEvent.scheduled) {
+    Machine_exit(0);
+  }
+}
+
+static void Sim_stdinReady(int fd, void* context_p) {
+  ssize_t count;
+
+  (void)context_p;
+  if (commandsUsed == sizeof(commands)) {
+    return;
+  }
+
+  count = read(fd, commands + commandsUsed, sizeof(commands) - commandsUsed);
+  if (count == 0) {
+    commandsEnded = true;
+    Machine_removeHostFd(fd);
+    Sim_runCommands();
+    return;
+  }
+  if (count > 0) {
+    commandsUsed += (size_t)count;
+    Sim_runCommands();
+  }
+}
+
+static void Sim_runFirmware(void) { firmware_main(); }
+
+static bool Sim_serialOption(const char* option, const char* value) {
+  int module;
+
+  if (sscanf(option, "--uart%d", &module) == 1 && module >= 0 &&
+      module < SERIAL_NUM_MODULES) {
+    return Serial_openPty(module, value);
+  }
+  if (sscanf(option, "--attach%d", &module) == 1 && module >= 0 &&
+      module < SERIAL_NUM_MODULES) {
+    return Serial_attach(module, value);
+  }
+  Sim_usage();
+  return false;
+}
+
+int main(int argc, char** argv) {
+  double speed = 1.0, cpuScale = 0.0;
+  uint64_t runForMs = 0;
+  int i;
+
+  // Parse the timing options first, as the models need the machine
+  for (i = 1; i < argc; i++) {
+    const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+
+    if (strcmp(argv[i], "--quiet") == 0) {
+      quiet = true;
+      continue;
+    }
+    if (value == NULL || strncmp(argv[i], "--", 2) != 0) {
+      Sim_usage();
+    }
+    if (strcmp(argv[i], "--speed") == 0) {
+      speed = atof(value);
+    } else if (strcmp(argv[i], "--cpu-scale") == 0) {
+      cpuScale = atof(value);
+    } else if (strcmp(argv[i], "--run-for") == 0) {
+      runForMs = strtoull(value, NULL, 10);
+    } else if (strcmp(argv[i], "--lcd") == 0) {
+      lcdPath = value;
+    } else if (strncmp(argv[i], "--uart", 6) != 0 &&
+               strncmp(argv[i], "--attach", 8) != 0) {
+      Sim_usage();
+    }
+    i++;
+  }
+
+  Machine_init(speed, cpuScale);
+  Pins_init();
+  Timers_init();
+  Serial_init();
+  Panel_init();
+  System_init(argv);
+
+  for (i = 1; i < argc; i++) {
+    if (strncmp(argv[i], "--uart", 6) == 0 ||
+        strncmp(argv[i], "--attach", 8) == 0) {
+      if (!Sim_serialOption(argv[i], argv[i + 1])) {
+        exit(1);
+      }
+    }
+    if (strcmp(argv[i], "--quiet") != 0) {
+      i++;
+    }
+  }
+
+  atexit(Sim_atExit);
+
+  Machine_addEvent(&runForEvent, Sim_runForEnded, NULL);
+  Machine_addEvent(&waitEvent, Sim_waitEnded, NULL);
+  Machine_addEvent(&releaseEvent, Sim_tapEnded, NULL);
+  if (runForMs > 0) {
+    // The run time counts from the first start, across resets
+    uint64_t end = runForMs * MACHINE_PS_PER_MS;
+    Machine_schedule(&runForEvent, end > Machine_stats.timePS
+                                       ? end - Machine_stats.timePS
+                                       : 0);
+  }
+  Machine_addHostFd(STDIN_FILENO, Sim_stdinReady, NULL);
+
+  getcontext(&firmwareContext);
+  firmwareContext.uc_stack.ss_sp = Machine_stack;
+  firmwareContext.uc_stack.ss_size = sizeof(Machine_stack);
+  firmwareContext.uc_link = &hostContext;
+  makecontext(&firmwareContext, Sim_runFirmware, 0);
+
+  if (swapcontext(&hostContext, &firmwareContext) != 0) {
+    fprintf(stderr, "sim: cannot start the firmware: %s\n", strerror(errno));
+    return 1;
+  }
+
+  fprintf(stderr, "sim: main() returned\n");
+  return 0;
+}
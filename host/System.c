@@ -0,0 +1,356 @@
+/*
+ * System.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+// The core of the chip around the peripherals: the interrupt controller, the
+// clock system with the flash wait states it needs, the power modes, the
+// reset, the delay loop of the LCD driver, and the CRC32 and AES256
+// accelerators.
+
+#define _GNU_SOURCE
+#include "System.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "Serial.h"
+#include "Timers.h"
+
+// Flash wait states the clock needs, from the flash timing table of the
+// MSP432P401R datasheet for the VCORE1 level
+#define SYSTEM_FLASH_0WS_MAX_HZ 16000000
+#define SYSTEM_FLASH_1WS_MAX_HZ 32000000
+
+// MCLK cycles the AES256 module takes to encrypt a block
+#define SYSTEM_AES_CYCLES 168
+
+#define SYSTEM_NUM_FLASH_BANKS 2
+
+static char** programArgv;
+
+/** The DCO, and what MCLK and SMCLK are fed from */
+static uint32_t dcoHz = MACHINE_RESET_DCO_HZ;
+static uint32_t mclkSource = CS_DCOCLK_SELECT;
+static uint32_t smclkSource = CS_DCOCLK_SELECT;
+static uint32_t aclkSource = CS_REFOCLK_SELECT;
+static uint32_t waitStates[SYSTEM_NUM_FLASH_BANKS];
+
+static uint32_t crc;
+static uint32_t aesRoundKeys[60];
+
+/******************************************************************************
+ * Interrupts
+ ******************************************************************************/
+
+void Interrupt_enableInterrupt(uint32_t interruptNumber) {
+  MACHINE_ENTER();
+  Machine_setVectorEnabled((int)interruptNumber, true);
+}
+
+void Interrupt_disableInterrupt(uint32_t interruptNumber) {
+  MACHINE_ENTER();
+  Machine_setVectorEnabled((int)interruptNumber, false);
+}
+
+/**
+ * Both return whether interrupts were disabled before, as PRIMASK tells.
+ */
+bool Interrupt_enableMaster(void) {
+  bool wasDisabled = !Machine_masterEnabled();
+
+  MACHINE_ENTER();
+  Machine_setMasterEnabled(true);
+  return wasDisabled;
+}
+
+bool Interrupt_disableMaster(void) {
+  bool wasDisabled = !Machine_masterEnabled();
+
+  MACHINE_ENTER();
+  Machine_setMasterEnabled(false);
+  return wasDisabled;
+}
+
+/******************************************************************************
+ * Clocks and flash
+ ******************************************************************************/
+
+static uint32_t System_sourceHz(uint32_t source) {
+  return source == CS_REFOCLK_SELECT ? MACHINE_ACLK_HZ : dcoHz;
+}
+
+/**
+ * Warns when MCLK runs faster than the flash wait states allow. On the board
+ * this makes the CPU fetch garbage.
+ */
+static void System_checkWaitStates(void) {
+  uint32_t hz = System_sourceHz(mclkSource);
+  uint32_t needed = hz > SYSTEM_FLASH_1WS_MAX_HZ   ? 2
+                    : hz > SYSTEM_FLASH_0WS_MAX_HZ ? 1
+                                                   : 0;
+  int bank;
+
+  for (bank = 0; bank < SYSTEM_NUM_FLASH_BANKS; bank++) {
+    if (waitStates[bank] < needed) {
+      Machine_warn("flash: bank %d has %u wait states at %u Hz, which needs "
+                   "%u",
+                   bank, waitStates[bank], hz, needed);
+    }
+  }
+}
+
+static void System_clocksChanged(void) {
+  uint32_t hz = System_sourceHz(mclkSource);
+
+  if (hz != Machine_mclkHz()) {
+    Timers_setMclk(hz);
+  }
+  System_checkWaitStates();
+}
+
+uint32_t System_smclkHz(void) { return System_sourceHz(smclkSource); }
+
+void CS_setDCOFrequency(uint32_t dcoFrequency) {
+  MACHINE_ENTER();
+  dcoHz = dcoFrequency;
+  System_clocksChanged();
+}
+
+void CS_initClockSignal(uint32_t selectedClockSignal, uint32_t clockSource,
+                        uint32_t clockSourceDivider) {
+  MACHINE_ENTER();
+  if (clockSourceDivider != CS_CLOCK_DIVIDER_1) {
+    Machine_warn("cs: only undivided clocks are modelled");
+  }
+
+  if (selectedClockSignal == CS_MCLK) {
+    mclkSource = clockSource;
+  } else if (selectedClockSignal == CS_SMCLK) {
+    smclkSource = clockSource;
+  } else if (selectedClockSignal == CS_ACLK) {
+    aclkSource = clockSource;
+  }
+  System_clocksChanged();
+}
+
+uint32_t CS_getMCLK(void) {
+  MACHINE_ENTER();
+  return System_sourceHz(mclkSource);
+}
+
+uint32_t CS_getSMCLK(void) {
+  MACHINE_ENTER();
+  return System_sourceHz(smclkSource);
+}
+
+uint32_t CS_getACLK(void) {
+  MACHINE_ENTER();
+  return System_sourceHz(aclkSource);
+}
+
+bool FlashCtl_setWaitState(uint32_t bank, uint32_t waitState) {
+  MACHINE_ENTER();
+  waitStates[bank == FLASH_BANK1] = waitState;
+  System_checkWaitStates();
+  return true;
+}
+
+/******************************************************************************
+ * Power, watchdog and reset
+ ******************************************************************************/
+
+bool PCM_gotoLPM0(void) {
+  MACHINE_ENTER();
+  return Machine_sleep(MACHINE_LPM0);
+}
+
+bool PCM_gotoLPM3(void) {
+  MACHINE_ENTER();
+  return Machine_sleep(MACHINE_LPM3);
+}
+
+void WDT_A_holdTimer(void) { MACHINE_ENTER(); }
+
+void System_saveForReset(void) {
+  Machine_saveStats();
+  Serial_saveFds();
+}
+
+/**
+ * Resets the board by executing the simulator again. The terminals stay
+ * connected, as the USB bridge of the board stays powered.
+ */
+void ResetCtl_initiateHardReset(void) {
+  MACHINE_ENTER();
+  Machine_stats.resets++;
+  System_saveForReset();
+  fflush(NULL);
+  execv("/proc/self/exe", programArgv);
+
+  fprintf(stderr, "sim: cannot reset: exec failed\n");
+  Machine_exit(1);
+}
+
+/**
+ * The delay loop of the LCD driver. The board's firmware is built by CCS,
+ * where HAL_LCD_delay() is the __delay_cycles() intrinsic, so the delay takes
+ * the number of cycles it is given.
+ */
+void SysCtlDelay(uint32_t ui32Count) {
+  MACHINE_ENTER();
+  Machine_spend(ui32Count);
+}
+
+/******************************************************************************
+ * CRC32
+ ******************************************************************************/
+
+/**
+ * The module computes the reflected CRC-32 of zlib. The register holds it
+ * without the final inversion, which the firmware applies.
+ */
+void CRC32_setSeed(uint32_t seed, uint_fast8_t crcType) {
+  MACHINE_ENTER();
+  (void)crcType;
+  crc = seed;
+}
+
+void CRC32_set8BitData(uint8_t dataIn, uint_fast8_t crcType) {
+  int bit;
+
+  MACHINE_ENTER();
+  (void)crcType;
+  crc ^= dataIn;
+  for (bit = 0; bit < 8; bit++) {
+    crc = crc & 1 ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+  }
+}
+
+uint32_t CRC32_getResultReversed(uint_fast8_t crcType) {
+  MACHINE_ENTER();
+  (void)crcType;
+  return crc;
+}
+
+/******************************************************************************
+ * AES256
+ ******************************************************************************/
+
+static const uint8_t sbox[256] = {
+    0x63, 0x7C, 0x77, 0x7B, 0xF2, 0x6B, 0x6F, 0xC5, 0x30, 0x01, 0x67, 0x2B,
+    0xFE, 0xD7, 0xAB, 0x76, 0xCA, 0x82, 0xC9, 0x7D, 0xFA, 0x59, 0x47, 0xF0,
+    0xAD, 0xD4, 0xA2, 0xAF, 0x9C, 0xA4, 0x72, 0xC0, 0xB7, 0xFD, 0x93, 0x26,
+    0x36, 0x3F, 0xF7, 0xCC, 0x34, 0xA5, 0xE5, 0xF1, 0x71, 0xD8, 0x31, 0x15,
+    0x04, 0xC7, 0x23, 0xC3, 0x18, 0x96, 0x05, 0x9A, 0x07, 0x12, 0x80, 0xE2,
+    0xEB, 0x27, 0xB2, 0x75, 0x09, 0x83, 0x2C, 0x1A, 0x1B, 0x6E, 0x5A, 0xA0,
+    0x52, 0x3B, 0xD6, 0xB3, 0x29, 0xE3, 0x2F, 0x84, 0x53, 0xD1, 0x00, 0xED,
+    0x20, 0xFC, 0xB1, 0x5B, 0x6A, 0xCB, 0xBE, 0x39, 0x4A, 0x4C, 0x58, 0xCF,
+    0xD0, 0xEF, 0xAA, 0xFB, 0x43, 0x4D, 0x33, 0x85, 0x45, 0xF9, 0x02, 0x7F,
+    0x50, 0x3C, 0x9F, 0xA8, 0x51, 0xA3, 0x40, 0x8F, 0x92, 0x9D, 0x38, 0xF5,
+    0xBC, 0xB6, 0xDA, 0x21, 0x10, 0xFF, 0xF3, 0xD2, 0xCD, 0x0C, 0x13, 0xEC,
+    0x5F, 0x97, 0x44, 0x17, 0xC4, 0xA7, 0x7E, 0x3D, 0x64, 0x5D, 0x19, 0x73,
+    0x60, 0x81, 0x4F, 0xDC, 0x22, 0x2A, 0x90, 0x88, 0x46, 0xEE, 0xB8, 0x14,
+    0xDE, 0x5E, 0x0B, 0xDB, 0xE0, 0x32, 0x3A, 0x0A, 0x49, 0x06, 0x24, 0x5C,
+    0xC2, 0xD3, 0xAC, 0x62, 0x91, 0x95, 0xE4, 0x79, 0xE7, 0xC8, 0x37, 0x6D,
+    0x8D, 0xD5, 0x4E, 0xA9, 0x6C, 0x56, 0xF4, 0xEA, 0x65, 0x7A, 0xAE, 0x08,
+    0xBA, 0x78, 0x25, 0x2E, 0x1C, 0xA6, 0xB4, 0xC6, 0xE8, 0xDD, 0x74, 0x1F,
+    0x4B, 0xBD, 0x8B, 0x8A, 0x70, 0x3E, 0xB5, 0x66, 0x48, 0x03, 0xF6, 0x0E,
+    0x61, 0x35, 0x57, 0xB9, 0x86, 0xC1, 0x1D, 0x9E, 0xE1, 0xF8, 0x98, 0x11,
+    0x69, 0xD9, 0x8E, 0x94, 0x9B, 0x1E, 0x87, 0xE9, 0xCE, 0x55, 0x28, 0xDF,
+    0x8C, 0xA1, 0x89, 0x0D, 0xBF, 0xE6, 0x42, 0x68, 0x41, 0x99, 0x2D, 0x0F,
+    0xB0, 0x54, 0xBB, 0x16};
+
+static uint32_t System_subWord(uint32_t word) {
+  return (uint32_t)sbox[word >> 24] << 24 |
+         (uint32_t)sbox[(word >> 16) & 0xFF] << 16 |
+         (uint32_t)sbox[(word >> 8) & 0xFF] << 8 | sbox[word & 0xFF];
+}
+
+static uint8_t System_xtime(uint8_t value) {
+  return (uint8_t)(value << 1 ^ (value & 0x80 ? 0x1B : 0));
+}
+
+bool AES256_setCipherKey(uint32_t moduleInstance, const uint8_t* cipherKey,
+                         uint_fast16_t keyLength) {
+  uint8_t rcon = 1;
+  int i;
+
+  MACHINE_ENTER();
+  (void)moduleInstance;
+  if (keyLength != AES256_KEYLENGTH_256BIT) {
+    Machine_warn("aes: only 256 bit keys are modelled");
+    return false;
+  }
+
+  for (i = 0; i < 8; i++) {
+    aesRoundKeys[i] = (uint32_t)cipherKey[4 * i] << 24 |
+                      (uint32_t)cipherKey[4 * i + 1] << 16 |
+                      (uint32_t)cipherKey[4 * i + 2] << 8 | cipherKey[4 * i + 3];
+  }
+  for (i = 8; i < 60; i++) {
+    uint32_t word = aesRoundKeys[i - 1];
+
+    if (i % 8 == 0) {
+      word = System_subWord(word << 8 | word >> 24) ^ (uint32_t)rcon << 24;
+      rcon = System_xtime(rcon);
+    } else if (i % 8 == 4) {
+      word = System_subWord(word);
+    }
+    aesRoundKeys[i] = aesRoundKeys[i - 8] ^ word;
+  }
+  return true;
+}
+
+static void System_addRoundKey(uint8_t state[16], int round) {
+  int i;
+
+  for (i = 0; i < 16; i++) {
+    state[i] ^= (uint8_t)(aesRoundKeys[4 * round + i / 4] >> (24 - 8 * (i % 4)));
+  }
+}
+
+void AES256_encryptData(uint32_t moduleInstance, const uint8_t* data,
+                        uint8_t* encryptedData) {
+  uint8_t state[16];
+  int round, i;
+
+  MACHINE_ENTER();
+  (void)moduleInstance;
+  memcpy(state, data, sizeof(state));
+  System_addRoundKey(state, 0);
+
+  for (round = 1; round <= 14; round++) {
+    uint8_t shifted[16];
+
+    // SubBytes and ShiftRows; the state is stored column by column
+    for (i = 0; i < 16; i++) {
+      shifted[i] = sbox[state[(i + 4 * (i % 4)) % 16]];
+    }
+
+    // MixColumns, except in the last round
+    for (i = 0; i < 4 && round < 14; i++) {
+      uint8_t* column = &shifted[4 * i];
+      uint8_t all = column[0] ^ column[1] ^ column[2] ^ column[3];
+      uint8_t first = column[0];
+
+      column[0] ^= all ^ System_xtime(column[0] ^ column[1]);
+      column[1] ^= all ^ System_xtime(column[1] ^ column[2]);
+      column[2] ^= all ^ System_xtime(column[2] ^ column[3]);
+      column[3] ^= all ^ System_xtime(column[3] ^ first);
+    }
+
+    memcpy(state, shifted, sizeof(state));
+    System_addRoundKey(state, round);
+  }
+
+  memcpy(encryptedData, state, sizeof(state));
+  Machine_spend(SYSTEM_AES_CYCLES);
+}
+
+void System_init(char** argv) {
+  programArgv = argv;
+  Machine_setMclkHz(dcoHz);
+}
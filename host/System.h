@@ -0,0 +1,23 @@
+/*
+ * System.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef HOST_SYSTEM_H_
+#define HOST_SYSTEM_H_
+
+#include "Machine.h"
+
+/** The frequency of SMCLK, which the eUSCI modules count */
+uint32_t System_smclkHz(void);
+
+/**
+ * Keeps what survives a reset of the board in the environment: the
+ * terminals of the host, which stay connected, and the session counters.
+ */
+void System_saveForReset(void);
+
+void System_init(char** argv);
+
+#endif /* HOST_SYSTEM_H_ */
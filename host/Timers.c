@@ -0,0 +1,608 @@
+/*
+ * Timers.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+// Timer32, Timer_A1, SysTick and RTC_C. A timer holds its count at the last
+// time it was looked at (its base) and derives the count at any later time
+// from the clock it counts; the interrupt it raises next is an event. Timer32
+// and SysTick count MCLK, which stops in LPM3. Timer_A1 counts ACLK, but like
+// every Timer_A it is off in LPM3. RTC_C counts BCLK and is the only one
+// which keeps running in LPM3 and wakes the board from it; the WDT_A, the
+// other module which could, is held by the firmware.
+
+#include "Timers.h"
+
+#define TIMERS_NUM_TIMER32 2
+#define TIMERS_TIMER32_SPACING (TIMER32_1_BASE - TIMER32_0_BASE)
+
+/** Timer_A1 is a 16 bit timer */
+#define TIMERS_TA_CCR0_MAX 0xFFFF
+
+typedef struct {
+  uint32_t load;
+  uint32_t mask;
+  uint32_t divider;
+  bool periodic;
+  bool oneShot;
+  bool running;
+  bool interruptEnabled;
+  bool interruptFlag;
+
+  /** The count at baseTime, and whether the timer counted from then on */
+  uint32_t baseValue;
+  uint64_t baseTime;
+  bool counting;
+
+  MachineEvent wrap;
+} Timer32Model;
+
+static Timer32Model timer32s[TIMERS_NUM_TIMER32];
+
+typedef struct {
+  uint32_t ccr0;
+  uint32_t divider;
+  bool clockAclk;
+  bool running;
+  bool ccie;
+  bool ccifg;
+
+  /** The count at baseTime, and whether the timer counted from then on */
+  uint32_t baseCount;
+  uint64_t baseTime;
+  bool counting;
+
+  MachineEvent compare;
+} TimerAModel;
+
+static TimerAModel timerA1;
+
+typedef struct {
+  uint32_t period;
+  bool running;
+  bool interruptEnabled;
+  bool pending;
+  uint64_t baseTime;
+
+  MachineEvent wrap;
+} SysTickModel;
+
+static SysTickModel sysTick;
+
+/** The two prescale timers of RTC_C */
+#define TIMERS_RTC_NUM_PRESCALERS 2
+
+/** RT0PS divides BCLK by 256 for RT1PS */
+#define TIMERS_RTC_RT1PS_TICKS 256
+
+/** BCLK ticks per second, which is what RT1PS divides down to the calendar */
+#define TIMERS_RTC_SECOND_TICKS 32768
+
+typedef struct {
+  bool running;
+
+  /** BCLK ticks between the interval events of each prescale timer */
+  uint32_t intervals[TIMERS_RTC_NUM_PRESCALERS];
+  uint8_t interruptsEnabled;
+  uint8_t interruptFlags;
+
+  /** BCLK ticks counted up to baseTime */
+  uint64_t baseTicks;
+  uint64_t baseTime;
+
+  MachineEvent events[TIMERS_RTC_NUM_PRESCALERS];
+} RtcModel;
+
+static RtcModel rtc;
+
+/** The interrupt flag of each prescale timer */
+static const uint8_t rtcFlags[TIMERS_RTC_NUM_PRESCALERS] = {
+    RTC_C_PRESCALE_TIMER0_INTERRUPT, RTC_C_PRESCALE_TIMER1_INTERRUPT};
+
+/******************************************************************************
+ * Timer32
+ ******************************************************************************/
+
+static Timer32Model* Timers_timer32(uint32_t timer) {
+  return &timer32s[(timer - TIMER32_0_BASE) / TIMERS_TIMER32_SPACING];
+}
+
+/** Whether a Timer32 counts, which it does only while MCLK runs */
+static bool Timers_timer32Counting(const Timer32Model* timer_p) {
+  return timer_p->running && Machine_mode() != MACHINE_LPM3;
+}
+
+static uint32_t Timers_timer32Hz(const Timer32Model* timer_p) {
+  return Machine_mclkHz() / timer_p->divider;
+}
+
+/** The value a Timer32 reloads with when it counts past 0 */
+static uint32_t Timers_timer32Reload(const Timer32Model* timer_p) {
+  return timer_p->periodic ? timer_p->load : timer_p->mask;
+}
+
+static uint32_t Timers_timer32Value(const Timer32Model* timer_p) {
+  uint64_t counts, period;
+
+  if (!timer_p->counting) {
+    return timer_p->baseValue;
+  }
+
+  counts = Machine_psToCycles(Machine_now() - timer_p->baseTime,
+                              Timers_timer32Hz(timer_p));
+  if (counts <= timer_p->baseValue) {
+    return timer_p->baseValue - (uint32_t)counts;
+  }
+  if (timer_p->oneShot) {
+    return 0;
+  }
+
+  period = (uint64_t)Timers_timer32Reload(timer_p) + 1;
+  counts -= (uint64_t)timer_p->baseValue + 1;
+  return Timers_timer32Reload(timer_p) - (uint32_t)(counts % period);
+}
+
+/**
+ * Takes the count of a Timer32 as its new base, before its clock changes or
+ * it starts or stops counting, and schedules its next wrap.
+ */
+static void Timers_rebaseTimer32(Timer32Model* timer_p, uint32_t value) {
+  timer_p->baseValue = value;
+  timer_p->baseTime = Machine_now();
+  timer_p->counting = Timers_timer32Counting(timer_p);
+
+  if (timer_p->counting) {
+    Machine_schedule(&timer_p->wrap,
+                     Machine_now() +
+                         Machine_cyclesToPS((uint64_t)value + 1,
+                                            Timers_timer32Hz(timer_p)));
+  } else {
+    Machine_cancel(&timer_p->wrap);
+  }
+}
+
+/**
+ * A Timer32 counted past 0 and reloaded, which raises its interrupt. A one
+ * shot timer stops at 0 instead.
+ */
+static void Timers_timer32Wrapped(MachineEvent* event_p) {
+  Timer32Model* timer_p = (Timer32Model*)event_p->context_p;
+
+  timer_p->interruptFlag = true;
+  if (timer_p->oneShot) {
+    timer_p->running = false;
+    Timers_rebaseTimer32(timer_p, 0);
+  } else {
+    Timers_rebaseTimer32(timer_p, Timers_timer32Reload(timer_p));
+  }
+}
+
+static bool Timers_timer32Line(void) {
+  return timer32s[0].interruptFlag && timer32s[0].interruptEnabled;
+}
+
+void Timer32_initModule(uint32_t timer, uint32_t preScaler,
+                        uint32_t resolution, uint32_t mode) {
+  Timer32Model* timer_p = Timers_timer32(timer);
+  uint32_t value;
+
+  MACHINE_ENTER();
+  value = Timers_timer32Value(timer_p);
+  timer_p->divider = preScaler == TIMER32_PRESCALER_256  ? 256
+                     : preScaler == TIMER32_PRESCALER_16 ? 16
+                                                         : 1;
+  timer_p->mask = resolution == TIMER32_32BIT ? 0xFFFFFFFF : 0xFFFF;
+  timer_p->periodic = mode == TIMER32_PERIODIC_MODE;
+  Timers_rebaseTimer32(timer_p, value & timer_p->mask);
+}
+
+void Timer32_setCount(uint32_t timer, uint32_t count) {
+  Timer32Model* timer_p = Timers_timer32(timer);
+
+  MACHINE_ENTER();
+  timer_p->load = count & timer_p->mask;
+  Timers_rebaseTimer32(timer_p, timer_p->load);
+}
+
+void Timer32_startTimer(uint32_t timer, bool oneShot) {
+  Timer32Model* timer_p = Timers_timer32(timer);
+  uint32_t value;
+
+  MACHINE_ENTER();
+  value = Timers_timer32Value(timer_p);
+  timer_p->oneShot = oneShot;
+  timer_p->running = true;
+  Timers_rebaseTimer32(timer_p, value);
+}
+
+void Timer32_haltTimer(uint32_t timer) {
+  Timer32Model* timer_p = Timers_timer32(timer);
+  uint32_t value;
+
+  MACHINE_ENTER();
+  value = Timers_timer32Value(timer_p);
+  timer_p->running = false;
+  Timers_rebaseTimer32(timer_p, value);
+}
+
+uint32_t Timer32_getValue(uint32_t timer) {
+  MACHINE_ENTER();
+  return Timers_timer32Value(Timers_timer32(timer));
+}
+
+void Timer32_clearInterruptFlag(uint32_t timer) {
+  MACHINE_ENTER();
+  Timers_timer32(timer)->interruptFlag = false;
+}
+
+/******************************************************************************
+ * Timer_A1
+ ******************************************************************************/
+
+static uint32_t Timers_timerAHz(void) {
+  return timerA1.clockAclk ? MACHINE_ACLK_HZ : Machine_mclkHz();
+}
+
+static uint32_t Timers_timerACount(void) {
+  uint64_t ticks;
+
+  if (!timerA1.counting) {
+    return timerA1.baseCount;
+  }
+
+  ticks = Machine_psToCycles(Machine_now() - timerA1.baseTime,
+                             Timers_timerAHz()) /
+          timerA1.divider;
+  return (uint32_t)((timerA1.baseCount + ticks) % (timerA1.ccr0 + 1));
+}
+
+/**
+ * Takes a count of Timer_A1 as its new base and schedules the next time it
+ * counts to CCR0. It only counts while it runs and the board is not in LPM3.
+ */
+static void Timers_rebaseTimerA(uint32_t count) {
+  uint64_t ticks;
+
+  timerA1.baseCount = count;
+  timerA1.baseTime = Machine_now();
+  timerA1.counting = timerA1.running && Machine_mode() != MACHINE_LPM3;
+
+  if (!timerA1.counting) {
+    Machine_cancel(&timerA1.compare);
+    return;
+  }
+
+  ticks = count < timerA1.ccr0 ? timerA1.ccr0 - count
+                               : (uint64_t)timerA1.ccr0 + 1;
+  Machine_schedule(&timerA1.compare,
+                   Machine_now() + Machine_cyclesToPS(ticks * timerA1.divider,
+                                                      Timers_timerAHz()));
+}
+
+static void Timers_timerACompared(MachineEvent* event_p) {
+  (void)event_p;
+  timerA1.ccifg = true;
+  Timers_rebaseTimerA(timerA1.ccr0);
+}
+
+static bool Timers_timerALine(void) { return timerA1.ccifg && timerA1.ccie; }
+
+void Timer_A_configureUpMode(uint32_t timer,
+                             const Timer_A_UpModeConfig* config) {
+  uint32_t count;
+
+  MACHINE_ENTER();
+  (void)timer;
+  count = Timers_timerACount();
+
+  timerA1.clockAclk = config->clockSource == TIMER_A_CLOCKSOURCE_ACLK;
+  timerA1.divider = config->clockSourceDivider;
+  timerA1.ccr0 = config->timerPeriod & TIMERS_TA_CCR0_MAX;
+  timerA1.ccie = config->captureCompareInterruptEnable_CCR0_CCIE ==
+                 TIMER_A_CCIE_CCR0_INTERRUPT_ENABLE;
+  if (config->timerClear == TIMER_A_DO_CLEAR) {
+    count = 0;
+  }
+  Timers_rebaseTimerA(count);
+}
+
+void Timer_A_startCounter(uint32_t timer, uint_fast16_t timerMode) {
+  uint32_t count;
+
+  MACHINE_ENTER();
+  (void)timer;
+  count = Timers_timerACount();
+  timerA1.running = timerMode == TIMER_A_UP_MODE;
+  Timers_rebaseTimerA(count);
+}
+
+void Timer_A_stopTimer(uint32_t timer) {
+  uint32_t count;
+
+  MACHINE_ENTER();
+  (void)timer;
+  count = Timers_timerACount();
+  timerA1.running = false;
+  Timers_rebaseTimerA(count);
+}
+
+uint_fast16_t Timer_A_getCounterValue(uint32_t timer) {
+  MACHINE_ENTER();
+  (void)timer;
+  return (uint_fast16_t)Timers_timerACount();
+}
+
+uint32_t Timer_A_getCaptureCompareInterruptStatus(
+    uint32_t timer, uint_fast16_t captureCompareRegister, uint_fast16_t mask) {
+  MACHINE_ENTER();
+  (void)timer;
+  (void)captureCompareRegister;
+  return timerA1.ccifg ? mask & TIMER_A_CAPTURECOMPARE_INTERRUPT_FLAG : 0;
+}
+
+void Timer_A_clearCaptureCompareInterrupt(
+    uint32_t timer, uint_fast16_t captureCompareRegister) {
+  MACHINE_ENTER();
+  (void)timer;
+  (void)captureCompareRegister;
+  timerA1.ccifg = false;
+}
+
+/******************************************************************************
+ * SysTick
+ ******************************************************************************/
+
+static void Timers_scheduleSysTick(void) {
+  sysTick.baseTime = Machine_now();
+
+  if (sysTick.running && sysTick.period != 0 &&
+      Machine_mode() != MACHINE_LPM3) {
+    Machine_schedule(&sysTick.wrap,
+                     Machine_now() +
+                         Machine_cyclesToPS(sysTick.period, Machine_mclkHz()));
+  } else {
+    Machine_cancel(&sysTick.wrap);
+  }
+}
+
+static void Timers_sysTickWrapped(MachineEvent* event_p) {
+  (void)event_p;
+  sysTick.pending = sysTick.interruptEnabled;
+  Timers_scheduleSysTick();
+}
+
+static bool Timers_sysTickLine(void) { return sysTick.pending; }
+
+/**
+ * The SysTick exception. On the board the profiler's handler reads the PC
+ * and LR stacked by the exception; here they are the place the firmware
+ * last called into the hardware from, and the caller of that function.
+ */
+void Profiler_sample(uint32_t pc, uint32_t lr);
+
+void SysTick_Handler(void) {
+  sysTick.pending = false;
+  Profiler_sample((uint32_t)Machine_pc, (uint32_t)Machine_lr);
+}
+
+void SysTick_enableModule(void) {
+  MACHINE_ENTER();
+  sysTick.running = true;
+  Timers_scheduleSysTick();
+}
+
+void SysTick_disableModule(void) {
+  MACHINE_ENTER();
+  sysTick.running = false;
+  Timers_scheduleSysTick();
+}
+
+void SysTick_enableInterrupt(void) {
+  MACHINE_ENTER();
+  sysTick.interruptEnabled = true;
+}
+
+void SysTick_disableInterrupt(void) {
+  MACHINE_ENTER();
+  sysTick.interruptEnabled = false;
+  sysTick.pending = false;
+}
+
+void SysTick_setPeriod(uint32_t period) {
+  MACHINE_ENTER();
+  sysTick.period = period;
+  Timers_scheduleSysTick();
+}
+
+/******************************************************************************
+ * RTC_C
+ ******************************************************************************/
+
+static uint64_t Timers_rtcTicks(void) {
+  if (!rtc.running) {
+    return rtc.baseTicks;
+  }
+  return rtc.baseTicks +
+         Machine_psToCycles(Machine_now() - rtc.baseTime, MACHINE_ACLK_HZ);
+}
+
+/**
+ * Schedules the next interval event of a prescale timer. An interval flag is
+ * only modelled while its interrupt is enabled, which is all the firmware
+ * looks at.
+ */
+static void Timers_scheduleRtc(int prescaler) {
+  uint32_t interval = rtc.intervals[prescaler];
+  uint64_t next;
+
+  if (!rtc.running || !(rtc.interruptsEnabled & rtcFlags[prescaler])) {
+    Machine_cancel(&rtc.events[prescaler]);
+    return;
+  }
+
+  next = (Timers_rtcTicks() / interval + 1) * interval;
+  Machine_schedule(&rtc.events[prescaler],
+                   rtc.baseTime + Machine_cyclesToPS(next - rtc.baseTicks,
+                                                     MACHINE_ACLK_HZ));
+}
+
+/** Takes the count of RTC_C as its new base and schedules its events */
+static void Timers_rebaseRtc(void) {
+  int i;
+
+  rtc.baseTicks = Timers_rtcTicks();
+  rtc.baseTime = Machine_now();
+  for (i = 0; i < TIMERS_RTC_NUM_PRESCALERS; i++) {
+    Timers_scheduleRtc(i);
+  }
+}
+
+static void Timers_rtcInterval(MachineEvent* event_p) {
+  int prescaler = (int)(intptr_t)event_p->context_p;
+
+  rtc.interruptFlags |= rtcFlags[prescaler];
+  Timers_scheduleRtc(prescaler);
+}
+
+static bool Timers_rtcLine(void) {
+  return (rtc.interruptFlags & rtc.interruptsEnabled) != 0;
+}
+
+void RTC_C_startClock(void) {
+  MACHINE_ENTER();
+  rtc.baseTicks = Timers_rtcTicks();
+  rtc.running = true;
+  Timers_rebaseRtc();
+}
+
+void RTC_C_holdClock(void) {
+  MACHINE_ENTER();
+  rtc.baseTicks = Timers_rtcTicks();
+  rtc.running = false;
+  Timers_rebaseRtc();
+}
+
+/**
+ * The calendar counts from midnight of the reset values, in binary
+ */
+RTC_C_Calendar RTC_C_getCalendarTime(void) {
+  RTC_C_Calendar calendar = {0};
+  uint64_t seconds;
+
+  MACHINE_ENTER();
+  seconds = Timers_rtcTicks() / TIMERS_RTC_SECOND_TICKS;
+  calendar.seconds = (uint_fast8_t)(seconds % 60);
+  calendar.minutes = (uint_fast8_t)(seconds / 60 % 60);
+  calendar.hours = (uint_fast8_t)(seconds / 3600 % 24);
+  return calendar;
+}
+
+void RTC_C_definePrescaleEvent(uint_fast8_t prescaleSelect,
+                               uint_fast8_t prescaleEventDivider) {
+  int prescaler = prescaleSelect == RTC_C_PRESCALE_1;
+  uint32_t interval = 2u << (prescaleEventDivider / RTC_C_PSEVENTDIVIDER_4);
+
+  MACHINE_ENTER();
+  rtc.intervals[prescaler] =
+      prescaler == 1 ? interval * TIMERS_RTC_RT1PS_TICKS : interval;
+  Timers_scheduleRtc(prescaler);
+}
+
+uint_fast8_t RTC_C_getPrescaleValue(uint_fast8_t prescaleSelect) {
+  uint64_t ticks;
+
+  MACHINE_ENTER();
+  ticks = Timers_rtcTicks();
+  return (uint_fast8_t)(prescaleSelect == RTC_C_PRESCALE_1
+                            ? ticks / TIMERS_RTC_RT1PS_TICKS
+                            : ticks);
+}
+
+void RTC_C_enableInterrupt(uint8_t interruptMask) {
+  MACHINE_ENTER();
+  rtc.interruptsEnabled |= interruptMask;
+  Timers_rebaseRtc();
+}
+
+void RTC_C_disableInterrupt(uint8_t interruptMask) {
+  MACHINE_ENTER();
+  rtc.interruptsEnabled &= (uint8_t)~interruptMask;
+  Timers_rebaseRtc();
+}
+
+uint_fast8_t RTC_C_getInterruptStatus(void) {
+  MACHINE_ENTER();
+  return rtc.interruptFlags;
+}
+
+void RTC_C_clearInterruptFlag(uint_fast8_t interruptFlagMask) {
+  MACHINE_ENTER();
+  rtc.interruptFlags &= (uint8_t)~interruptFlagMask;
+}
+
+/******************************************************************************
+ * Clocks
+ ******************************************************************************/
+
+/**
+ * Rebases the timers which count MCLK, so that the counts up to now follow
+ * the old clock or power mode and the counts from now on the new one.
+ */
+static void Timers_rebaseMclk(void) {
+  int i;
+
+  for (i = 0; i < TIMERS_NUM_TIMER32; i++) {
+    Timers_rebaseTimer32(&timer32s[i], Timers_timer32Value(&timer32s[i]));
+  }
+  Timers_scheduleSysTick();
+}
+
+void Timers_setMclk(uint32_t hz) {
+  uint32_t values[TIMERS_NUM_TIMER32];
+  int i;
+
+  for (i = 0; i < TIMERS_NUM_TIMER32; i++) {
+    values[i] = Timers_timer32Value(&timer32s[i]);
+  }
+  Machine_setMclkHz(hz);
+  for (i = 0; i < TIMERS_NUM_TIMER32; i++) {
+    Timers_rebaseTimer32(&timer32s[i], values[i]);
+  }
+  Timers_scheduleSysTick();
+}
+
+/**
+ * Called by the machine when it enters or leaves a sleep, which stops or
+ * starts MCLK, and in LPM3 also Timer_A1.
+ */
+void Timers_modeChanged(MachineMode mode) {
+  (void)mode;
+  Timers_rebaseMclk();
+  Timers_rebaseTimerA(Timers_timerACount());
+}
+
+void Timers_init(void) {
+  int i;
+
+  for (i = 0; i < TIMERS_NUM_TIMER32; i++) {
+    timer32s[i].load = 0xFFFFFFFF;
+    timer32s[i].mask = 0xFFFFFFFF;
+    timer32s[i].divider = 1;
+    timer32s[i].baseValue = 0xFFFFFFFF;
+    timer32s[i].interruptEnabled = true;
+    Machine_addEvent(&timer32s[i].wrap, Timers_timer32Wrapped, &timer32s[i]);
+  }
+  timerA1.divider = 1;
+  Machine_addEvent(&timerA1.compare, Timers_timerACompared, NULL);
+  Machine_addEvent(&sysTick.wrap, Timers_sysTickWrapped, NULL);
+  for (i = 0; i < TIMERS_RTC_NUM_PRESCALERS; i++) {
+    rtc.intervals[i] = i == 1 ? 2 * TIMERS_RTC_RT1PS_TICKS : 2;
+    Machine_addEvent(&rtc.events[i], Timers_rtcInterval, (void*)(intptr_t)i);
+  }
+
+  Machine_setLine(INT_T32_INT1, Timers_timer32Line);
+  Machine_setLine(INT_TA1_0, Timers_timerALine);
+  Machine_setLine(INT_RTC_C, Timers_rtcLine);
+  Machine_setLine(MACHINE_VECTOR_SYSTICK, Timers_sysTickLine);
+}
@@ -0,0 +1,17 @@
+/*
+ * Timers.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef HOST_TIMERS_H_
+#define HOST_TIMERS_H_
+
+#include "Machine.h"
+
+/** Changes MCLK, which Timer32 and SysTick count */
+void Timers_setMclk(uint32_t hz);
+
+void Timers_init(void);
+
+#endif /* HOST_TIMERS_H_ */
@@ -0,0 +1,147 @@
+/*
+ * FormatBench.c
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+// A native benchmark of HAL/Format.c against the C library's snprintf(),
+// which the firmware used before. It runs on the host CPU, not on the
+// simulator, so the times only compare the two on the same machine. Every
+// output is checked against snprintf() first.
+//
+//   make -C host format-bench
+
+#define _GNU_SOURCE
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <HAL/Format.h>
+
+#define BENCH_VALUES 4096
+#define BENCH_PASSES 256
+#define BENCH_RUNS 7
+
+typedef int (*FormatFunction)(char* buffer, uint32_t value);
+
+typedef struct {
+  const char* name;
+  FormatFunction function;
+} BenchCase;
+
+static uint32_t values[BENCH_VALUES];
+
+/** Keeps the compiler from dropping the formatted text */
+static volatile char sink;
+
+static int format_decimal(char* buffer, uint32_t value) {
+  return Format_decimal(buffer, value);
+}
+
+static int sprintf_decimal(char* buffer, uint32_t value) {
+  return snprintf(buffer, FORMAT_MAX_DECIMAL + 1, "%u", (unsigned)value);
+}
+
+static int format_hex(char* buffer, uint32_t value) {
+  return Format_hex(buffer, value, FORMAT_MAX_HEX);
+}
+
+static int sprintf_hex(char* buffer, uint32_t value) {
+  return snprintf(buffer, FORMAT_MAX_HEX + 1, "%08X", (unsigned)value);
+}
+
+static const BenchCase cases[] = {
+    {"Format_decimal", format_decimal},
+    {"snprintf %u", sprintf_decimal},
+    {"Format_hex", format_hex},
+    {"snprintf %08X", sprintf_hex},
+};
+
+static double now_ns(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return now.tv_sec * 1e9 + now.tv_nsec;
+}
+
+/**
+ * Fills the values of one set: the small counts the screens show, or values
+ * spread over the whole 32-bit range.
+ */
+static void fill_values(bool small) {
+  int i;
+
+  srand(1);
+  for (i = 0; i < BENCH_VALUES; i++) {
+    uint32_t value = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+    values[i] = small ? value % 100 : value;
+  }
+}
+
+/** Exits unless each Format function writes what snprintf() writes */
+static void check_cases(void) {
+  char expected[FORMAT_MAX_DECIMAL + 1], actual[FORMAT_MAX_DECIMAL + 1];
+  size_t c;
+  int i;
+
+  for (c = 0; c < sizeof(cases) / sizeof(cases[0]); c += 2) {
+    for (i = 0; i < BENCH_VALUES; i++) {
+      int length = cases[c].function(actual, values[i]);
+      cases[c + 1].function(expected, values[i]);
+      if (strcmp(actual, expected) != 0 || length != (int)strlen(expected)) {
+        fprintf(stderr, "%s(%u) wrote \"%s\", not \"%s\"\n", cases[c].name,
+                (unsigned)values[i], actual, expected);
+        exit(1);
+      }
+    }
+  }
+}
+
+/**
+ * Times a case over all values, and keeps the fastest of BENCH_RUNS runs.
+ *
+ * @return the time of one call in nanoseconds
+ */
+static double time_case(const BenchCase* case_p) {
+  char buffer[FORMAT_MAX_DECIMAL + 1];
+  double best = 0;
+  int run, pass, i;
+
+  for (run = 0; run < BENCH_RUNS; run++) {
+    double start = now_ns();
+    for (pass = 0; pass < BENCH_PASSES; pass++) {
+      for (i = 0; i < BENCH_VALUES; i++) {
+        case_p->function(buffer, values[i]);
+        sink = buffer[0];
+      }
+    }
+    double elapsed = now_ns() - start;
+    if (run == 0 || elapsed < best) {
+      best = elapsed;
+    }
+  }
+
+  return best / ((double)BENCH_PASSES * BENCH_VALUES);
+}
+
+int main(void) {
+  static const char* const sets[] = {"0-99", "32-bit"};
+  size_t s, c;
+
+  printf("%-16s%12s%12s\n", "case", sets[0], sets[1]);
+  double times[sizeof(cases) / sizeof(cases[0])][2];
+  for (s = 0; s < 2; s++) {
+    fill_values(s == 0);
+    check_cases();
+    for (c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+      times[c][s] = time_case(&cases[c]);
+    }
+  }
+  for (c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+    printf("%-16s%9.1f ns%9.1f ns\n", cases[c].name, times[c][0],
+           times[c][1]);
+  }
+
+  return 0;
+}
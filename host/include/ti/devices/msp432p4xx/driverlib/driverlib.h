@@ -0,0 +1,379 @@
+/*
+ * driverlib.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+// The part of the MSP432 driverlib API which the firmware uses, implemented
+// by the host simulator on its models of the peripherals (host/Machine.h).
+// The constants have the values of the TI headers where the simulator does
+// not care, so that code which stores or compares them behaves the same.
+
+#ifndef HOST_DRIVERLIB_H_
+#define HOST_DRIVERLIB_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <ti/devices/msp432p4xx/inc/msp.h>
+
+// Interrupt numbers, as in the MSP432P401R vector table
+#define INT_TA1_0 26
+#define INT_EUSCIA0 32
+#define INT_EUSCIA1 33
+#define INT_EUSCIA2 34
+#define INT_EUSCIA3 35
+#define INT_EUSCIB0 36
+#define INT_T32_INT1 41
+#define INT_RTC_C 45
+#define INT_PORT1 51
+#define INT_PORT2 52
+#define INT_PORT3 53
+#define INT_PORT4 54
+#define INT_PORT5 55
+#define INT_PORT6 56
+
+void Interrupt_enableInterrupt(uint32_t interruptNumber);
+void Interrupt_disableInterrupt(uint32_t interruptNumber);
+bool Interrupt_enableMaster(void);
+bool Interrupt_disableMaster(void);
+
+// GPIO
+#define GPIO_PORT_P1 1
+#define GPIO_PORT_P2 2
+#define GPIO_PORT_P3 3
+#define GPIO_PORT_P4 4
+#define GPIO_PORT_P5 5
+#define GPIO_PORT_P6 6
+#define GPIO_PORT_P7 7
+#define GPIO_PORT_P8 8
+#define GPIO_PORT_P9 9
+#define GPIO_PORT_P10 10
+
+#define GPIO_PIN0 0x0001
+#define GPIO_PIN1 0x0002
+#define GPIO_PIN2 0x0004
+#define GPIO_PIN3 0x0008
+#define GPIO_PIN4 0x0010
+#define GPIO_PIN5 0x0020
+#define GPIO_PIN6 0x0040
+#define GPIO_PIN7 0x0080
+
+#define GPIO_PRIMARY_MODULE_FUNCTION 0x01
+#define GPIO_SECONDARY_MODULE_FUNCTION 0x02
+#define GPIO_TERTIARY_MODULE_FUNCTION 0x03
+
+#define GPIO_LOW_TO_HIGH_TRANSITION 0x00
+#define GPIO_HIGH_TO_LOW_TRANSITION 0x01
+
+#define GPIO_INPUT_PIN_HIGH 0x01
+#define GPIO_INPUT_PIN_LOW 0x00
+
+void GPIO_setAsOutputPin(uint_fast8_t selectedPort, uint_fast16_t selectedPins);
+void GPIO_setOutputHighOnPin(uint_fast8_t selectedPort,
+                             uint_fast16_t selectedPins);
+void GPIO_setOutputLowOnPin(uint_fast8_t selectedPort,
+                            uint_fast16_t selectedPins);
+void GPIO_toggleOutputOnPin(uint_fast8_t selectedPort,
+                            uint_fast16_t selectedPins);
+void GPIO_setAsInputPin(uint_fast8_t selectedPort, uint_fast16_t selectedPins);
+void GPIO_setAsInputPinWithPullUpResistor(uint_fast8_t selectedPort,
+                                          uint_fast16_t selectedPins);
+void GPIO_setAsPeripheralModuleFunctionOutputPin(uint_fast8_t selectedPort,
+                                                 uint_fast16_t selectedPins,
+                                                 uint_fast8_t mode);
+void GPIO_setAsPeripheralModuleFunctionInputPin(uint_fast8_t selectedPort,
+                                                uint_fast16_t selectedPins,
+                                                uint_fast8_t mode);
+uint8_t GPIO_getInputPinValue(uint_fast8_t selectedPort,
+                              uint_fast16_t selectedPins);
+void GPIO_enableInterrupt(uint_fast8_t selectedPort,
+                          uint_fast16_t selectedPins);
+void GPIO_disableInterrupt(uint_fast8_t selectedPort,
+                           uint_fast16_t selectedPins);
+uint_fast16_t GPIO_getInterruptStatus(uint_fast8_t selectedPort,
+                                      uint_fast16_t selectedPins);
+uint_fast16_t GPIO_getEnabledInterruptStatus(uint_fast8_t selectedPort);
+void GPIO_clearInterruptFlag(uint_fast8_t selectedPort,
+                             uint_fast16_t selectedPins);
+void GPIO_interruptEdgeSelect(uint_fast8_t selectedPort,
+                              uint_fast16_t selectedPins,
+                              uint_fast8_t edgeSelect);
+
+// Watchdog, reset and power control
+void WDT_A_holdTimer(void);
+void ResetCtl_initiateHardReset(void);
+bool PCM_gotoLPM0(void);
+bool PCM_gotoLPM3(void);
+
+// Clock system and flash
+#define CS_ACLK 0x01
+#define CS_MCLK 0x02
+#define CS_HSMCLK 0x04
+#define CS_SMCLK 0x08
+#define CS_BCLK 0x10
+
+#define CS_DCOCLK_SELECT 0x03
+#define CS_REFOCLK_SELECT 0x02
+
+#define CS_CLOCK_DIVIDER_1 0x00
+
+#define FLASH_BANK0 0x00
+#define FLASH_BANK1 0x01
+
+void CS_setDCOFrequency(uint32_t dcoFrequency);
+void CS_initClockSignal(uint32_t selectedClockSignal, uint32_t clockSource,
+                        uint32_t clockSourceDivider);
+uint32_t CS_getMCLK(void);
+uint32_t CS_getSMCLK(void);
+uint32_t CS_getACLK(void);
+bool FlashCtl_setWaitState(uint32_t bank, uint32_t waitState);
+
+// Timer32
+#define TIMER32_0_BASE 0x4000C000
+#define TIMER32_1_BASE 0x4000C020
+
+#define TIMER32_PRESCALER_1 0x00
+#define TIMER32_PRESCALER_16 0x04
+#define TIMER32_PRESCALER_256 0x08
+
+#define TIMER32_16BIT 0x00
+#define TIMER32_32BIT 0x02
+
+#define TIMER32_FREE_RUN_MODE 0x00
+#define TIMER32_PERIODIC_MODE 0x40
+
+void Timer32_initModule(uint32_t timer, uint32_t preScaler,
+                        uint32_t resolution, uint32_t mode);
+void Timer32_setCount(uint32_t timer, uint32_t count);
+void Timer32_startTimer(uint32_t timer, bool oneShot);
+void Timer32_haltTimer(uint32_t timer);
+uint32_t Timer32_getValue(uint32_t timer);
+void Timer32_clearInterruptFlag(uint32_t timer);
+
+// Timer_A
+#define TIMER_A1_BASE 0x40000400
+
+#define TIMER_A_CLOCKSOURCE_ACLK 0x0100
+#define TIMER_A_CLOCKSOURCE_SMCLK 0x0200
+
+#define TIMER_A_CLOCKSOURCE_DIVIDER_1 0x01
+#define TIMER_A_CLOCKSOURCE_DIVIDER_2 0x02
+#define TIMER_A_CLOCKSOURCE_DIVIDER_4 0x04
+#define TIMER_A_CLOCKSOURCE_DIVIDER_8 0x08
+
+#define TIMER_A_TAIE_INTERRUPT_DISABLE 0x00
+#define TIMER_A_TAIE_INTERRUPT_ENABLE 0x0002
+
+#define TIMER_A_CCIE_CCR0_INTERRUPT_DISABLE 0x00
+#define TIMER_A_CCIE_CCR0_INTERRUPT_ENABLE 0x0010
+
+#define TIMER_A_SKIP_CLEAR 0x00
+#define TIMER_A_DO_CLEAR 0x0004
+
+#define TIMER_A_STOP_MODE 0x0000
+#define TIMER_A_UP_MODE 0x0010
+
+#define TIMER_A_CAPTURECOMPARE_REGISTER_0 0x02
+
+#define TIMER_A_CAPTURECOMPARE_INTERRUPT_FLAG 0x0001
+
+typedef struct _Timer_A_UpModeConfig {
+  uint_fast16_t clockSource;
+  uint_fast16_t clockSourceDivider;
+  uint_fast16_t timerPeriod;
+  uint_fast16_t timerInterruptEnable_TAIE;
+  uint_fast16_t captureCompareInterruptEnable_CCR0_CCIE;
+  uint_fast16_t timerClear;
+} Timer_A_UpModeConfig;
+
+void Timer_A_configureUpMode(uint32_t timer,
+                             const Timer_A_UpModeConfig *config);
+void Timer_A_startCounter(uint32_t timer, uint_fast16_t timerMode);
+void Timer_A_stopTimer(uint32_t timer);
+uint_fast16_t Timer_A_getCounterValue(uint32_t timer);
+uint32_t Timer_A_getCaptureCompareInterruptStatus(uint32_t timer,
+                                                  uint_fast16_t captureCompareRegister,
+                                                  uint_fast16_t mask);
+void Timer_A_clearCaptureCompareInterrupt(uint32_t timer,
+                                          uint_fast16_t captureCompareRegister);
+
+// RTC_C, which counts BCLK
+#define RTC_C_PRESCALE_0 0x00
+#define RTC_C_PRESCALE_1 0x01
+
+#define RTC_C_PSEVENTDIVIDER_2 0x00
+#define RTC_C_PSEVENTDIVIDER_4 0x04
+#define RTC_C_PSEVENTDIVIDER_8 0x08
+#define RTC_C_PSEVENTDIVIDER_16 0x0C
+#define RTC_C_PSEVENTDIVIDER_32 0x10
+#define RTC_C_PSEVENTDIVIDER_64 0x14
+#define RTC_C_PSEVENTDIVIDER_128 0x18
+#define RTC_C_PSEVENTDIVIDER_256 0x1C
+
+#define RTC_C_PRESCALE_TIMER0_INTERRUPT 0x02
+#define RTC_C_PRESCALE_TIMER1_INTERRUPT 0x01
+
+typedef struct _RTC_C_Calendar {
+  uint_fast8_t seconds;
+  uint_fast8_t minutes;
+  uint_fast8_t hours;
+  uint_fast8_t dayOfWeek;
+  uint_fast8_t dayOfmonth;
+  uint_fast8_t month;
+  uint_fast16_t year;
+} RTC_C_Calendar;
+
+void RTC_C_startClock(void);
+void RTC_C_holdClock(void);
+RTC_C_Calendar RTC_C_getCalendarTime(void);
+void RTC_C_definePrescaleEvent(uint_fast8_t prescaleSelect,
+                               uint_fast8_t prescaleEventDivider);
+uint_fast8_t RTC_C_getPrescaleValue(uint_fast8_t prescaleSelect);
+void RTC_C_enableInterrupt(uint8_t interruptMask);
+void RTC_C_disableInterrupt(uint8_t interruptMask);
+uint_fast8_t RTC_C_getInterruptStatus(void);
+void RTC_C_clearInterruptFlag(uint_fast8_t interruptFlagMask);
+
+// SysTick
+void SysTick_enableModule(void);
+void SysTick_disableModule(void);
+void SysTick_enableInterrupt(void);
+void SysTick_disableInterrupt(void);
+void SysTick_setPeriod(uint32_t period);
+
+// eUSCI_A in UART mode
+#define EUSCI_A0_BASE 0x40001000
+#define EUSCI_A1_BASE 0x40001400
+#define EUSCI_A2_BASE 0x40001800
+#define EUSCI_A3_BASE 0x40001C00
+
+#define EUSCI_A_UART_CLOCKSOURCE_SMCLK 0x80
+#define EUSCI_A_UART_CLOCKSOURCE_ACLK 0x40
+
+#define EUSCI_A_UART_NO_PARITY 0x00
+#define EUSCI_A_UART_LSB_FIRST 0x00
+#define EUSCI_A_UART_MSB_FIRST 0x2000
+#define EUSCI_A_UART_ONE_STOP_BIT 0x00
+#define EUSCI_A_UART_MODE 0x00
+#define EUSCI_A_UART_8_BIT_LEN 0x00
+
+#define EUSCI_A_UART_OVERSAMPLING_BAUDRATE_GENERATION 0x01
+#define EUSCI_A_UART_LOW_FREQUENCY_BAUDRATE_GENERATION 0x00
+
+#define EUSCI_A_UART_RECEIVE_INTERRUPT 0x0001
+#define EUSCI_A_UART_TRANSMIT_INTERRUPT 0x0002
+
+#define EUSCI_A_UART_RECEIVE_INTERRUPT_FLAG 0x0001
+#define EUSCI_A_UART_TRANSMIT_INTERRUPT_FLAG 0x0002
+
+#define EUSCI_A_UART_BUSY 0x0001
+#define EUSCI_A_UART_OVERRUN_ERROR 0x0020
+#define EUSCI_A_UART_FRAMING_ERROR 0x0040
+
+typedef struct _eUSCI_UART_ConfigV1 {
+  uint_fast8_t selectClockSource;
+  uint_fast16_t clockPrescalar;
+  uint_fast8_t firstModReg;
+  uint_fast8_t secondModReg;
+  uint_fast8_t parity;
+  uint_fast16_t msborLsbFirst;
+  uint_fast16_t numberofStopBits;
+  uint_fast16_t uartMode;
+  uint_fast8_t overSampling;
+  uint_fast16_t dataLength;
+} eUSCI_UART_ConfigV1;
+
+bool UART_initModule(uint32_t moduleInstance,
+                     const eUSCI_UART_ConfigV1 *config);
+void UART_enableModule(uint32_t moduleInstance);
+void UART_disableModule(uint32_t moduleInstance);
+void UART_transmitData(uint32_t moduleInstance, uint_fast8_t transmitData);
+uint8_t UART_receiveData(uint32_t moduleInstance);
+void UART_enableInterrupt(uint32_t moduleInstance, uint_fast8_t mask);
+void UART_disableInterrupt(uint32_t moduleInstance, uint_fast8_t mask);
+uint_fast8_t UART_getInterruptStatus(uint32_t moduleInstance, uint8_t mask);
+uint_fast8_t UART_getEnabledInterruptStatus(uint32_t moduleInstance);
+uint_fast8_t UART_queryStatusFlags(uint32_t moduleInstance, uint_fast8_t mask);
+void UART_setDormant(uint32_t moduleInstance);
+void UART_resetDormant(uint32_t moduleInstance);
+
+// eUSCI_B in SPI mode
+#define EUSCI_B0_BASE 0x40002000
+
+#define EUSCI_B_SPI_CLOCKSOURCE_SMCLK 0x80
+#define EUSCI_B_SPI_MSB_FIRST 0x2000
+#define EUSCI_B_SPI_PHASE_DATA_CAPTURED_ONFIRST_CHANGED_ON_NEXT 0x8000
+#define EUSCI_B_SPI_CLOCKPOLARITY_INACTIVITY_LOW 0x00
+#define EUSCI_B_SPI_3PIN 0x00
+
+typedef struct _eUSCI_SPI_MasterConfig {
+  uint_fast8_t selectClockSource;
+  uint32_t clockSourceFrequency;
+  uint32_t desiredSpiClock;
+  uint_fast16_t msbFirst;
+  uint_fast16_t clockPhase;
+  uint_fast16_t clockPolarity;
+  uint_fast16_t spiMode;
+} eUSCI_SPI_MasterConfig;
+
+bool SPI_initMaster(uint32_t moduleInstance,
+                    const eUSCI_SPI_MasterConfig *config);
+void SPI_enableModule(uint32_t moduleInstance);
+void SPI_disableModule(uint32_t moduleInstance);
+// An address, which is 32 bits on the board and as wide as a pointer here
+uintptr_t SPI_getTransmitBufferAddressForDMA(uint32_t moduleInstance);
+
+// DMA
+#define DMA_CH0_EUSCIB0TX0 0x00000000
+
+#define UDMA_PRI_SELECT 0x00000000
+#define UDMA_ALT_SELECT 0x00000008
+
+#define UDMA_MODE_BASIC 0x00000001
+
+#define UDMA_ATTR_USEBURST 0x00000001
+#define UDMA_ATTR_ALTSELECT 0x00000002
+#define UDMA_ATTR_HIGH_PRIORITY 0x00000004
+#define UDMA_ATTR_REQMASK 0x00000008
+
+#define UDMA_SIZE_8 0x00000000
+#define UDMA_SRC_INC_8 0x00000000
+#define UDMA_DST_INC_NONE 0xC0000000
+#define UDMA_ARB_1 0x00000000
+
+typedef struct _DMA_ControlTable {
+  volatile void *srcEndAddr;
+  volatile void *dstEndAddr;
+  volatile uint32_t control;
+  volatile uint32_t spare;
+} DMA_ControlTable;
+
+void DMA_enableModule(void);
+void DMA_setControlBase(void *controlTable);
+void DMA_assignChannel(uint32_t mapping);
+void DMA_disableChannelAttribute(uint32_t channelNum, uint32_t attr);
+void DMA_setChannelControl(uint32_t channelStructIndex, uint32_t control);
+void DMA_setChannelTransfer(uint32_t channelStructIndex, uint32_t mode,
+                            void *srcAddr, void *dstAddr,
+                            uint32_t transferSize);
+void DMA_enableChannel(uint32_t channelNum);
+bool DMA_isChannelEnabled(uint32_t channelNum);
+
+// CRC32
+#define CRC32_MODE 0x00000001
+
+void CRC32_setSeed(uint32_t seed, uint_fast8_t crcType);
+void CRC32_set8BitData(uint8_t dataIn, uint_fast8_t crcType);
+uint32_t CRC32_getResultReversed(uint_fast8_t crcType);
+
+// AES256
+#define AES256_BASE 0x40003C00
+#define AES256_KEYLENGTH_256BIT 256
+
+bool AES256_setCipherKey(uint32_t moduleInstance, const uint8_t *cipherKey,
+                         uint_fast16_t keyLength);
+void AES256_encryptData(uint32_t moduleInstance, const uint8_t *data,
+                        uint8_t *encryptedData);
+
+#endif /* HOST_DRIVERLIB_H_ */
@@ -0,0 +1,49 @@
+/*
+ * msp.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+// The registers and core functions which the firmware touches directly,
+// without driverlib. Each access goes through the simulator, which charges
+// the cycles of a register access and lets due interrupts run first.
+
+#ifndef HOST_MSP_H_
+#define HOST_MSP_H_
+
+#include <stdint.h>
+
+// The DWT cycle counter and the debug register which powers it
+typedef struct {
+  volatile uint32_t CTRL;
+  volatile uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct {
+  volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+#define DWT_CTRL_CYCCNTENA_Msk (1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk (1UL << 24)
+
+DWT_Type *Machine_dwt(void);
+extern CoreDebug_Type Machine_coreDebug;
+
+#define DWT (Machine_dwt())
+#define CoreDebug (&Machine_coreDebug)
+
+// Status and transmit buffer of EUSCI_B0, which the LCD driver polls and
+// writes itself. A write to the buffer takes effect at the next access to
+// the simulated hardware, which is the busy poll right after it.
+#define UCBUSY 0x0001
+
+uint16_t Machine_ucb0Statw(void);
+extern volatile uint16_t Machine_ucb0TxBuf;
+
+#define UCB0STATW (Machine_ucb0Statw())
+#define UCB0TXBUF (Machine_ucb0TxBuf)
+
+// The main stack pointer, as the address of the caller's frame
+#define __get_MSP() ((uint32_t)(uintptr_t)__builtin_frame_address(0))
+
+#endif /* HOST_MSP_H_ */
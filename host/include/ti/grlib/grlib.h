@@ -0,0 +1,104 @@
+/*
+ * grlib.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+// The part of the TI graphics library which the firmware uses, implemented
+// by host/Graphics.c on top of the display driver functions, as grlib does.
+
+#ifndef HOST_GRLIB_H_
+#define HOST_GRLIB_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct Graphics_Rectangle {
+  int16_t xMin;
+  int16_t yMin;
+  int16_t xMax;
+  int16_t yMax;
+} Graphics_Rectangle;
+
+// The names of the older grlib releases, which the LCD driver uses
+#define sXMin xMin
+#define sYMin yMin
+#define sXMax xMax
+#define sYMax yMax
+
+struct Graphics_Display;
+
+typedef struct Graphics_Display_Functions {
+  void (*pfnPixelDraw)(const struct Graphics_Display *display, int16_t x,
+                       int16_t y, uint16_t value);
+  void (*pfnPixelDrawMultiple)(const struct Graphics_Display *display,
+                               int16_t x, int16_t y, int16_t x0,
+                               int16_t count, int16_t bPP,
+                               const uint8_t *data, const uint32_t *pucPalette);
+  void (*pfnLineDrawH)(const struct Graphics_Display *display, int16_t x1,
+                       int16_t x2, int16_t y, uint16_t value);
+  void (*pfnLineDrawV)(const struct Graphics_Display *display, int16_t x,
+                       int16_t y1, int16_t y2, uint16_t value);
+  void (*pfnRectFill)(const struct Graphics_Display *display,
+                      const Graphics_Rectangle *rect, uint16_t value);
+  uint32_t (*pfnColorTranslate)(const struct Graphics_Display *display,
+                                uint32_t value);
+  void (*pfnFlush)(const struct Graphics_Display *display);
+  void (*pfnClearDisplay)(const struct Graphics_Display *display,
+                          uint16_t value);
+} Graphics_Display_Functions;
+
+typedef struct Graphics_Display {
+  int32_t size;
+  void *displayData;
+  uint16_t width;
+  uint16_t heigth;
+  const Graphics_Display_Functions *pFxns;
+} Graphics_Display;
+
+// A fixed-width font of 1 bit per pixel glyphs, one byte per column with the
+// top row in bit 0, for the characters from ' ' to '~'
+typedef struct Graphics_Font {
+  uint8_t format;
+  uint8_t maxWidth;
+  uint8_t height;
+  uint8_t baseline;
+  const uint8_t *data;
+} Graphics_Font;
+
+typedef struct Graphics_Context {
+  int32_t size;
+  const Graphics_Display *display;
+  Graphics_Rectangle clipRegion;
+  uint32_t foreground;
+  uint32_t background;
+  const Graphics_Font *font;
+} Graphics_Context;
+
+#define GRAPHICS_COLOR_BLACK 0x00000000
+#define GRAPHICS_COLOR_WHITE 0x00FFFFFF
+#define GRAPHICS_COLOR_RED 0x00FF0000
+#define GRAPHICS_COLOR_GREEN 0x00008000
+#define GRAPHICS_COLOR_LIME 0x0000FF00
+#define GRAPHICS_COLOR_BLUE 0x000000FF
+#define GRAPHICS_COLOR_YELLOW 0x00FFFF00
+#define GRAPHICS_COLOR_CYAN 0x0000FFFF
+#define GRAPHICS_COLOR_MAGENTA 0x00FF00FF
+#define GRAPHICS_COLOR_GRAY 0x00808080
+
+extern const Graphics_Font g_sFontFixed6x8;
+
+void Graphics_initContext(Graphics_Context *context, Graphics_Display *display,
+                          const Graphics_Display_Functions *pFxns);
+void Graphics_setForegroundColor(Graphics_Context *context, int32_t value);
+void Graphics_setBackgroundColor(Graphics_Context *context, int32_t value);
+void Graphics_setFont(Graphics_Context *context, const Graphics_Font *font);
+void Graphics_clearDisplay(const Graphics_Context *context);
+void Graphics_flushBuffer(const Graphics_Context *context);
+void Graphics_drawPixel(const Graphics_Context *context, int32_t x, int32_t y);
+void Graphics_fillRectangle(const Graphics_Context *context,
+                            const Graphics_Rectangle *rect);
+void Graphics_drawString(const Graphics_Context *context, int8_t *string,
+                         int32_t length, int32_t x, int32_t y, bool opaque);
+
+#endif /* HOST_GRLIB_H_ */
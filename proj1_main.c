@@ -4,16 +4,140 @@
 /* Standard Includes */
 #include <stdbool.h>
 #include <stdint.h>
-#include <stdio.h>
 #include <string.h>
 
 /* HAL and Application includes */
 #include <Application.h>
+#include <HAL/Format.h>
+#include <HAL/Frame.h>
 #include <HAL/HAL.h>
+#include <HAL/Text.h>
 #include <HAL/Timer.h>
 
 // Define a maximum length for the concatenated string
 
+// Text prompting a player, after their name, to enter a game choice
+static const char uart_prompt_text[] =
+    ", please enter\r\nR or r for Rock\r\nP or p for Paper\r\nS or s for Scissors\r\n";
+
+// Layouts of the LCD screens. Every list is const, so the layouts and their
+// text stay in flash, and every item is checked against the panel size when
+// the program is built.
+static const DisplayItem title_layout[] = {
+    DISPLAY_TEXT(0, 16, "Rock Paper Scissors"),
+    DISPLAY_TEXT(0, 24, "Multiplayer Game"),
+    DISPLAY_TEXT(0, 32, "My solution"),
+    DISPLAY_TEXT(0, 48, "Youssef Mentawy"),
+    DISPLAY_TEXT(0, 80, "BB1: Play Game"),
+    DISPLAY_TEXT(0, 88, "LB2: Instructions"),
+};
+
+static const DisplayItem instructions_layout[] = {
+    DISPLAY_TEXT(0, 0, "    Instructions"),
+    DISPLAY_TEXT(0, 16, "Select the number of"),
+    DISPLAY_TEXT(0, 24, "rounds, players, and"),
+    DISPLAY_TEXT(0, 32, "player's names. Every"),
+    DISPLAY_TEXT(0, 40, "round all players"),
+    DISPLAY_TEXT(0, 48, "enter their choice."),
+    DISPLAY_TEXT(0, 56, "whoever wins the"),
+    DISPLAY_TEXT(0, 64, "round gets a point."),
+    DISPLAY_TEXT(0, 72, "After all rounds are"),
+    DISPLAY_TEXT(0, 80, "played, the scores"),
+    DISPLAY_TEXT(0, 88, "and winners shown."),
+    DISPLAY_TEXT(0, 104, "LB2: Go Back"),
+};
+
+static const DisplayItem settings_layout[] = {
+    DISPLAY_TEXT(0, 0, "   Choose Settings"),
+    DISPLAY_TEXT(0, 16, "Press JSB to change #"),
+    DISPLAY_TEXT(0, 24, "Press LB2 to switch"),
+    DISPLAY_TEXT(0, 32, "between players"),
+    DISPLAY_TEXT(0, 40, "and # of Rounds"),
+    DISPLAY_TEXT(5, ROUNDS_POS, "# of Rounds: "),
+    DISPLAY_FIELD(FIELD_ROUNDS, ANY_PLAYER, 90, ROUNDS_POS, NUMBER_WIDTH),
+    DISPLAY_TEXT(5, PLAYERS_POS, "# of Players:"),
+    DISPLAY_FIELD(FIELD_PLAYERS, ANY_PLAYER, 90, PLAYERS_POS, NUMBER_WIDTH),
+    DISPLAY_TEXT(5, 88, "BB1: Confirm"),
+    DISPLAY_TEXT(5, 96, "LB1: Reset Settings"),
+};
+
+static const DisplayItem selection_layout[] = {
+    DISPLAY_TEXT(0, 0, "Name Select Screen"),
+    DISPLAY_FIELD(FIELD_PLAYER_NUMBER, 0, 10, 8, NUMBER_WIDTH),
+    DISPLAY_FIELD(FIELD_PLAYER_NUMBER, 1, 10, 16, NUMBER_WIDTH),
+    DISPLAY_FIELD(FIELD_PLAYER_NUMBER, 2, 10, 24, NUMBER_WIDTH),
+    DISPLAY_FIELD(FIELD_PLAYER_NUMBER, 3, 10, 32, NUMBER_WIDTH),
+    DISPLAY_TEXT(0, 40, "Type 3 letters into"),
+    DISPLAY_TEXT(0, 48, "the UART terminal,"),
+    DISPLAY_TEXT(0, 56, "then press BB1 to"),
+    DISPLAY_TEXT(0, 64, "move to the next"),
+    DISPLAY_TEXT(0, 72, "player or start the"),
+    DISPLAY_TEXT(0, 80, "game."),
+};
+
+static const DisplayItem game_layout[] = {
+    DISPLAY_TEXT(0, 0, "Game Screen"),
+};
+
+static const DisplayItem end_prompt_layout[] = {
+    DISPLAY_TEXT(20, 64, "Press BB1 to end"),
+};
+
+// Players 1 and 3 are shown on the left, players 2 and 4 on the right
+static const DisplayItem scores_layout[] = {
+    DISPLAY_FIELD(FIELD_NAME, 0, 5, 24, NAME_WIDTH),
+    DISPLAY_FIELD(FIELD_CHOICE, 0, 5, 32, CHOICE_WIDTH),
+    DISPLAY_PLAYER_TEXT(0, 5, 40, "wins:"),
+    DISPLAY_FIELD(FIELD_WINS, 0, 35, 40, NUMBER_WIDTH),
+    DISPLAY_FIELD(FIELD_NAME, 1, 85, 24, NAME_WIDTH),
+    DISPLAY_FIELD(FIELD_CHOICE, 1, 85, 32, CHOICE_WIDTH),
+    DISPLAY_PLAYER_TEXT(1, 85, 40, "wins:"),
+    DISPLAY_FIELD(FIELD_WINS, 1, 115, 40, NUMBER_WIDTH),
+    DISPLAY_FIELD(FIELD_NAME, 2, 5, 72, NAME_WIDTH),
+    DISPLAY_FIELD(FIELD_CHOICE, 2, 5, 80, CHOICE_WIDTH),
+    DISPLAY_PLAYER_TEXT(2, 5, 88, "wins:"),
+    DISPLAY_FIELD(FIELD_WINS, 2, 35, 88, NUMBER_WIDTH),
+    DISPLAY_FIELD(FIELD_NAME, 3, 85, 72, NAME_WIDTH),
+    DISPLAY_FIELD(FIELD_CHOICE, 3, 85, 80, CHOICE_WIDTH),
+    DISPLAY_PLAYER_TEXT(3, 85, 88, "wins:"),
+    DISPLAY_FIELD(FIELD_WINS, 3, 115, 88, NUMBER_WIDTH),
+    DISPLAY_TEXT(45, 56, "Round"),
+    DISPLAY_FIELD(FIELD_ROUNDS_COUNT, ANY_PLAYER, 80, 56, NUMBER_WIDTH),
+};
+
+static const DisplayItem over_layout[] = {
+    DISPLAY_TEXT(0, 0, "End Screen"),
+    DISPLAY_FIELD(FIELD_NAME, 0, 0, 16, NAME_WIDTH),
+    DISPLAY_PLAYER_TEXT(0, 0, 24, "wins:"),
+    DISPLAY_FIELD(FIELD_WINS, 0, 30, 24, NUMBER_WIDTH),
+    DISPLAY_FIELD(FIELD_NAME, 1, 0, 40, NAME_WIDTH),
+    DISPLAY_PLAYER_TEXT(1, 0, 48, "wins:"),
+    DISPLAY_FIELD(FIELD_WINS, 1, 30, 48, NUMBER_WIDTH),
+    DISPLAY_FIELD(FIELD_NAME, 2, 0, 64, NAME_WIDTH),
+    DISPLAY_PLAYER_TEXT(2, 0, 72, "wins:"),
+    DISPLAY_FIELD(FIELD_WINS, 2, 30, 72, NUMBER_WIDTH),
+    DISPLAY_FIELD(FIELD_NAME, 3, 0, 88, NAME_WIDTH),
+    DISPLAY_PLAYER_TEXT(3, 0, 96, "wins:"),
+    DISPLAY_FIELD(FIELD_WINS, 3, 30, 96, NUMBER_WIDTH),
+    DISPLAY_TEXT(50, 32, "Winners:"),
+};
+
+// Top left corners of the choice icons on the scoreboard, right of each
+// player's name and choice
+static const uint8_t icon_positions[MAX_PLAYERS - 1][2] = {
+    {30, 24}, {105, 24}, {30, 72}, {105, 72},
+};
+
+// The scoreboard caches of Application are sized for this layout
+typedef char scores_items_check[DISPLAY_LIST_LENGTH(scores_layout) == SCORES_ITEMS ? 1 : -1];
+typedef char field_cache_check[NUMBER_WIDTH < FIELD_CACHE_WIDTH && CHOICE_WIDTH < FIELD_CACHE_WIDTH &&
+                               MAX_ROUNDS < 100 ? 1 : -1];
+
+// The one buffer in which fields are composed before being drawn
+static char scratch_line[MAX_STRING_LENGTH];
+
+// Text sent to a player whose game choice was not valid
+static const char invalid_input_text[] = "Enter an R/r/P/p/S/s to choose\r\n";
 
 
 // Non-blocking check. Whenever Launchpad S1 is pressed, LED1 turns on.
@@ -95,6 +219,29 @@ Application Application_construct() {
   app.rounds_count = 0;
   app.players_done = false;
   app.end = false;
+  app.framingTimer = SWTimer_construct(FRAMING_CHECK_TIME_MS);
+  app.framingErrorsSeen = 0;
+  app.rxPending = false;
+  app.frame = Frame_construct();
+  app.frameErrorsSeen = 0;
+  app.seatLinks = SEAT_LINKS;
+  app.seats_moved = 0;
+  app.seats_prompted = false;
+  app.boardLink = BOARD_LINK;
+  app.link_moves_round[0] = -1;
+  app.link_moves_round[1] = -1;
+  app.link_sent = false;
+  app.link_waiting = false;
+  app.scores_drawn = false;
+  app.title_drawn = false;
+  app.reported_screen = title;
+  app.boot_reported = false;
+  app.idleTimer = SWTimer_construct(CLOCK_IDLE_TIME_MS);
+  app.seats_committed = 0;
+  app.seats_revealed = 0;
+  app.commitTimer = SWTimer_construct(COMMIT_DEADLINE_MS);
+  app.commit_late = false;
+  app.match_log = ScrollLog_construct(LOG_TOP, LOG_LINES);
 
   return app;
 }
@@ -118,17 +265,61 @@ Application Application_construct() {
  *   - Prints output via UART.
  */
 void Application_loop(Application* app_p, HAL* hal_p) {
+  Metrics_refresh();
+
+  // Nothing runs until the LCD can be drawn to. Received characters wait in
+  // the UART buffers meanwhile.
+  if (!HAL_canDraw(hal_p)) {
+    return;
+  }
+
+  TRACE_ENTER(TRACE_LOOP);
+
+  // Speed up before anything the inputs of this loop cause is drawn or sent
+  if (CLOCK_GOVERNOR) {
+    Application_governClock(app_p, hal_p);
+  }
+
   // Restart/Update communications if either this is the first time the
   // application is run or if BoosterPack S2 is pressed (which means a new
   // baudrate is being set up)
 
+  // Take in at most one character per loop. Binary frames are handled right
+  // away; a human's character is kept for the screen which wants it.
+  Application_receive(app_p, hal_p);
+
+  // The board link only exists once the communications were set up
+  if (hal_p->boardLink) {
+    Application_updateLink(app_p, hal_p);
+  }
+
   Game_FSM(app_p, hal_p);
 
   if (Button_isTapped(&hal_p->boosterpackS2) || app_p->firstCall) {
     Application_updateCommunications(app_p, hal_p);
   }
 
+  Application_updateAutoBaud(app_p, hal_p);
+
   uart_print(app_p, hal_p);
+
+  if (LCD_BYTE_REPORT) {
+    report_lcd_bytes(app_p, hal_p);
+  }
+
+  if (BOOT_TIME_REPORT && !app_p->boot_reported) {
+    report_boot_time(app_p, hal_p);
+  }
+
+  // Send whatever this loop drew to the LCD when drawing into a framebuffer
+  Graphics_flushBuffer(&hal_p->g_sContext);
+
+  // A sleep is idle time, not part of the loop
+  TRACE_EXIT(TRACE_LOOP);
+
+  if (CLOCK_GOVERNOR && POWER_SLEEP) {
+    Application_sleep(app_p, hal_p);
+  }
 }
 
 
@@ -143,10 +334,16 @@ void Application_loop(Application* app_p, HAL* hal_p) {
 void Application_updateCommunications(Application* app_p, HAL* hal_p) {
   // When this application first loops, the proper LEDs aren't lit. The
   // firstCall flag is used to ensure that the
+  bool firstCall = app_p->firstCall;
   if (app_p->firstCall) {
     app_p->firstCall = false;
   }
 
+  // A manual choice overrides a detection which has not finished yet
+  else if (AutoBaud_isRunning(&hal_p->autoBaud)) {
+    AutoBaud_stop(&hal_p->autoBaud, &hal_p->uart);
+  }
+
   // When BoosterPack S2 is tapped, circularly increment which baud rate is
   // used.
   else {
@@ -155,43 +352,216 @@ void Application_updateCommunications(Application* app_p, HAL* hal_p) {
     app_p->baudChoice = (UART_Baudrate)newBaudNumber;
   }
 
-  // Start/update the baud rate according to the one set above.
-  UART_SetBaud_Enable(&hal_p->uart, app_p->baudChoice);
+  // Start/update the baud rate according to the one set above. A rate which
+  // cannot be generated accurately from the current clock is skipped. 9600 is
+  // always reachable, so this loop terminates.
+  while (!UART_SetBaud_Enable(&hal_p->uart, app_p->baudChoice)) {
+    uint32_t newBaudNumber =
+        CircularIncrement((uint32_t)app_p->baudChoice, NUM_BAUD_CHOICES);
+    app_p->baudChoice = (UART_Baudrate)newBaudNumber;
+  }
+
+  // The seat links always run at the same rate as the main terminal
+  if (app_p->seatLinks) {
+    HAL_enableSeatLinks(hal_p, app_p->baudChoice);
+  }
+
+  Application_showBaudChoice(app_p, hal_p);
+
+  // Start watching for framing errors at the new rate
+  app_p->framingErrorsSeen = UART_getFramingErrors(&hal_p->uart);
+  SWTimer_start(&app_p->framingTimer);
+
+  // On startup the terminal's rate is unknown, so detect it from the first
+  // characters it sends. Until then, the UART transmits at 9600.
+  if (firstCall) {
+    Application_startAutoBaud(app_p, hal_p);
+  }
+
+  // The board link runs at a fixed rate, independent of the terminal
+  if (firstCall && app_p->boardLink) {
+    HAL_enableBoardLink(hal_p, BOARD_LINK_BAUD);
+  }
+}
+
+/**
+ * Starts an automatic baud rate detection on the UART. Until the first
+ * characters arrive, LED2 stays dark to show that the rate is being detected.
+ *
+ * @param app_p:  A pointer to the main Application object.
+ * @param hal_p:  A pointer to the main HAL object
+ */
+void Application_startAutoBaud(Application* app_p, HAL* hal_p) {
+  // The detector times edges in raw counts of the hardware timer, which are
+  // only matched correctly at full speed
+  if (CLOCK_GOVERNOR) {
+    HAL_setClockSpeed(hal_p, CLOCK_FAST);
+    SWTimer_start(&app_p->idleTimer);
+  }
+
+  AutoBaud_start(&hal_p->autoBaud, &hal_p->uart);
 
-  // Based on the new application choice, turn on the correct LED.
-  // To make your life easier, we recommend turning off all LEDs before
-  // selectively turning back on only the LEDs that need to be relit.
-  // -------------------------------------------------------------------------
   LED_turnOff(&hal_p->launchpadLED2Red);
   LED_turnOff(&hal_p->launchpadLED2Green);
   LED_turnOff(&hal_p->launchpadLED2Blue);
+  LED_turnOff(&hal_p->boosterpackRed);
+}
 
-  switch (app_p->baudChoice) {
-    // When the baud rate is 9600, turn on Launchpad LED Red
-    case BAUD_9600:
-      LED_turnOn(&hal_p->launchpadLED2Red);
-      break;
+/**
+ * Runs the automatic baud rate detection. Once a detection finishes, the UART
+ * is locked to the detected rate. While no detection runs, the framing errors
+ * of the UART are counted over fixed periods; too many of them in one period
+ * mean the terminal changed its rate, so a new detection is started.
+ *
+ * @param app_p:  A pointer to the main Application object.
+ * @param hal_p:  A pointer to the main HAL object
+ */
+void Application_updateAutoBaud(Application* app_p, HAL* hal_p) {
+  UART_Baudrate detectedChoice;
+
+  if (AutoBaud_refresh(&hal_p->autoBaud, &hal_p->uart, &detectedChoice)) {
+    // Lock onto the detected rate, or measure again if it cannot be generated
+    if (UART_SetBaud_Enable(&hal_p->uart, detectedChoice)) {
+      app_p->baudChoice = detectedChoice;
+      if (app_p->seatLinks) {
+        HAL_enableSeatLinks(hal_p, app_p->baudChoice);
+      }
+      Application_showBaudChoice(app_p, hal_p);
+      app_p->framingErrorsSeen = UART_getFramingErrors(&hal_p->uart);
+      SWTimer_start(&app_p->framingTimer);
+    } else {
+      Application_startAutoBaud(app_p, hal_p);
+    }
+  }
 
-    case BAUD_19200:
-      LED_turnOn(&hal_p->launchpadLED2Green);
-      break;
+  else if (!AutoBaud_isRunning(&hal_p->autoBaud) &&
+           SWTimer_expired(&app_p->framingTimer)) {
+    uint32_t framingErrors =
+        UART_getFramingErrors(&hal_p->uart) - app_p->framingErrorsSeen;
 
-    case BAUD_38400:
-      LED_turnOn(&hal_p->launchpadLED2Blue);
-      break;
+    if (framingErrors >= FRAMING_ERROR_THRESHOLD) {
+      Application_startAutoBaud(app_p, hal_p);
+    }
 
-    case BAUD_57600:
-      LED_turnOn(&hal_p->launchpadLED2Red);
-      LED_turnOn(&hal_p->launchpadLED2Green);
-      LED_turnOn(&hal_p->launchpadLED2Blue);
-      break;
+    app_p->framingErrorsSeen = UART_getFramingErrors(&hal_p->uart);
+    SWTimer_start(&app_p->framingTimer);
+  }
+}
 
-    // In the default case, this program will do nothing.
-    default:
-      break;
+/**
+ * Picks the clock speed for this loop. Any button held down, any character
+ * waiting in a UART, a running profile, and a message to the other board which
+ * is not acknowledged yet all mean there is work: the clock goes to full speed
+ * at once, so that the redraws and replies this work causes are not slowed
+ * down. Once there was no work for CLOCK_IDLE_TIME_MS, the screen is at rest
+ * and the clock is slowed down until the next input.
+ *
+ * A baud rate detection times the RX line against the full-speed clock. While
+ * slow, the board waits for the terminal's first character, which only wakes
+ * the board up: the detection starts over at full speed and measures the
+ * characters which follow.
+ *
+ * @param app_p:  A pointer to the main Application object.
+ * @param hal_p:  A pointer to the main HAL object
+ */
+void Application_governClock(Application* app_p, HAL* hal_p) {
+  bool slow = Clock_speed() == CLOCK_SLOW;
+  bool busy = Button_isPressed(&hal_p->launchpadS1) ||
+              Button_isPressed(&hal_p->launchpadS2) ||
+              Button_isPressed(&hal_p->boosterpackS1) ||
+              Button_isPressed(&hal_p->boosterpackS2) ||
+              Button_isPressed(&hal_p->boosterpackJS) ||
+              UART_hasChar(&hal_p->uart) || Profiler_isRunning();
+  bool detecting = AutoBaud_isRunning(&hal_p->autoBaud);
+  int i;
+
+  if (hal_p->seatLinks) {
+    for (i = 0; i < NUM_SEAT_UARTS; i++) {
+      busy = busy || UART_hasChar(&hal_p->seatUarts[i]);
+    }
+  }
+  if (hal_p->boardLink) {
+    busy = busy || UART_hasChar(&hal_p->linkUart) ||
+           !Link_canSend(&hal_p->link);
+  }
+
+  if (detecting && slow && AutoBaud_hasEdges(&hal_p->autoBaud)) {
+    Application_startAutoBaud(app_p, hal_p);
+  }
+  else if (busy || (detecting && !slow)) {
+    HAL_setClockSpeed(hal_p, CLOCK_FAST);
+    SWTimer_start(&app_p->idleTimer);
+  }
+  else if (SWTimer_expired(&app_p->idleTimer)) {
+    HAL_setClockSpeed(hal_p, CLOCK_SLOW);
   }
 }
 
+/**
+ * Sleeps until the next input once the governor has slowed the clock down,
+ * which it only does after CLOCK_IDLE_TIME_MS without work. The name and game
+ * screens read characters from the UARTs, so they sleep in LPM0, where the
+ * UARTs keep receiving. The other screens only wait for buttons, so they sleep
+ * in LPM3; a character arriving there only wakes the board. With links to
+ * other seats or boards the UARTs always matter, so only LPM0 is used.
+ *
+ * @param app_p:  A pointer to the main Application object.
+ * @param hal_p:  A pointer to the main HAL object
+ */
+void Application_sleep(Application* app_p, HAL* hal_p) {
+  bool readsChars = app_p->screen_state == name_selection ||
+                    app_p->screen_state == game || hal_p->seatLinks ||
+                    hal_p->boardLink;
+
+  if (Clock_speed() != CLOCK_SLOW || app_p->rxPending) {
+    return;
+  }
+
+  HAL_sleep(hal_p, readsChars ? POWER_LPM0 : POWER_LPM3, SLEEP_TIME_MS);
+}
+
+/**
+ * Lights the LEDs which identify the current baud choice. LED2 shows the rate
+ * as a colour; the rates past the seventh colour reuse the first colours with
+ * the BoosterPack red LED lit as well.
+ *
+ * @param app_p:  A pointer to the main Application object.
+ * @param hal_p:  A pointer to the main HAL object
+ */
+void Application_showBaudChoice(Application* app_p, HAL* hal_p) {
+  // Which LED2 colours make up the indicator of each baud choice
+  static const uint8_t baudLedMapping[NUM_BAUD_CHOICES] = {
+      BAUD_LED_RED,                                   // 9600
+      BAUD_LED_GREEN,                                 // 19200
+      BAUD_LED_BLUE,                                  // 38400
+      BAUD_LED_RED | BAUD_LED_GREEN | BAUD_LED_BLUE,  // 57600
+      BAUD_LED_RED | BAUD_LED_GREEN,                  // 115200
+      BAUD_LED_GREEN | BAUD_LED_BLUE,                 // 230400
+      BAUD_LED_RED | BAUD_LED_BLUE,                   // 460800
+      BAUD_LED_RED | BAUD_LED_HIGH_BANK,              // 921600
+      BAUD_LED_GREEN | BAUD_LED_HIGH_BANK             // 1500000
+  };
+  uint8_t leds = baudLedMapping[app_p->baudChoice];
+
+  // Based on the new application choice, turn on the correct LED.
+  // To make your life easier, we recommend turning off all LEDs before
+  // selectively turning back on only the LEDs that need to be relit.
+  // -------------------------------------------------------------------------
+  LED_turnOff(&hal_p->launchpadLED2Red);
+  LED_turnOff(&hal_p->launchpadLED2Green);
+  LED_turnOff(&hal_p->launchpadLED2Blue);
+  LED_turnOff(&hal_p->boosterpackRed);
+
+  if (leds & BAUD_LED_RED)
+    LED_turnOn(&hal_p->launchpadLED2Red);
+  if (leds & BAUD_LED_GREEN)
+    LED_turnOn(&hal_p->launchpadLED2Green);
+  if (leds & BAUD_LED_BLUE)
+    LED_turnOn(&hal_p->launchpadLED2Blue);
+  if (leds & BAUD_LED_HIGH_BANK)
+    LED_turnOn(&hal_p->boosterpackRed);
+}
+
 /**
  * Interprets a character which was incoming and returns an interpretation of
  * that character. If the input character is a letter, it return L for Letter,
@@ -222,16 +592,185 @@ char Application_interpretIncomingChar(char rxChar) {
   return (txChar);
 }
 
+/**
+ * Reads the next character from the UART, if there is one. Bytes belonging to
+ * a binary frame go to the frame receiver, and a completed frame is handled
+ * immediately. Any other character is kept as the pending character of this
+ * loop, to be picked up with Application_getChar().
+ *
+ * @param app_p:  A pointer to the main Application object.
+ * @param hal_p:  A pointer to the main HAL object
+ */
+void Application_receive(Application* app_p, HAL* hal_p) {
+  // Static so that a full frame does not have to fit on the stack
+  static FrameMessage message;
+
+  app_p->rxPending = false;
+
+  // Frame bytes are taken in as long as they are buffered, but reading stops
+  // at the first human character so that it is not overwritten
+  while (!app_p->rxPending && UART_hasChar(&hal_p->uart)) {
+    char rxChar = UART_getChar(&hal_p->uart);
+
+    if (!Frame_isReceiving(&app_p->frame, (uint8_t)rxChar)) {
+      app_p->rxChar = rxChar;
+      app_p->rxPending = true;
+      TRACE_MARK_ARG(TRACE_RX_CHAR, (uint8_t)rxChar);
+    }
+    else if (Frame_receiveByte(&app_p->frame, (uint8_t)rxChar, &message)) {
+      Application_handleFrame(app_p, hal_p, &message);
+    }
+    // Tell the client about frames which were dropped on the way in
+    else if (app_p->frame.errors != app_p->frameErrorsSeen) {
+      app_p->frameErrorsSeen = app_p->frame.errors;
+      bot_nack(hal_p, 0, NACK_CORRUPT);
+    }
+  }
+}
+
+/**
+ * Hands out the character received during this loop, if any. Each character
+ * is handed out only once.
+ *
+ * @param app_p:    A pointer to the main Application object.
+ * @param rxChar_p: Receives the character
+ *
+ * @return true if a character was available
+ */
+bool Application_getChar(Application* app_p, char* rxChar_p) {
+  if (!app_p->rxPending) {
+    return false;
+  }
+
+  *rxChar_p = app_p->rxChar;
+  app_p->rxPending = false;
+
+  return true;
+}
+
+/**
+ * Discards the character received during this loop, if any.
+ *
+ * @param app_p:  A pointer to the main Application object.
+ */
+void Application_flushChar(Application* app_p) {
+  app_p->rxPending = false;
+}
+
+/**
+ * Receives the other board's moves and watches over the board link. Moves are
+ * taken for the round this board is playing or the next one; a message for
+ * any other round is a copy of moves which were already used, or belongs to a
+ * board which disagrees on the game, and is dropped. When the link is lost a
+ * new session is started, over which this board's moves for the round are
+ * sent again.
+ *
+ * @param app_p:  A pointer to the main Application object.
+ * @param hal_p:  A pointer to the main HAL object
+ */
+void Application_updateLink(Application* app_p, HAL* hal_p) {
+  static FrameMessage message;
+  int round, i;
+
+  // The other board may already be playing the next round
+  if (Link_receive(&hal_p->link, &message) &&
+      message.type == MSG_LINK_MOVES &&
+      message.length == LINK_MOVES_HEADER + app_p->players &&
+      message.payload[1] == app_p->players &&
+      message.payload[2] == app_p->rounds) {
+    round = message.payload[0];
+    if (round == app_p->rounds_count || round == app_p->rounds_count + 1) {
+      for (i = 0; i < app_p->players; i++) {
+        app_p->link_moves[round % 2][i] =
+            message.payload[LINK_MOVES_HEADER + i];
+      }
+      app_p->link_moves_round[round % 2] = round;
+    }
+  }
+
+  if (!Link_isLost(&hal_p->link)) {
+    return;
+  }
+
+  // The moves in flight were not acknowledged, so this board has not resolved
+  // their round yet. They are kept and sent again, without asking anyone.
+  uart_send_string(&hal_p->uart, "\r\nLink to the other board lost\r\n");
+  app_p->link_sent = false;
+  app_p->link_waiting = false;
+  Link_reset(&hal_p->link);
+}
+
+/**
+ * Dispatches a binary frame received from a machine client.
+ *
+ * @param app_p:      A pointer to the main Application object.
+ * @param hal_p:      A pointer to the main HAL object
+ * @param message_p:  The received frame
+ */
+void Application_handleFrame(Application* app_p, HAL* hal_p,
+                             FrameMessage* message_p) {
+  switch (message_p->type) {
+    case MSG_MOVES:
+      bot_moves(app_p, hal_p, message_p);
+      break;
+
+    case MSG_MATCH:
+      bot_match(hal_p, message_p);
+      break;
+
+    case MSG_PROFILE:
+      bot_profile(hal_p, message_p);
+      break;
+
+    case MSG_POWER:
+      bot_power(hal_p, message_p);
+      break;
+
+    case MSG_COMMIT:
+      bot_commit(app_p, hal_p, message_p);
+      break;
+
+    case MSG_REVEAL:
+      bot_reveal(app_p, hal_p, message_p);
+      break;
+
+    case MSG_TAP:
+      bot_tap(app_p, hal_p, message_p);
+      break;
+
+    case MSG_RESET:
+      bot_reset(hal_p, message_p);
+      break;
+
+    case MSG_BENCH:
+      bot_bench(app_p, hal_p, message_p);
+      break;
+
+    case MSG_TRACE:
+      bot_trace(hal_p, message_p);
+      break;
+
+    case MSG_METRICS:
+      bot_metrics(hal_p, message_p);
+      break;
+
+    default:
+      bot_nack(hal_p, message_p->seq, NACK_TYPE);
+      break;
+  }
+}
+
 void uart_print(Application* app_p, HAL* hal_p) {
     // Static variable to keep track of the current player index
     static int i = 0;
 
     // Check if conditions for UART processing are met
     if ((app_p->screen_state == name_selection && i < app_p->players && app_p->toggle_players)) {
+        // The character received from the serial terminal
+        char rxChar;
+
         // Check if there's a character available from the UART
-        if (UART_hasChar(&hal_p->uart)) {
-            // The character received from the serial terminal
-            char rxChar = UART_getChar(&hal_p->uart);
+        if (Application_getChar(app_p, &rxChar)) {
 
             // Interpret the incoming character
             char txChar = Application_interpretIncomingChar(rxChar);
@@ -246,8 +785,10 @@ void uart_print(Application* app_p, HAL* hal_p) {
                 }
 
                 // Concatenate the received character to the player's name if it's not at maximum length
-                if (strlen(app_p->names[i]) < MAX_NAME_LENGTH - 1) {
-                    strcat(app_p->names[i], &txChar);
+                size_t length = strlen(app_p->names[i]);
+                if (length < MAX_NAME_LENGTH - 1) {
+                    app_p->names[i][length] = txChar;
+                    app_p->names[i][length + 1] = '\0';
 
                     // Send the character back through UART if transmission is possible
                     if (UART_canSend(&hal_p->uart)) {
@@ -271,6 +812,7 @@ void uart_print(Application* app_p, HAL* hal_p) {
 
 // Function for handling the title screen state
 void title_screen_state(Application* app_p, HAL* hal_p){
+    TRACE_ENTER(TRACE_TITLE_SCREEN);
     // Check if boosterpackS1 button is tapped
     if (Button_isTapped(&hal_p->boosterpackS1)){
         // Transition to settings screen
@@ -289,14 +831,17 @@ void title_screen_state(Application* app_p, HAL* hal_p){
         // Print instructions
         print_instructions(app_p, hal_p);
     }
-    else {
-        // Print title
+    else if (!app_p->title_drawn) {
+        // Print title once; it stays on the LCD while the title is waited on
         print_title(app_p, hal_p);
+        app_p->title_drawn = true;
     }
+    TRACE_EXIT(TRACE_TITLE_SCREEN);
 }
 
 // Function for handling the instructions screen state
 void instructions_screen_state(Application* app_p, HAL* hal_p){
+    TRACE_ENTER(TRACE_INSTRUCTIONS_SCREEN);
     // Check if launchpadS2 button is tapped
     if (Button_isTapped(&hal_p->launchpadS2)){
         // Transition to title screen
@@ -306,10 +851,12 @@ void instructions_screen_state(Application* app_p, HAL* hal_p){
         // Print title
         print_title(app_p, hal_p);
     }
+    TRACE_EXIT(TRACE_INSTRUCTIONS_SCREEN);
 }
 
 // Function for handling the settings screen state
 void settings_screen_state(Application* app_p, HAL* hal_p){
+    TRACE_ENTER(TRACE_SETTINGS_SCREEN);
     // Check if boosterpackS1 button is tapped
     if (Button_isTapped(&hal_p->boosterpackS1)){
         // Transition to name selection screen
@@ -321,8 +868,7 @@ void settings_screen_state(Application* app_p, HAL* hal_p){
         // Enable player toggle
         app_p->toggle_players = true;
         // Flush UART buffer
-        if (UART_hasChar(&hal_p->uart))
-            UART_getChar(&hal_p->uart);
+        Application_flushChar(app_p);
     }
     // Check if launchpadS2 button is tapped
     else if (Button_isTapped(&hal_p->launchpadS2)){
@@ -339,17 +885,18 @@ void settings_screen_state(Application* app_p, HAL* hal_p){
         // Print settings with sound enabled
         print_settings(app_p, hal_p, false, true);
     }
+    TRACE_EXIT(TRACE_SETTINGS_SCREEN);
 }
 
 // Function for handling the selection screen state
 void selection_screen_state(Application* app_p, HAL* hal_p){
+    TRACE_ENTER(TRACE_SELECTION_SCREEN);
     // Check if boosterpackS1 button is tapped and conditions for player selection are met
     if (Button_isTapped(&hal_p->boosterpackS1) && ((app_p->players_count == app_p->players) || (app_p->players_count == app_p->players - 1 && strlen(app_p->names[app_p->players_count]) == MAX_NAME_LENGTH - 1))){
         // Null-terminate the current player's name
         app_p->names[app_p->players_count][MAX_NAME_LENGTH - 1] = '\0';
         // Flush UART buffer
-        if (UART_hasChar(&hal_p->uart))
-            UART_getChar(&hal_p->uart);
+        Application_flushChar(app_p);
         // Move to game screen state
         app_p->screen_state = game;
         // Reset wins count
@@ -358,8 +905,19 @@ void selection_screen_state(Application* app_p, HAL* hal_p){
         clear_screen(hal_p);
         // Reset players count
         app_p->players_count = 0;
+        // The scoreboard is drawn in full on the cleared screen
+        app_p->scores_drawn = false;
+        // Nothing of this board's first round was sent yet
+        app_p->link_sent = false;
+        app_p->link_waiting = false;
+        // No machine client committed to a move yet
+        app_p->seats_committed = 0;
+        app_p->seats_revealed = 0;
+        app_p->commit_late = false;
         // Print game screen
         print_game(app_p, hal_p);
+        // Start the round log below the scoreboard
+        ScrollLog_start(&app_p->match_log, &hal_p->g_sContext);
         // Start game round
         game_round(app_p, hal_p);
         // Print newline through UART
@@ -375,27 +933,27 @@ void selection_screen_state(Application* app_p, HAL* hal_p){
             // Null-terminate the current player's name
             app_p->names[app_p->players_count][MAX_NAME_LENGTH - 1] = '\0';
             // Flush UART buffer
-            if (UART_hasChar(&hal_p->uart))
-                UART_getChar(&hal_p->uart);
+            Application_flushChar(app_p);
             // Increment players count
             app_p->players_count++;
             // Clear current player's name if not empty
             if (strlen(app_p->names[app_p->players_count]) != 0)
-                strcpy(app_p->names[app_p->players_count], '\0');
+                app_p->names[app_p->players_count][0] = '\0';
             // Print newline through UART
             uart_new_line(hal_p);
         }
     }
+    TRACE_EXIT(TRACE_SELECTION_SCREEN);
 }
 
 // Function for handling the game screen state
 void game_screen_state(Application* app_p, HAL* hal_p){
+    TRACE_ENTER(TRACE_GAME_SCREEN);
     // Check if boosterpackS1 button is tapped and the maximum number of rounds has not been reached
     if ((Button_isTapped(&hal_p->boosterpackS1) && app_p->rounds_count <= app_p->rounds)){
         // Print scores and start new round
         print_scores(app_p, hal_p);
-        if (UART_hasChar(&hal_p->uart))
-            UART_getChar(&hal_p->uart);
+        Application_flushChar(app_p);
         game_round(app_p, hal_p);
         app_p->players_done = false;
         // Check if all rounds have been played
@@ -411,26 +969,29 @@ void game_screen_state(Application* app_p, HAL* hal_p){
     // If not all players have finished their turns, continue game round
     else if (!app_p->players_done)
         game_round(app_p, hal_p);
+    TRACE_EXIT(TRACE_GAME_SCREEN);
 }
 
 // Function for handling the end screen state
 void end_screen_state(Application* app_p, HAL* hal_p){
+    TRACE_ENTER(TRACE_END_SCREEN);
     // Check if boosterpackS1 button is tapped and end flag is not set
     if (Button_isTapped(&hal_p->boosterpackS1) && !app_p->end){
-        // Clear the screen and print game over message
+        // Put the log band back in place, then clear the screen and print
+        // game over message
+        ScrollLog_stop(&app_p->match_log);
         clear_screen(hal_p);
         print_over(app_p, hal_p);
         // Set end flag
         app_p->end = true;
     }
-    // If end flag is set, return
-    else if (app_p->end)
-        return;
+    TRACE_EXIT(TRACE_END_SCREEN);
 }
 
 
 // Function for managing the game finite state machine
 void Game_FSM(Application* app_p, HAL* hal_p) {
+    TRACE_ENTER(TRACE_GAME_FSM);
     // Switch based on the current screen state
     switch (app_p->screen_state) {
         case title:
@@ -463,6 +1024,7 @@ void Game_FSM(Application* app_p, HAL* hal_p) {
             end_screen_state(app_p, hal_p);
             break;
     }
+    TRACE_EXIT(TRACE_GAME_FSM);
 }
 
 // Function for sending a new line over UART
@@ -481,6 +1043,23 @@ void game_round(Application* app_p, HAL* hal_p){
     static bool err = false;
     static char rxChar;
 
+    // With dedicated seat links, all players enter their moves at once
+    if (app_p->seatLinks){
+        game_round_seats(app_p, hal_p);
+        return;
+    }
+
+    // With a linked board, only this board's seats are prompted here
+    if (app_p->boardLink){
+        game_round_linked(app_p, hal_p);
+        return;
+    }
+
+    // A round machine clients committed to is theirs until it is revealed, or
+    // until its deadline passes
+    if (app_p->seats_committed != 0 && !commit_deadline_passed(app_p))
+        return;
+
     // Check if the current round is less than the total rounds
     if (app_p -> rounds_count < app_p -> rounds){
         // Check if there is no error
@@ -488,10 +1067,8 @@ void game_round(Application* app_p, HAL* hal_p){
             // Send the player's name over UART
             uart_name(hal_p, app_p->names[app_p -> players_count]);
 
-        // Check if UART has received a character
-        if (UART_hasChar(&hal_p->uart))
-            // Get the received character
-            rxChar = UART_getChar(&hal_p->uart);
+        // Check if UART has received a character and get it
+        Application_getChar(app_p, &rxChar);
 
         // Check if the received character is a valid choice
         if (rxChar == 'r' || rxChar == 'p' || rxChar == 's'){
@@ -507,8 +1084,8 @@ void game_round(Application* app_p, HAL* hal_p){
             if (app_p -> players_count == app_p -> players){
                 // Increment the round count
                 app_p -> rounds_count++;
-                // Determine the winners
-                determine_winners(app_p);
+                // Determine the winners and log the round
+                log_round(app_p, hal_p, resolve_round(app_p));
                 // Reset player count and set players_done flag
                 app_p -> players_count = 0;
                 app_p -> players_done = true;
@@ -531,68 +1108,337 @@ void game_round(Application* app_p, HAL* hal_p){
     }
 }
 
-// Function to print the title screen
-void print_title(Application* app_p, HAL* hal_p){
+// Function for handling a single round of the game when every seat has its
+// own UART. All seats are prompted at once and each one's move is taken as
+// soon as it arrives; the round resolves when the last seat has moved.
+void game_round_seats(Application* app_p, HAL* hal_p){
+    static const char ack_text[] = "\r\nMove received, waiting for others\r\n";
+    static int i;
+    uint8_t all_seats = (1 << app_p->players) - 1;
+
+    if (app_p->rounds_count >= app_p->rounds)
+        return;
+
+    // Prompt every seat on its own terminal at the start of the round
+    if (!app_p->seats_prompted){
+        for (i = 0; i < app_p->players; i++){
+            uart_send_string(HAL_seatUart(hal_p, i), "\r\n");
+            uart_send_string(HAL_seatUart(hal_p, i), app_p->names[i]);
+            uart_send_string(HAL_seatUart(hal_p, i), uart_prompt_text);
+        }
+        app_p->seats_prompted = true;
+    }
+
+    // Take the move of every seat which has one waiting
+    for (i = 0; i < app_p->players; i++){
+        char rxChar;
+        UART* uart_p = HAL_seatUart(hal_p, i);
+        bool received;
+
+        if (app_p->seats_moved & (1 << i))
+            continue;
+
+        // Seat 1's terminal is shared with machine clients
+        if (i == 0)
+            received = Application_getChar(app_p, &rxChar);
+        else if ((received = UART_hasChar(uart_p)))
+            rxChar = UART_getChar(uart_p);
+
+        if (!received)
+            continue;
+
+        if (rxChar == 'r' || rxChar == 'p' || rxChar == 's'){
+            app_p->choices[i][0] = rxChar;
+            app_p->choices[i][1] = '\0';
+            app_p->seats_moved |= 1 << i;
+            // Only the seat itself learns that its move was taken
+            uart_send_string(uart_p, ack_text);
+        }
+        else{
+            METRIC_COUNT(METRIC_INVALID_INPUTS);
+            uart_send_string(uart_p, invalid_input_text);
+        }
+    }
+
+    // The round resolves as soon as the last move is in
+    if (app_p->seats_moved == all_seats){
+        app_p->rounds_count++;
+        log_round(app_p, hal_p, resolve_round(app_p));
+        app_p->seats_moved = 0;
+        app_p->seats_prompted = false;
+        app_p->players_done = true;
+        print_BB1(app_p, hal_p);
+    }
+}
+
+// Function for handling a single round of the game when it is shared with a
+// linked board. This board's seats are prompted one after another as usual;
+// their moves then go to the other board, and the round resolves once the
+// other board acknowledged them and its moves for the same round are in.
+void game_round_linked(Application* app_p, HAL* hal_p){
+    static bool err = false;
+    static char rxChar;
+
+    if (app_p->rounds_count >= app_p->rounds)
+        return;
+
+    // Skip the seats of the other board
+    while (app_p->players_count < app_p->players &&
+           !link_owns_seat(app_p->players_count))
+        app_p->players_count++;
+
+    // Take the move of this board's next seat
+    if (app_p->players_count < app_p->players){
+        if (!err)
+            uart_name(hal_p, app_p->names[app_p->players_count]);
+
+        Application_getChar(app_p, &rxChar);
+
+        if (rxChar == 'r' || rxChar == 'p' || rxChar == 's'){
+            err = false;
+            app_p->choices[app_p->players_count][0] = rxChar;
+            app_p->choices[app_p->players_count][1] = '\0';
+            rxChar = '\0';
+            app_p->players_count++;
+        }
+        else if (rxChar == '\0')
+            err = true;
+        else{
+            rxChar = '\0';
+            invalid_input(hal_p);
+            err = true;
+        }
+        return;
+    }
+
+    // All of this board's seats have moved
+    if (!app_p->link_sent)
+        link_send_moves(app_p, hal_p);
+
+    // Only moves are sent over the link, so once the link can send again the
+    // other board has this board's moves. It then resolves the round with
+    // the same moves as this board, and the round is never undone.
+    if (app_p->link_sent && Link_canSend(&hal_p->link) &&
+        app_p->link_moves_round[app_p->rounds_count % 2] == app_p->rounds_count)
+        link_resolve_round(app_p, hal_p);
+    else if (!app_p->link_waiting){
+        uart_send_string(&hal_p->uart, "\r\nWaiting for the other board\r\n");
+        app_p->link_waiting = true;
+    }
+}
+
+// Function to check whether a seat is played on this board
+bool link_owns_seat(int seat){
+    return seat % 2 == BOARD_LINK_ID;
+}
+
+// Function to send this board's moves for the current round to the linked
+// board. Nothing happens while the previous message is still in flight; the
+// next call tries again.
+void link_send_moves(Application* app_p, HAL* hal_p){
+    uint8_t payload[LINK_MOVES_HEADER + MAX_PLAYERS - 1];
+    static int i;
+
+    payload[0] = app_p->rounds_count;
+    payload[1] = app_p->players;
+    payload[2] = app_p->rounds;
+    for (i = 0; i < app_p->players; i++)
+        payload[LINK_MOVES_HEADER + i] =
+            link_owns_seat(i) ? app_p->choices[i][0] : 0;
+
+    if (Link_send(&hal_p->link, MSG_LINK_MOVES, payload,
+                  LINK_MOVES_HEADER + app_p->players))
+        app_p->link_sent = true;
+}
+
+// Function to resolve the current round once both boards have each other's
+// moves
+void link_resolve_round(Application* app_p, HAL* hal_p){
+    static int i;
+    int slot = app_p->rounds_count % 2;
+
+    for (i = 0; i < app_p->players; i++){
+        if (!link_owns_seat(i)){
+            app_p->choices[i][0] = app_p->link_moves[slot][i];
+            app_p->choices[i][1] = '\0';
+        }
+    }
 
-    // Static array to store lines of text
-    static char lines[MAX_LINES][MAX_STRING_LENGTH];
+    app_p->rounds_count++;
+    log_round(app_p, hal_p, resolve_round(app_p));
+    app_p->players_count = 0;
+    app_p->players_done = true;
+    app_p->link_moves_round[slot] = -1;
+    app_p->link_sent = false;
+    app_p->link_waiting = false;
+    print_BB1(app_p, hal_p);
+}
+
+// Function to report the LCD window update bytes once a new screen is drawn.
+// The counts cover everything drawn since the previous screen was drawn,
+// including the updates made on that screen and the drawing of the new one.
+void report_lcd_bytes(Application* app_p, HAL* hal_p){
+    uint32_t sent, saved;
+
+    if (app_p->screen_state == app_p->reported_screen)
+        return;
+
+    Crystalfontz128x128_TakeWindowBytes(&sent, &saved);
+    uart_send_string(&hal_p->uart, "\r\nLCD screen ");
+    Format_decimal(scratch_line, app_p->screen_state);
+    uart_send_string(&hal_p->uart, scratch_line);
+    uart_send_string(&hal_p->uart, ": window bytes sent ");
+    Format_decimal(scratch_line, sent);
+    uart_send_string(&hal_p->uart, scratch_line);
+    uart_send_string(&hal_p->uart, ", saved ");
+    Format_decimal(scratch_line, saved);
+    uart_send_string(&hal_p->uart, scratch_line);
+    uart_send_string(&hal_p->uart, "\r\n");
+
+    app_p->reported_screen = app_p->screen_state;
+}
+
+// Function to report the time from the start of HAL construction to the
+// first frame on the LCD, once the display is on
+void report_boot_time(Application* app_p, HAL* hal_p){
+    if (hal_p->displayBoot != DISPLAY_ON)
+        return;
 
-    // Copy and draw the title text
-    strcpy(lines[2], "Rock Paper Scissors");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[2], -1, 0, 16, true);
+    uart_send_string(&hal_p->uart, "\r\nFirst frame after ");
+    Format_decimal(scratch_line, hal_p->bootTimeUS);
+    uart_send_string(&hal_p->uart, scratch_line);
+    uart_send_string(&hal_p->uart, " us\r\n");
 
-    // Copy and draw the subtitle text
-    strcpy(lines[3], "Multiplayer Game");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[3], -1, 0, 24, true);
+    app_p->boot_reported = true;
+}
 
-    // Copy and draw additional text lines
-    strcpy(lines[4], "My solution");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[4], -1, 0, 32, true);
-    strcpy(lines[6], "Youssef Mentawy");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[6], -1, 0, 48, true);
-    strcpy(lines[10], "BB1: Play Game");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[10], -1, 0, 80, true);
-    strcpy(lines[11], "LB2: Instructions");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[11], -1, 0, 88, true);
+// Function to send a string over a UART
+void uart_send_string(UART* uart_p, const char* text){
+    TRACE_ENTER_ARG(TRACE_UART_SEND, strlen(text));
+    while (*text != '\0')
+        UART_sendChar(uart_p, *text++);
+    TRACE_EXIT(TRACE_UART_SEND);
+}
+
+// Function to compose the value of a field into the scratch line, padded with
+// spaces to the width of its window so that a shorter value covers a longer
+// one drawn before
+static const char* compose_field(Application* app_p, const DisplayItem* item_p){
+    int width = (item_p->window.xMax - item_p->window.xMin + 1) / FONT_WIDTH;
+    int length = 0;
+
+    switch (item_p->field){
+        case FIELD_ROUNDS:
+            length = Format_decimal(scratch_line, app_p->rounds);
+            break;
+        case FIELD_PLAYERS:
+            length = Format_decimal(scratch_line, app_p->players);
+            break;
+        case FIELD_ROUNDS_COUNT:
+            length = Format_decimal(scratch_line, app_p->rounds_count);
+            break;
+        case FIELD_PLAYER_NUMBER:
+            length = Format_decimal(scratch_line, item_p->player + 1);
+            scratch_line[length++] = ')';
+            break;
+        case FIELD_WINS:
+            length = Format_decimal(scratch_line, app_p->wins[item_p->player]);
+            break;
+        case FIELD_NAME:
+            return app_p->names[item_p->player];
+        case FIELD_CHOICE:
+            return app_p->choices[item_p->player];
+        case FIELD_NONE:
+            return item_p->text;
+    }
+
+    while (length < width)
+        scratch_line[length++] = ' ';
+    scratch_line[length] = '\0';
+    return scratch_line;
+}
+
+// Function to draw a display list. Items of players who are not in the game
+// are skipped; everything else fills its window.
+void draw_display_list(Application* app_p, HAL* hal_p, const DisplayItem* items, int count){
+    update_display_list(app_p, hal_p, items, count, NULL, true);
+}
+
+// Function to draw the items of a display list which changed since it was
+// last drawn. shown holds what every item showed then; constant text and the
+// fields of players who are not in the game are only drawn on a full redraw.
+void update_display_list(Application* app_p, HAL* hal_p, const DisplayItem* items, int count,
+                         char (*shown)[FIELD_CACHE_WIDTH], bool redraw){
+    static int i;
+
+    METRIC_COUNT(METRIC_REDRAWS);
+
+    for (i = 0; i < count; i++){
+        const DisplayItem* item_p = &items[i];
+        const char* text;
+
+        if (item_p->player != ANY_PLAYER && item_p->player >= app_p->players)
+            continue;
+        if (!redraw && item_p->field == FIELD_NONE)
+            continue;
+
+        text = compose_field(app_p, item_p);
+        if (shown != NULL && item_p->field != FIELD_NONE){
+            size_t length = strlen(text);
+
+            if (!redraw && strcmp(shown[i], text) == 0)
+                continue;
+            if (length > FIELD_CACHE_WIDTH - 1)
+                length = FIELD_CACHE_WIDTH - 1;
+            memcpy(shown[i], text, length);
+            shown[i][length] = '\0';
+        }
+
+        Text_draw(&item_p->window, text, item_p->color, GRAPHICS_COLOR_BLACK);
+    }
+}
+
+// Function to draw a string which is not part of a display list
+void draw_string(HAL* hal_p, const char* text, int x, int y){
+    // grlib takes a non-const pointer but only reads the string
+    Graphics_drawString(&hal_p->g_sContext, (int8_t *) text, -1, x, y, true);
+}
+
+// Function to put the LCD into its low power modes while a static screen
+// waits for a button. Only the rows of the screen's display list are
+// refreshed; the next drawing wakes the LCD up again.
+void rest_display(HAL* hal_p, const DisplayItem* items, int count){
+    int i;
+    int top = LCD_VERTICAL_MAX - 1;
+    int bottom = 0;
+
+    for (i = 0; i < count; i++){
+        if (items[i].window.yMin < top)
+            top = items[i].window.yMin;
+        if (items[i].window.yMax > bottom)
+            bottom = items[i].window.yMax;
+    }
+
+    // With a framebuffer the screen must reach the LCD before it rests
+    Graphics_flushBuffer(&hal_p->g_sContext);
+    Crystalfontz128x128_EnterLowPower(top, bottom);
+}
+
+// Function to print the title screen
+void print_title(Application* app_p, HAL* hal_p){
+    draw_display_list(app_p, hal_p, title_layout, DISPLAY_LIST_LENGTH(title_layout));
+    rest_display(hal_p, title_layout, DISPLAY_LIST_LENGTH(title_layout));
 }
 
 // Function to print the instructions screen
 void print_instructions(Application* app_p, HAL* hal_p){
-    // Static array to store lines of text
-    static char lines[MAX_LINES][MAX_STRING_LENGTH];
-
-    // Copy and draw each line of text
-    strcpy(lines[0], "    Instructions");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[0], -1, 0, 0, true);
-    strcpy(lines[2], "Select the number of");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[2], -1, 0, 16, true);
-    strcpy(lines[3], "rounds, players, and");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[3], -1, 0, 24, true);
-    strcpy(lines[4], "player's names. Every");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[4], -1, 0, 32, true);
-    strcpy(lines[5], "round all players");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[5], -1, 0, 40, true);
-    strcpy(lines[6], "enter their choice.");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[6], -1, 0, 48, true);
-    strcpy(lines[7], "whoever wins the");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[7], -1, 0, 56, true);
-    strcpy(lines[8], "round gets a point.");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[8], -1, 0, 64, true);
-    strcpy(lines[9], "After all rounds are");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[9], -1, 0, 72, true);
-    strcpy(lines[10], "played, the scores");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[10], -1, 0, 80, true);
-    strcpy(lines[11], "and winners are shown.");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[11], -1, 0, 88, true);
-    strcpy(lines[13], "LB2: Go Back");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[13], -1, 0, 104, true);
+    draw_display_list(app_p, hal_p, instructions_layout, DISPLAY_LIST_LENGTH(instructions_layout));
+    rest_display(hal_p, instructions_layout, DISPLAY_LIST_LENGTH(instructions_layout));
 }
 
 
 // Function to print settings screen
 void print_settings(Application* app_p, HAL* hal_p, bool PR, bool rst){
-    // Static array to store lines of text
-    static char lines[MAX_LINES][MAX_STRING_LENGTH];
     // Static variables to store positions of asterisk and space
     static int astr_y = PLAYERS_POS;
     static int space_y = ROUNDS_POS;
@@ -600,50 +1446,16 @@ void print_settings(Application* app_p, HAL* hal_p, bool PR, bool rst){
     // Toggle positions based on input parameters
     Toggle(&astr_y, &space_y, &app_p -> players, &app_p -> rounds, PR, rst);
 
-    // Draw "Choose Settings" text on the screen
-    strcpy(lines[0], "   Choose Settings");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[0], -1, 0, 0, true);
-
-    // Draw instructions for changing settings
-    strcpy(lines[2], "Press JSB to change #");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[2], -1, 0, 16, true);
-    strcpy(lines[3], "Press LB2 to switch");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[3], -1, 0, 24, true);
-    strcpy(lines[4], "between players");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[4], -1, 0, 32, true);
-    strcpy(lines[5], "and # of Rounds");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[5], -1, 0, 40, true);
-
-    // Draw current number of rounds
-    strcpy(lines[7], "# of Rounds: ");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[7], -1, 5, 56, true);
-    sprintf(lines[8], "%d", app_p -> rounds);
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[8], -1, 90, 56, true);
-
-    // Draw current number of players
-    strcpy(lines[9], "# of Players:");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[9], -1, 5, 72, true);
-    sprintf(lines[10], "%d", app_p -> players);
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[10], -1, 90, 72, true);
-
-    // Draw confirmation and reset options
-    strcpy(lines[11], "BB1: Confirm");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[11], -1, 5, 88, true);
-    strcpy(lines[12], "LB1: Reset Settings");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[12], -1, 5, 96, true);
+    draw_display_list(app_p, hal_p, settings_layout, DISPLAY_LIST_LENGTH(settings_layout));
 
     // Draw asterisk and space indicators
-    strcpy(lines[15], "*");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[15], -1, 105, astr_y, true);
-    strcpy(lines[14], " ");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[14], -1, 105, space_y, true);
+    draw_string(hal_p, "*", 105, astr_y);
+    draw_string(hal_p, " ", 105, space_y);
 }
 
 
 // Function to print the name selection screen
 void print_selection(Application* app_p, HAL* hal_p){
-    // Static array to store lines of text
-    static char lines[MAX_LINES][MAX_STRING_LENGTH];
     // Static variables to store positions of asterisk and space
     static int astr_y = 0;
     static int space_y = 8;
@@ -655,46 +1467,17 @@ void print_selection(Application* app_p, HAL* hal_p){
         astr_y += Y_INCREMENTAL;
     }
 
-    // Draw "Name Select Screen" text on the screen
-    strcpy(lines[0], "Name Select Screen");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[0], -1, 0, 0, true);
-
-    static int i;
-
-    // Draw player numbers for selection
-    for (i = 1; i <= app_p->players; i++) {
-        sprintf(lines[i], "%d)", i);
-        Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[i], -1, 10, i*8, true);
-    }
-
-    // Draw instructions for name input
-    strcpy(lines[6], "Type 3 letters into");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[6], -1, 0, 40, true);
-    strcpy(lines[7], "the UART terminal,");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[7], -1, 0, 48, true);
-    strcpy(lines[8], "then press BB1 to");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[8], -1, 0, 56, true);
-    strcpy(lines[9], "move to the next");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[9], -1, 0, 64, true);
-    strcpy(lines[10], "player or start the");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[10], -1, 0, 72, true);
-    strcpy(lines[11], "game.");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[11], -1, 0, 80, true);
+    draw_display_list(app_p, hal_p, selection_layout, DISPLAY_LIST_LENGTH(selection_layout));
 
     // Draw space and asterisk indicators
-    strcpy(lines[14], " ");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[14], -1, 0, space_y, true);
-    strcpy(lines[15], "*");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) lines[15], -1, 0, astr_y, true);
+    draw_string(hal_p, " ", 0, space_y);
+    draw_string(hal_p, "*", 0, astr_y);
 }
 
 
 // Function to print the game screen
 void print_game(Application* app_p, HAL* hal_p){
-    // Static array to store game text
-    static char game_text[] = "Game Screen";
-    // Draw the game screen text on the display
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) game_text, -1, 0, 0, true);
+    draw_display_list(app_p, hal_p, game_layout, DISPLAY_LIST_LENGTH(game_layout));
 }
 
 // Function to print the message for pressing BB1 to play the round
@@ -705,8 +1488,10 @@ void print_BB1(Application* app_p, HAL* hal_p){
     // Move to a new line in UART output
     uart_new_line(hal_p);
     // Loop through the characters in the text and send them via UART
+    TRACE_ENTER_ARG(TRACE_UART_SEND, strlen(BB1_text));
     for (i = 0; i<strlen(BB1_text); i++)
         UART_sendChar(&hal_p->uart, BB1_text[i]);
+    TRACE_EXIT(TRACE_UART_SEND);
 }
 
 // Function to print the message for pressing BB1 to end the game
@@ -717,142 +1502,80 @@ void print_BB1_end(Application* app_p, HAL* hal_p){
     // Move to a new line in UART output
     uart_new_line(hal_p);
     // Loop through the characters in the text and send them via UART
+    TRACE_ENTER_ARG(TRACE_UART_SEND, strlen(BB1_text));
     for (i = 0; i<strlen(BB1_text); i++)
         UART_sendChar(&hal_p->uart, BB1_text[i]);
+    TRACE_EXIT(TRACE_UART_SEND);
 }
 
 // Function to print the message for pressing BB1 to end
 void print_BB1_end_screen(Application* app_p, HAL* hal_p){
-    // Static text for the message
-    static char BB1_text[] = "Press BB1 to end";
-    // Draw the message on the display
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *) BB1_text, -1, 20, 64, true);
+    draw_display_list(app_p, hal_p, end_prompt_layout, DISPLAY_LIST_LENGTH(end_prompt_layout));
 }
 
 
-// Function to print scores
+// Function to print scores. Once the scoreboard is on the screen, only the
+// fields and icons which changed since the last round are drawn again.
 void print_scores(Application* app_p, HAL* hal_p){
-    // Static array to store lines
-    static char lines[MAX_LINES][MAX_STRING_LENGTH];
-
-    // Static variable to store loop index
     static int i;
 
-    // Loop through players
+    update_display_list(app_p, hal_p, scores_layout, DISPLAY_LIST_LENGTH(scores_layout),
+                        app_p->scores_shown, !app_p->scores_drawn);
+
+    // Draw an icon of each player's choice next to their name
     for (i = 0; i < app_p->players; i++){
-        // Check if the index is even
-        if (i % 2 == 0){
-            // Copy player name to line array
-            strcpy(lines[i], app_p->names[i]);
-            // Draw player name on the display
-            Graphics_drawString(&hal_p->g_sContext, (int8_t *)lines[i], -1, 5, (i + 1) * 24, true);
-
-            // Copy player choice to line array
-            strcpy(lines[i + 4], app_p->choices[i]);
-            // Draw player choice on the display
-            Graphics_drawString(&hal_p->g_sContext, (int8_t *)app_p->choices[i], -1, 5, ((i + 1) * 24) + 8, true);
-
-            // Draw "wins:" on the display
-            strcpy(lines[i + 8], "wins:");
-            Graphics_drawString(&hal_p->g_sContext, (int8_t *)lines[i + 8], -1, 5, ((i + 1) * 24) + 16, true);
-
-            // Copy player wins to line array
-            strcpy(lines[i + 12], "");
-            sprintf(lines[i + 12] + strlen(lines[i + 12]), "%d", app_p->wins[i]);
-            // Draw player wins on the display
-            Graphics_drawString(&hal_p->g_sContext, (int8_t *)lines[i + 12], -1, 35, ((i + 1) * 24) + 16, true);
-        } else {
-            // Copy player name to line array
-            strcpy(lines[i], app_p->names[i]);
-            // Draw player name on the display
-            Graphics_drawString(&hal_p->g_sContext, (int8_t *)lines[i], -1, 85, i * 24, true);
-
-            // Copy player choice to line array
-            strcpy(lines[i + 4], app_p->choices[i]);
-            // Draw player choice on the display
-            Graphics_drawString(&hal_p->g_sContext, (int8_t *)lines[i + 4], -1, 85, (i * 24) + 8, true);
-
-            // Draw "wins:" on the display
-            strcpy(lines[8], "wins:");
-            Graphics_drawString(&hal_p->g_sContext, (int8_t *)lines[8], -1, 85, (i * 24) + 16, true);
-
-            // Copy player wins to line array
-            strcpy(lines[i + 12], "");
-            sprintf(lines[i + 12] + strlen(lines[i + 12]), "%d", app_p->wins[i]);
-            // Draw player wins on the display
-            Graphics_drawString(&hal_p->g_sContext, (int8_t *)lines[i + 12], -1, 115, (i * 24) + 16, true);
-        }
-    }
+        const Sprite* icon_p = choice_icon(app_p->choices[i][0]);
 
-    // Draw "Round" on the display
-    strcpy(lines[8], "Round");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *)lines[8], -1, 45, 56, true);
+        if (app_p->scores_drawn && app_p->icons_shown[i] == app_p->choices[i][0])
+            continue;
+        app_p->icons_shown[i] = app_p->choices[i][0];
+        if (icon_p != NULL)
+            Sprite_draw(icon_p, icon_positions[i][0], icon_positions[i][1]);
+    }
+    app_p->scores_drawn = true;
+}
 
-    // Copy rounds count to line array
-    strcpy(lines[9], "");
-    sprintf(lines[9] + strlen(lines[i + 12]), "%d", app_p->rounds_count);
-    // Draw rounds count on the display
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *)lines[9], -1, 80, 56, true);
+// Function to find the icon of a choice, or NULL for no choice
+const Sprite* choice_icon(char choice){
+    switch (choice){
+        case 'r': case 'R':
+            return &rockIcon;
+        case 'p': case 'P':
+            return &paperIcon;
+        case 's': case 'S':
+            return &scissorsIcon;
+        default:
+            return NULL;
+    }
 }
 
 
 // Function to handle invalid input
 void invalid_input(HAL* hal_p){
-    // Error message
-    char error_msg[] = "Enter an R/r/P/p/S/s to choose\r\n";
-    // Static variable to store loop index
-    static int i;
+    METRIC_COUNT(METRIC_INVALID_INPUTS);
     // Check if UART can send
     if (UART_canSend(&hal_p->uart)){
-        // Loop through the error message and send each character via UART
-        for (i = 0; i < strlen(error_msg); i++)
-            UART_sendChar(&hal_p->uart, error_msg[i]);
+        // Send the error message via UART
+        uart_send_string(&hal_p->uart, invalid_input_text);
     }
 }
 
 // Function to prompt user to enter name and game choices
 void uart_name(HAL* hal_p, char* name){
-    // Text prompting user to enter name and game choices
-    char game_text[] = ", please enter\r\nR or r for Rock\r\nP or p for Paper\r\nS or s for Scissors\r\n";
-    // Static variable to store loop index
-    static int i;
     // New line in UART
     uart_new_line(hal_p);
-    // Loop through the name and send each character via UART
-    for (i = 0; i < strlen(name); i++)
-        UART_sendChar(&hal_p->uart, name[i]);
-    // Loop through the game text and send each character via UART
-    for (i = 0; i < strlen(game_text); i++)
-        UART_sendChar(&hal_p->uart, game_text[i]);
+    // Send the name, then the text prompting for a game choice
+    uart_send_string(&hal_p->uart, name);
+    uart_send_string(&hal_p->uart, uart_prompt_text);
 }
 
 // Function to print the end screen with winners and scores
 void print_over(Application* app_p, HAL* hal_p){
-    // Static array to store lines
-    static char lines[MAX_LINES][MAX_STRING_LENGTH];
-    // Draw "End Screen" on the display
-    strcpy(lines[13], "End Screen");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *)lines[13], -1, 0, 0, true);
     // Static variables to store loop indexes and winner count
     static int i, j = 1;
-    // Loop through players
-    for (i = 0; i < app_p->players; i++){
-        // Copy player name to line array
-        strcpy(lines[i], app_p->names[i]);
-        // Draw player name on the display
-        Graphics_drawString(&hal_p->g_sContext, (int8_t *)lines[i], -1, 0, (24 * i) + 16, true);
-        // Draw "wins:" on the display
-        strcpy(lines[i + 8], "wins:");
-        Graphics_drawString(&hal_p->g_sContext, (int8_t *)lines[i + 8], -1, 0, ((24 * i) + 16) + 8, true);
-        // Copy player wins to line array
-        strcpy(lines[i + 4], "");
-        sprintf(lines[i + 4] + strlen(lines[i + 4]), "%d", app_p->wins[i]);
-        // Draw player wins on the display
-        Graphics_drawString(&hal_p->g_sContext, (int8_t *)lines[i + 4], -1, 30, ((24 * i) + 16) + 8, true);
-    }
-    // Draw "Winners:" on the display
-    strcpy(lines[12], "Winners:");
-    Graphics_drawString(&hal_p->g_sContext, (int8_t *)lines[12], -1, 50, 32, true);
+
+    draw_display_list(app_p, hal_p, over_layout, DISPLAY_LIST_LENGTH(over_layout));
+
     // Find the maximum wins
     int max = app_p->wins[0];
     for (i = 1; i < app_p->players; i++){
@@ -862,11 +1585,15 @@ void print_over(Application* app_p, HAL* hal_p){
     // Loop through players to find winners
     for (i = 0; i < app_p->players; i++){
         if (app_p->wins[i] == max){
-            // Draw winner names on the display
+            // Draw winner names on the display, followed by the winner icon
             Graphics_drawString(&hal_p->g_sContext, (int8_t *)app_p->names[i], -1, 50, (8 * j) + 32, true);
+            Sprite_draw(&winnerIcon, WINNER_ICON_X, (8 * j) + 32);
             j++;
         }
     }
+
+    // The winners are drawn inside the rows of the layout
+    rest_display(hal_p, over_layout, DISPLAY_LIST_LENGTH(over_layout));
 }
 
 // Function to clear the screen
@@ -977,3 +1704,700 @@ void wins_rst(Application* app_p){
     for (i = 0; i < app_p -> players; i++)
         app_p -> wins[i] = 0;
 }
+
+// Function to check that a run of moves only holds rock, paper or scissors
+bool valid_moves(const uint8_t* moves, int count){
+    static int i;
+    for (i = 0; i < count; i++){
+        if (moves[i] != 'r' && moves[i] != 'p' && moves[i] != 's' &&
+            moves[i] != 'R' && moves[i] != 'P' && moves[i] != 'S')
+            return false;
+    }
+    return true;
+}
+
+// Function to play one round from a list of moves, returning a mask of the
+// players who won it
+uint8_t play_round(Application* app_p, const uint8_t* moves){
+    static int i;
+
+    // Record every player's choice
+    for (i = 0; i < app_p->players; i++){
+        app_p->choices[i][0] = moves[i];
+        app_p->choices[i][1] = '\0';
+    }
+
+    return resolve_round(app_p);
+}
+
+// Function to score the round of the current choices, returning a mask of the
+// players who won it
+uint8_t resolve_round(Application* app_p){
+    static int i;
+    int wins_before[MAX_PLAYERS - 1];
+    uint8_t winners = 0;
+
+    // Remember the score before the round
+    for (i = 0; i < app_p->players; i++)
+        wins_before[i] = app_p->wins[i];
+
+    determine_winners(app_p);
+
+    // Whoever gained a point won the round
+    for (i = 0; i < app_p->players; i++){
+        if (app_p->wins[i] != wins_before[i])
+            winners |= 1 << i;
+    }
+    return winners;
+}
+
+// Function to add a round to the match log, as the round number, every
+// player's choice and the numbers of the players who won it
+void log_round(Application* app_p, HAL* hal_p, uint8_t winners){
+    char line[SCROLL_LOG_LINE_LENGTH + 1];
+    static int i;
+    int length = 0;
+
+    line[length++] = 'R';
+    length += Format_decimal(&line[length], app_p->rounds_count);
+    line[length++] = ' ';
+    for (i = 0; i < app_p->players; i++)
+        line[length++] = app_p->choices[i][0];
+    strcpy(&line[length], " win");
+    length += 4;
+    for (i = 0; i < app_p->players; i++){
+        if (winners & (1 << i)){
+            line[length++] = ' ';
+            line[length++] = '1' + i;
+        }
+    }
+    line[length] = '\0';
+
+    ScrollLog_addLine(&app_p->match_log, &hal_p->g_sContext, line);
+    METRIC_COUNT(METRIC_ROUNDS);
+}
+
+// Function to reject a frame from a machine client
+void bot_nack(HAL* hal_p, uint8_t seq, uint8_t reason){
+    Frame_send(&hal_p->uart, MSG_NACK, seq, &reason, 1);
+}
+
+// Function to play one or more rounds of the running game from a MOVES frame.
+// Payload: number of rounds, then every player's move for each round.
+// Reply: rounds played so far, players, each player's wins, then a winner
+// mask for each round of the frame.
+void bot_moves(Application* app_p, HAL* hal_p, FrameMessage* message_p){
+    static uint8_t reply[FRAME_MAX_PAYLOAD];
+    static int i;
+    int rounds = message_p->payload[0];
+    const uint8_t* moves = &message_p->payload[1];
+
+    // Moves are only accepted between rounds of a running game, and never
+    // while the game is shared with a linked board
+    if (app_p->screen_state != game || app_p->players_count != 0 ||
+        app_p->seats_moved != 0 || app_p->seats_committed != 0 ||
+        app_p->boardLink){
+        bot_nack(hal_p, message_p->seq, NACK_STATE);
+        return;
+    }
+    if (message_p->length < 1 || rounds < 1 ||
+        rounds > app_p->rounds - app_p->rounds_count ||
+        message_p->length != 1 + rounds * app_p->players ||
+        !valid_moves(moves, rounds * app_p->players)){
+        bot_nack(hal_p, message_p->seq, NACK_FORMAT);
+        return;
+    }
+
+    // Play every round of the frame, one after another
+    int length = 2 + app_p->players;
+    for (i = 0; i < rounds; i++){
+        reply[length] = play_round(app_p, &moves[i * app_p->players]);
+        app_p->rounds_count++;
+        log_round(app_p, hal_p, reply[length++]);
+    }
+
+    bot_result(app_p, hal_p, message_p->seq, reply, length);
+}
+
+// Function to answer the rounds a machine client played with a RESULT frame
+// and show the new scores. The winner masks are already in the reply after
+// the header of rounds played, players and each player's wins.
+void bot_result(Application* app_p, HAL* hal_p, uint8_t seq, uint8_t* reply, int length){
+    static int i;
+
+    reply[0] = app_p->rounds_count;
+    reply[1] = app_p->players;
+    for (i = 0; i < app_p->players; i++)
+        reply[2 + i] = app_p->wins[i];
+    Frame_send(&hal_p->uart, MSG_RESULT, seq, reply, length);
+
+    // Show the new scores once for the whole frame
+    app_p->players_done = false;
+    print_scores(app_p, hal_p);
+    if (app_p->rounds_count == app_p->rounds){
+        app_p->screen_state = game_over;
+        print_BB1_end_screen(app_p, hal_p);
+        print_BB1_end(app_p, hal_p);
+    }
+}
+
+// Function to give up a commit-reveal round whose seats did not all reveal
+// within COMMIT_DEADLINE_MS of its first commitment. The commitments are
+// dropped, so the round is open to human input and new commitments again.
+// Returns true if the round was given up.
+bool commit_deadline_passed(Application* app_p){
+    if (app_p->seats_committed == 0 || !SWTimer_expired(&app_p->commitTimer))
+        return false;
+
+    app_p->seats_committed = 0;
+    app_p->seats_revealed = 0;
+    app_p->commit_late = true;
+    return true;
+}
+
+// Function to take one seat's commitment to its move for the next round of
+// the running game. A seat cannot change its commitment, and commitments are
+// only taken from the start of a round until every seat has committed.
+// Payload: seat, then the commitment.
+// Reply: seat, then the mask of seats committed so far.
+void bot_commit(Application* app_p, HAL* hal_p, FrameMessage* message_p){
+    uint8_t seat = message_p->payload[0];
+    uint8_t reply[2];
+
+    if (app_p->screen_state != game || app_p->players_count != 0 ||
+        app_p->rounds_count == app_p->rounds || app_p->seatLinks ||
+        app_p->boardLink){
+        bot_nack(hal_p, message_p->seq, NACK_STATE);
+        return;
+    }
+    if (message_p->length != COMMIT_HEADER + COMMIT_LENGTH ||
+        seat >= app_p->players){
+        bot_nack(hal_p, message_p->seq, NACK_FORMAT);
+        return;
+    }
+    commit_deadline_passed(app_p);
+    if (app_p->seats_committed & (1 << seat)){
+        bot_nack(hal_p, message_p->seq, NACK_STATE);
+        return;
+    }
+
+    // The first commitment starts the round's deadline
+    if (app_p->seats_committed == 0){
+        SWTimer_start(&app_p->commitTimer);
+        app_p->commit_late = false;
+    }
+    memcpy(app_p->commitments[seat], &message_p->payload[COMMIT_HEADER],
+           COMMIT_LENGTH);
+    app_p->seats_committed |= 1 << seat;
+
+    reply[0] = seat;
+    reply[1] = app_p->seats_committed;
+    Frame_send(&hal_p->uart, MSG_COMMIT_RESULT, message_p->seq, reply, 2);
+}
+
+// Function to take one seat's revealed move, once every seat has committed.
+// The move is checked against the seat's commitment on the AES256 module; the
+// round is played when the last seat has revealed.
+// Payload: seat, move, then the key of the commitment.
+// Reply: seat, then the mask of seats revealed so far, or the RESULT of the
+// round for the last seat.
+void bot_reveal(Application* app_p, HAL* hal_p, FrameMessage* message_p){
+    static uint8_t reply[3 + MAX_PLAYERS];
+    uint8_t all_seats = (1 << app_p->players) - 1;
+    uint8_t seat = message_p->payload[0];
+    uint8_t move = message_p->payload[1];
+
+    if (app_p->screen_state == game && commit_deadline_passed(app_p)){
+        bot_nack(hal_p, message_p->seq, NACK_LATE);
+        return;
+    }
+    if (app_p->screen_state != game || app_p->seats_committed != all_seats){
+        bot_nack(hal_p, message_p->seq,
+                 app_p->commit_late && app_p->seats_committed == 0 ? NACK_LATE : NACK_STATE);
+        return;
+    }
+    if (message_p->length != REVEAL_HEADER + COMMIT_KEY_LENGTH ||
+        seat >= app_p->players || !valid_moves(&move, 1)){
+        bot_nack(hal_p, message_p->seq, NACK_FORMAT);
+        return;
+    }
+    if (app_p->seats_revealed & (1 << seat)){
+        bot_nack(hal_p, message_p->seq, NACK_STATE);
+        return;
+    }
+    if (!Commit_verify(app_p->commitments[seat],
+                       &message_p->payload[REVEAL_HEADER],
+                       app_p->rounds_count + 1, seat, move)){
+        bot_nack(hal_p, message_p->seq, NACK_COMMIT);
+        return;
+    }
+
+    app_p->revealed_moves[seat] = move;
+    app_p->seats_revealed |= 1 << seat;
+
+    if (app_p->seats_revealed != all_seats){
+        reply[0] = seat;
+        reply[1] = app_p->seats_revealed;
+        Frame_send(&hal_p->uart, MSG_REVEAL_RESULT, message_p->seq, reply, 2);
+        return;
+    }
+
+    // Every move is in: play the round and free it for the next commitments
+    app_p->seats_committed = 0;
+    app_p->seats_revealed = 0;
+    reply[2 + app_p->players] = play_round(app_p, app_p->revealed_moves);
+    app_p->rounds_count++;
+    log_round(app_p, hal_p, reply[2 + app_p->players]);
+
+    bot_result(app_p, hal_p, message_p->seq, reply, 3 + app_p->players);
+}
+
+// Function to evaluate a stand-alone batch of rounds from a MATCH frame,
+// without touching the running game.
+// Payload: number of players, number of rounds, then every player's move for
+// each round.
+// Reply: players, rounds, each player's wins, then a winner mask per round.
+void bot_match(HAL* hal_p, FrameMessage* message_p){
+    static Application match;
+    static uint8_t reply[FRAME_MAX_PAYLOAD];
+    static int i;
+    int players = message_p->payload[0];
+    int rounds = message_p->payload[1];
+    const uint8_t* moves = &message_p->payload[2];
+
+    if (message_p->length < 2 || players < MIN_PLAYERS ||
+        players > MAX_PLAYERS - 1 || rounds < 1 ||
+        2 + players + rounds > FRAME_MAX_PAYLOAD ||
+        message_p->length != 2 + rounds * players ||
+        !valid_moves(moves, rounds * players)){
+        bot_nack(hal_p, message_p->seq, NACK_FORMAT);
+        return;
+    }
+
+    match.players = players;
+    wins_rst(&match);
+
+    int length = 2 + players;
+    for (i = 0; i < rounds; i++)
+        reply[length++] = play_round(&match, &moves[i * players]);
+
+    reply[0] = players;
+    reply[1] = rounds;
+    for (i = 0; i < players; i++)
+        reply[2 + i] = match.wins[i];
+    Frame_send(&hal_p->uart, MSG_MATCH_RESULT, message_p->seq, reply, length);
+}
+
+// Function to put a 32-bit value into a reply, little endian
+static uint8_t* put_uint32(uint8_t* out_p, uint32_t value){
+    out_p[0] = value;
+    out_p[1] = value >> 8;
+    out_p[2] = value >> 16;
+    out_p[3] = value >> 24;
+    return out_p + 4;
+}
+
+// Function to start, stop or dump the profiler on request of a machine
+// client. Only the used slots are dumped, and only while the profiler is
+// stopped, so that the dump is consistent.
+void bot_profile(HAL* hal_p, FrameMessage* message_p){
+    static uint8_t reply[FRAME_MAX_PAYLOAD];
+    const ProfilerSlot* slots = Profiler_slots();
+    uint8_t command = message_p->payload[0];
+    int used = 0;
+    int frames, i;
+
+    if (message_p->length != 1 || command > PROFILE_DUMP ||
+        (command == PROFILE_DUMP && Profiler_isRunning())){
+        bot_nack(hal_p, message_p->seq, NACK_FORMAT);
+        return;
+    }
+
+    if (command != PROFILE_DUMP){
+        if (command == PROFILE_START)
+            Profiler_start();
+        else
+            Profiler_stop();
+        Frame_send(&hal_p->uart, MSG_PROFILE_RESULT, message_p->seq, &command, 1);
+        return;
+    }
+
+    for (i = 0; i < PROFILER_SLOTS; i++){
+        if (slots[i].count != 0)
+            used++;
+    }
+    frames = (used + PROFILE_DUMP_SLOTS - 1) / PROFILE_DUMP_SLOTS;
+
+    reply[0] = PROFILE_DUMP;
+    reply[1] = frames;
+    put_uint32(put_uint32(&reply[PROFILE_DUMP_HEADER], Profiler_samples()),
+               Profiler_dropped());
+    Frame_send(&hal_p->uart, MSG_PROFILE_RESULT, message_p->seq, reply,
+               PROFILE_DUMP_HEADER + 8);
+
+    uint8_t* out_p = &reply[PROFILE_DUMP_HEADER];
+    for (i = 0; i < PROFILER_SLOTS; i++){
+        if (slots[i].count == 0)
+            continue;
+        out_p = put_uint32(out_p, slots[i].pc);
+        out_p = put_uint32(out_p, slots[i].lr);
+        out_p = put_uint32(out_p, slots[i].count);
+        used--;
+
+        // Send a full frame, or the last one
+        if (out_p == &reply[PROFILE_DUMP_HEADER + PROFILE_DUMP_SLOTS * PROFILE_SLOT_BYTES] ||
+            used == 0){
+            reply[1] = --frames;
+            Frame_send(&hal_p->uart, MSG_PROFILE_RESULT, message_p->seq, reply,
+                       out_p - reply);
+            out_p = &reply[PROFILE_DUMP_HEADER];
+        }
+    }
+}
+
+// Function to report the time spent in each power mode on request of a
+// machine
+void bot_power(HAL* hal_p, FrameMessage* message_p){
+    uint8_t reply[POWER_RESULT_LENGTH];
+    uint8_t* out_p = reply;
+    int mode;
+
+    if (message_p->length != 0){
+        bot_nack(hal_p, message_p->seq, NACK_FORMAT);
+        return;
+    }
+
+    // Include the active time up to now
+    Power_account();
+    for (mode = 0; mode < NUM_POWER_MODES; mode++)
+        out_p = put_uint32(out_p, Power_timeMS((PowerMode)mode));
+    put_uint32(out_p, Power_sleeps());
+
+    Frame_send(&hal_p->uart, MSG_POWER_RESULT, message_p->seq, reply,
+               POWER_RESULT_LENGTH);
+}
+
+// Function to tap a button on behalf of a machine, such as a load generator
+// playing whole games through the ASCII prompts
+void bot_tap(Application* app_p, HAL* hal_p, FrameMessage* message_p){
+    uint8_t reply[TAP_RESULT_LENGTH];
+    Button* button_p;
+
+    if (message_p->length != 1){
+        bot_nack(hal_p, message_p->seq, NACK_FORMAT);
+        return;
+    }
+
+    switch (message_p->payload[0]){
+        case TAP_LAUNCHPAD_S1:
+            button_p = &hal_p->launchpadS1;
+            break;
+        case TAP_LAUNCHPAD_S2:
+            button_p = &hal_p->launchpadS2;
+            break;
+        case TAP_BOOSTERPACK_S1:
+            button_p = &hal_p->boosterpackS1;
+            break;
+        case TAP_BOOSTERPACK_S2:
+            button_p = &hal_p->boosterpackS2;
+            break;
+        case TAP_BOOSTERPACK_JS:
+            button_p = &hal_p->boosterpackJS;
+            break;
+        default:
+            bot_nack(hal_p, message_p->seq, NACK_FORMAT);
+            return;
+    }
+
+    // Frames are taken in before Game_FSM, which sees the tap in this loop
+    Button_tap(button_p);
+
+    reply[0] = message_p->payload[0];
+    reply[1] = (uint8_t)app_p->screen_state;
+    Frame_send(&hal_p->uart, MSG_TAP_RESULT, message_p->seq, reply,
+               TAP_RESULT_LENGTH);
+}
+
+// Function to restart the board on request of a machine, so that games can be
+// played back to back from the title screen
+void bot_reset(HAL* hal_p, FrameMessage* message_p){
+    if (message_p->length != 0){
+        bot_nack(hal_p, message_p->seq, NACK_FORMAT);
+        return;
+    }
+
+    Frame_send(&hal_p->uart, MSG_RESET_RESULT, message_p->seq, NULL, 0);
+
+    // Let the reply leave the UART before everything is reset
+    UART_waitIdle(&hal_p->uart);
+    ResetCtl_initiateHardReset();
+}
+
+// What the benchmark cases run on. The application and the HAL are copies,
+// so that the cases cannot change the running game: the buttons, timers and
+// scoreboard caches they update are the copies' own. The copied HAL has no
+// board link to resend on and no LCD power-up to continue, so only the
+// renderers reach the hardware, and they draw on the bench screen of
+// bot_bench().
+static struct {
+    Application app;
+    HAL hal;
+} bench_context;
+
+// Input of the character case, read anew on every call
+static volatile char bench_char = 'r';
+
+static void bench_hal_refresh(void* context_p){
+    HAL_refresh(&bench_context.hal);
+}
+
+static void bench_button_refresh(void* context_p){
+    Button_refresh(&bench_context.hal.boosterpackS1);
+}
+
+static void bench_timer_expired(void* context_p){
+    SWTimer_expired(&bench_context.app.idleTimer);
+}
+
+static void bench_game_fsm(void* context_p){
+    Game_FSM(&bench_context.app, &bench_context.hal);
+}
+
+static void bench_determine_winners(void* context_p){
+    determine_winners(&bench_context.app);
+}
+
+static void bench_interpret_char(void* context_p){
+    Application_interpretIncomingChar(bench_char);
+}
+
+static void bench_print_title(void* context_p){
+    print_title(&bench_context.app, &bench_context.hal);
+}
+
+static void bench_print_settings(void* context_p){
+    print_settings(&bench_context.app, &bench_context.hal, false, true);
+}
+
+// The whole scoreboard, as it is drawn in the first round of a game
+static void bench_print_scores(void* context_p){
+    bench_context.app.scores_drawn = false;
+    print_scores(&bench_context.app, &bench_context.hal);
+}
+
+// The three move icons, each decoded from its runs into one RAMWR window
+static void bench_sprite_draw(void* context_p){
+    Sprite_draw(&rockIcon, 0, 0);
+    Sprite_draw(&paperIcon, ICON_SIZE, 0);
+    Sprite_draw(&scissorsIcon, 2 * ICON_SIZE, 0);
+}
+
+// The same icons drawn one pixel at a time through grlib, a window per pixel,
+// as bitmaps were drawn before the sprites
+static void bench_sprite_pixels(void* context_p){
+    static const Sprite* const icons[] = {&rockIcon, &paperIcon, &scissorsIcon};
+    Graphics_Context* context = &bench_context.hal.g_sContext;
+    int i, pixel;
+
+    for (i = 0; i < 3; i++){
+        const SpriteRun* run_p = icons[i]->runs;
+        uint16_t left = run_p->length;
+
+        for (pixel = 0; pixel < ICON_SIZE * ICON_SIZE; pixel++){
+            uint16_t color;
+
+            while (left == 0)
+                left = (++run_p)->length;
+            left--;
+
+            // RGB565 back to the RGB888 grlib takes
+            color = run_p->color;
+            Graphics_setForegroundColor(context, ((uint32_t)(color & 0xF800) << 8) |
+                                                 ((uint32_t)(color & 0x07E0) << 5) |
+                                                 ((uint32_t)(color & 0x001F) << 3));
+            Graphics_drawPixel(context, i * ICON_SIZE + pixel % ICON_SIZE,
+                               pixel / ICON_SIZE);
+        }
+    }
+}
+
+// The functions which run every loop, then the renderers from
+// FIRST_RENDER_CASE on
+static const BenchCase bench_cases[] = {
+    {"HAL_refresh", bench_hal_refresh},
+    {"Button_refresh", bench_button_refresh},
+    {"SWTimer_expired", bench_timer_expired},
+    {"Game_FSM", bench_game_fsm},
+    {"determine_winners", bench_determine_winners},
+    {"Application_interpretIncomingChar", bench_interpret_char},
+    {"print_title", bench_print_title},
+    {"print_settings", bench_print_settings},
+    {"print_scores", bench_print_scores},
+    {"Sprite_draw", bench_sprite_draw},
+    {"sprite_pixels", bench_sprite_pixels},
+};
+#define NUM_BENCH_CASES (sizeof(bench_cases) / sizeof(bench_cases[0]))
+#define FIRST_RENDER_CASE 6
+
+// Function to run one benchmark case on request of a machine. The copy of
+// the application sits on the drawn title screen without taps, so Game_FSM
+// only dispatches. The renderers are only run from the title screen: they
+// draw on a cleared panel, and the title screen is drawn again afterwards.
+void bot_bench(Application* app_p, HAL* hal_p, FrameMessage* message_p){
+    static const char moves[MAX_PLAYERS - 1] = {'r', 'p', 's', 'r'};
+    uint8_t reply[FRAME_MAX_PAYLOAD];
+    uint8_t* out_p = reply;
+    BenchResult result;
+    const BenchCase* case_p;
+    bool renders;
+    int i, length;
+
+    if (message_p->length != 2 ||
+        message_p->payload[0] >= NUM_BENCH_CASES ||
+        message_p->payload[1] == 0 ||
+        message_p->payload[1] > BENCH_MAX_REPETITIONS){
+        bot_nack(hal_p, message_p->seq, NACK_FORMAT);
+        return;
+    }
+    case_p = &bench_cases[message_p->payload[0]];
+    renders = message_p->payload[0] >= FIRST_RENDER_CASE;
+
+    if (renders && (app_p->screen_state != title || !HAL_canDraw(hal_p))){
+        bot_nack(hal_p, message_p->seq, NACK_STATE);
+        return;
+    }
+
+    // Every seat plays, and all three moves are on the table
+    bench_context.app = *app_p;
+    bench_context.app.screen_state = title;
+    bench_context.app.title_drawn = true;
+    bench_context.app.players = MAX_PLAYERS - 1;
+    for (i = 0; i < MAX_PLAYERS - 1; i++){
+        bench_context.app.choices[i][0] = moves[i];
+        bench_context.app.choices[i][1] = '\0';
+    }
+
+    // A tap of this loop is left to the running game
+    bench_context.hal = *hal_p;
+    bench_context.hal.boardLink = false;
+    bench_context.hal.displayBoot = DISPLAY_ON;
+    bench_context.hal.launchpadS2.isTapped = false;
+    bench_context.hal.boosterpackS1.isTapped = false;
+
+    // Count at the speed the board plays at
+    if (CLOCK_GOVERNOR){
+        HAL_setClockSpeed(hal_p, CLOCK_FAST);
+        SWTimer_start(&app_p->idleTimer);
+    }
+
+    if (renders)
+        clear_screen(hal_p);
+
+    Bench_enable();
+    Bench_run(case_p->function, NULL, message_p->payload[1], &result);
+
+    // Put the title screen back as title_screen_state() leaves it, panel
+    // power modes included
+    if (renders){
+        clear_screen(hal_p);
+        print_title(app_p, hal_p);
+    }
+
+    *out_p++ = message_p->payload[0];
+    *out_p++ = NUM_BENCH_CASES;
+    *out_p++ = (uint8_t)result.repetitions;
+    out_p = put_uint32(out_p, Clock_hz());
+    out_p = put_uint32(out_p, result.min);
+    out_p = put_uint32(out_p, result.median);
+    out_p = put_uint32(out_p, result.p99);
+    out_p = put_uint32(out_p, result.max);
+
+    length = strlen(case_p->name);
+    memcpy(out_p, case_p->name, length);
+
+    Frame_send(&hal_p->uart, MSG_BENCH_RESULT, message_p->seq, reply,
+               BENCH_RESULT_HEADER + length);
+}
+
+// Function to control the trace and send its records on request of a machine
+void bot_trace(HAL* hal_p, FrameMessage* message_p){
+    static uint8_t reply[FRAME_MAX_PAYLOAD];
+    const TraceRecord* records = Trace_records();
+    uint8_t command = message_p->payload[0];
+    bool running = Trace_isRunning();
+    uint32_t written = Trace_written();
+    uint32_t first, count, i;
+    int frames;
+
+    if (message_p->length != 1 || command > TRACE_DUMP){
+        bot_nack(hal_p, message_p->seq, NACK_FORMAT);
+        return;
+    }
+
+    if (command != TRACE_DUMP){
+        if (command == TRACE_START)
+            Trace_start();
+        else
+            Trace_stop();
+        Frame_send(&hal_p->uart, MSG_TRACE_RESULT, message_p->seq, &command, 1);
+        return;
+    }
+
+    // The oldest record kept is the one the next record would overwrite
+    Trace_stop();
+    count = written < TRACE_RECORDS ? written : TRACE_RECORDS;
+    first = written - count;
+    frames = (count + TRACE_DUMP_RECORDS - 1) / TRACE_DUMP_RECORDS;
+
+    reply[0] = TRACE_DUMP;
+    reply[1] = frames;
+    put_uint32(put_uint32(&reply[TRACE_DUMP_HEADER], written), SYSTEM_CLOCK);
+    Frame_send(&hal_p->uart, MSG_TRACE_RESULT, message_p->seq, reply,
+               TRACE_DUMP_HEADER + 8);
+
+    uint8_t* out_p = &reply[TRACE_DUMP_HEADER];
+    for (i = 0; i < count; i++){
+        const TraceRecord* record_p = &records[(first + i) & (TRACE_RECORDS - 1)];
+        out_p = put_uint32(out_p, record_p->time);
+        *out_p++ = record_p->point;
+        *out_p++ = record_p->phase;
+        *out_p++ = record_p->arg & 0xFF;
+        *out_p++ = record_p->arg >> 8;
+
+        // Send a full frame, or the last one
+        if (out_p == &reply[TRACE_DUMP_HEADER + TRACE_DUMP_RECORDS * TRACE_RECORD_BYTES] ||
+            i == count - 1){
+            reply[1] = --frames;
+            Frame_send(&hal_p->uart, MSG_TRACE_RESULT, message_p->seq, reply,
+                       out_p - reply);
+            out_p = &reply[TRACE_DUMP_HEADER];
+        }
+    }
+
+    if (running)
+        Trace_start();
+}
+
+// Function to send a snapshot of the metrics on request of a machine, such as
+// a monitoring station polling many boards
+void bot_metrics(HAL* hal_p, FrameMessage* message_p){
+    uint32_t values[NUM_METRICS + NUM_GAUGES];
+    uint8_t reply[METRICS_RESULT_LENGTH];
+    uint8_t* out_p = reply;
+    int i;
+
+    if (message_p->length != 0){
+        bot_nack(hal_p, message_p->seq, NACK_FORMAT);
+        return;
+    }
+
+    Metrics_snapshot(values);
+
+    *out_p++ = NUM_METRICS;
+    *out_p++ = NUM_GAUGES;
+    for (i = 0; i < NUM_METRICS + NUM_GAUGES; i++)
+        out_p = put_uint32(out_p, values[i]);
+
+    Frame_send(&hal_p->uart, MSG_METRICS_RESULT, message_p->seq, reply,
+               METRICS_RESULT_LENGTH);
+}
@@ -0,0 +1,154 @@
+#!/usr/bin/env python3
+"""Runs the benchmark cases of bot_bench() on the board and writes the
+cycle counts as JSON.
+
+    python3 tools/bench.py --port /dev/ttyACM0
+    python3 tools/bench.py --port /dev/ttyACM0 --repetitions 32 --runs 5 -o bench.json
+
+Each case is run --runs times with --repetitions timed calls each, after a
+warm-up on the board (BENCH_WARMUP in HAL/Bench.h). A case reports the
+smallest min, and the median of the medians, p99s and maxes of its runs,
+in CPU cycles and in microseconds at the clock the board counted at.
+
+The cases run on copies of the game, so the board can be benchmarked
+between two games without disturbing it. The renderers draw on a cleared
+screen and are only run while the board shows the title screen, which is
+drawn again after each of them; elsewhere they are reported as skipped.
+
+A board which does not answer at first may not have detected the baud rate
+yet, and is sent bursts of "UUUU" until it does.
+"""
+
+import argparse
+import json
+import statistics
+import struct
+import sys
+import time
+
+import frames
+
+MSG_BENCH = 0x09
+MSG_BENCH_RESULT = 0x89
+
+BENCH_MAX_REPETITIONS = 64
+RESULT_HEADER = "<BBB5I"
+
+NACK_STATE = 0x03
+
+REPLY_TIMEOUT_S = 10.0
+SYNC_TIME_S = 5.0
+SYNC_REPLY_S = 0.3
+
+
+def sync(port):
+    """Waits until the board answers a single repetition of the first case.
+    Until it does, bursts of "UUUU" let it detect the baud rate; a board which
+    answers at once never sees them as input."""
+    deadline = time.monotonic() + SYNC_TIME_S
+    while time.monotonic() < deadline:
+        port.send(MSG_BENCH, 0, bytes([0, 1]))
+        if port.receive(SYNC_REPLY_S) is not None:
+            return
+        port.send_text(b"UUUU")
+        time.sleep(0.05)
+    sys.exit("the board does not answer")
+
+
+def run_case(port, seq, case, repetitions):
+    """Returns the result of one run, or None if the board is not on the
+    screen the case needs."""
+    port.send(MSG_BENCH, seq, bytes([case, repetitions]))
+    # Late answers to the sync are skipped
+    while True:
+        reply = port.receive(REPLY_TIMEOUT_S)
+        if reply is None:
+            sys.exit("no reply from the board")
+        msg_type, reply_seq, payload = reply
+        if reply_seq == seq:
+            break
+    if msg_type == frames.MSG_NACK and payload[:1] == bytes([NACK_STATE]):
+        return None
+    if msg_type != MSG_BENCH_RESULT:
+        sys.exit(f"case {case} was rejected (reply type {msg_type:#x})")
+
+    header = struct.calcsize(RESULT_HEADER)
+    _, cases, runs, clock_hz, low, median, p99, high = \
+        struct.unpack(RESULT_HEADER, payload[:header])
+    return {
+        "name": payload[header:].decode("ascii"),
+        "cases": cases,
+        "repetitions": runs,
+        "clock_hz": clock_hz,
+        "cycles": {"min": low, "median": median, "p99": p99, "max": high},
+    }
+
+
+def summarize(results):
+    first = results[0]
+    cycles = {
+        "min": min(r["cycles"]["min"] for r in results),
+        "median": statistics.median(r["cycles"]["median"] for r in results),
+        "p99": statistics.median(r["cycles"]["p99"] for r in results),
+        "max": statistics.median(r["cycles"]["max"] for r in results),
+    }
+    return {
+        "name": first["name"],
+        "runs": len(results),
+        "repetitions": first["repetitions"],
+        "clock_hz": first["clock_hz"],
+        "cycles": cycles,
+        "us": {k: round(1e6 * v / first["clock_hz"], 3) for k, v in cycles.items()},
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--port", required=True, help="serial port of the board's USB UART")
+    parser.add_argument("--baud", type=int, default=9600, choices=sorted(frames.BAUDS))
+    parser.add_argument("--repetitions", type=int, default=BENCH_MAX_REPETITIONS,
+                        choices=range(1, BENCH_MAX_REPETITIONS + 1), metavar="N")
+    parser.add_argument("--runs", type=int, default=3)
+    parser.add_argument("-o", "--output", help="file to write the JSON to")
+    args = parser.parse_args()
+
+    port = frames.Port(args.port, args.baud)
+    seq = 0
+    summaries = []
+    skipped = []
+    try:
+        sync(port)
+        case = 0
+        cases = 1
+        while case < cases:
+            results = []
+            for _ in range(args.runs):
+                # Seq 0 is left to the sync
+                seq = seq % 0xFF + 1
+                result = run_case(port, seq, case, args.repetitions)
+                if result is None:
+                    break
+                results.append(result)
+            if results:
+                cases = results[0]["cases"]
+                summaries.append(summarize(results))
+            else:
+                skipped.append(case)
+            case += 1
+    finally:
+        port.close()
+
+    if skipped:
+        print(f"cases {skipped} skipped: the board is not on the title screen",
+              file=sys.stderr)
+    text = json.dumps({"target": "msp432p401r", "cases": summaries,
+                       "skipped": skipped}, indent=2)
+    if args.output:
+        with open(args.output, "w") as out:
+            out.write(text + "\n")
+    else:
+        print(text)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,74 @@
+#!/usr/bin/env python3
+"""Encodes ASCII-art sprites into the run-length encoded RGB565 format of
+HAL/Sprite.h.
+
+Each sprite file starts with palette lines of the form "<char> <RRGGBB>",
+followed by a blank line and one line of characters per pixel row. Every
+sprite given on the command line becomes a const Sprite named after its file,
+and the C source is written to stdout:
+
+    python3 tools/encode_sprite.py tools/sprites/*.txt > HAL/Icons.c
+"""
+
+import os
+import sys
+
+
+def rgb565(rgb):
+    """Translates a 24-bit RGB colour like the LCD driver does."""
+    return ((rgb & 0xF80000) >> 8) | ((rgb & 0x00FC00) >> 5) | ((rgb & 0x0000F8) >> 3)
+
+
+def read_sprite(path):
+    with open(path) as sprite_file:
+        palette_text, art_text = sprite_file.read().split("\n\n", 1)
+
+    palette = {}
+    for line in palette_text.splitlines():
+        char, colour = line.split()
+        palette[char] = rgb565(int(colour, 16))
+
+    rows = [row for row in art_text.splitlines() if row]
+    if len({len(row) for row in rows}) != 1:
+        sys.exit(f"{path}: rows differ in length")
+    return len(rows[0]), rows, palette
+
+
+def encode(rows, palette):
+    """Returns the (length, colour) runs of the pixels in row order."""
+    runs = []
+    for char in "".join(rows):
+        colour = palette[char]
+        if runs and runs[-1][1] == colour and runs[-1][0] < 0xFFFF:
+            runs[-1][0] += 1
+        else:
+            runs.append([1, colour])
+    return runs
+
+
+def main(paths):
+    print("/*")
+    print(" * Icons.c")
+    print(" *")
+    print(" * Generated by tools/encode_sprite.py from tools/sprites/. Do not edit.")
+    print(" */")
+    print()
+    print("#include <HAL/Icons.h>")
+    for path in paths:
+        name = os.path.splitext(os.path.basename(path))[0]
+        width, rows, palette = read_sprite(path)
+        runs = encode(rows, palette)
+        print()
+        print(f"static const SpriteRun {name}Runs[] = {{")
+        for i in range(0, len(runs), 4):
+            chunk = runs[i:i + 4]
+            print("    " + " ".join(f"{{{n}, 0x{c:04X}}}," for n, c in chunk))
+        print("};")
+        print()
+        opening = f"const Sprite {name}Icon = {{"
+        print(f"{opening}{width}, {len(rows)}, {name}Runs,")
+        print(" " * len(opening) + f"sizeof({name}Runs) / sizeof({name}Runs[0])}};")
+
+
+if __name__ == "__main__":
+    main(sys.argv[1:])
@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+"""Steps the host simulator through every screen of a game and reports how
+long each one takes to reach the LCD.
+
+    make -C host
+    make -C host BUILD=build-fb DEFINES="-DLCD_FRAMEBUFFER=1"
+    python3 tools/frame_times.py --sim host/build/sim
+    python3 tools/frame_times.py --sim host/build-fb/sim
+
+Each screen is reached with a tap, as a player would. For each one the tool
+prints the time from the press of the button to the last pixel the panel
+received, and how long the panel was being written: with the screen drawn
+straight to the LCD, that is the time the old screen is seen being wiped and
+the new one built up; with LCD_FRAMEBUFFER, it is the flush alone. The times
+come from the simulator's lcd_update counters, so they are virtual time at
+the SPI clock and at the simulator's cost per hardware call. Both include
+the debouncing of the button, which is the same in every build.
+"""
+
+import argparse
+import random
+
+import loadgen
+import round_bytes
+
+# Virtual time a screen gets to be drawn after its tap
+SETTLE_MS = 500
+
+# Virtual time without drawing before a tap, longer than the gap which ends an
+# update of the panel in host/Panel.c, so the screen starts an update of its own
+QUIET_MS = 50
+
+
+def measure(sim, name, buttons):
+    """Taps the buttons, lets the firmware draw, and prints the frame time of
+    the screen that was drawn."""
+    sim.command("wait %d" % QUIET_MS)
+    before = sim.stats()
+    for button in buttons:
+        sim.tap(button)
+    sim.command("wait %d" % SETTLE_MS)
+    after = sim.stats()
+
+    updates = int(after["lcd_updates"] - before["lcd_updates"])
+    if updates == 0:
+        print(f"{name:<16}{'-':>12}{'-':>10}{0:>9}")
+        return
+    latency = after["lcd_update_end_ms"] - before["time_ms"]
+    drawing = after["lcd_update_end_ms"] - after["lcd_update_start_ms"]
+    print(f"{name:<16}{latency:>12.3f}{drawing:>10.3f}{updates:>9}")
+
+
+def play(sim, args, rng):
+    round_bytes.sync(sim)
+    sim.settle()
+
+    print(f"{'screen':<16}{'tap to end':>12}{'drawing':>10}{'updates':>9}")
+    measure(sim, "instructions", ["LS2"])
+    measure(sim, "title", ["LS2"])
+    measure(sim, "settings", ["BB1"])
+    for _ in range(loadgen.increments(loadgen.DEF_ROUNDS, args.rounds,
+                                      loadgen.MIN_ROUNDS, loadgen.MAX_ROUNDS)):
+        sim.tap("JS")
+    measure(sim, "settings field", ["LS2"])
+    for _ in range(loadgen.increments(loadgen.DEF_PLAYERS, args.players,
+                                      loadgen.MIN_PLAYERS, loadgen.MAX_PLAYERS)):
+        sim.tap("JS")
+    measure(sim, "name selection", ["BB1"])
+
+    names = [b"%c%02d" % (ord("A") + i, i) for i in range(args.players)]
+    for i, name in enumerate(names):
+        sim.board.port.send_text(name)
+        if sim.board.expect([name], args.timeout) is None:
+            raise loadgen.GameError("name %s was not echoed" % name.decode())
+        if i + 1 < len(names):
+            sim.tap("BB1")
+            sim.settle()
+    measure(sim, "game", ["BB1"])
+
+    prompts = [name + loadgen.PROMPT_TEXT for name in names]
+    if sim.board.expect([prompts[0]], args.timeout) is None:
+        raise loadgen.GameError("the first player was not prompted")
+    for round_number in range(args.rounds):
+        for seat in range(args.players):
+            answer = (prompts[seat + 1] if seat + 1 < args.players
+                      else loadgen.PLAY_TEXT)
+            sim.board.port.send_text(bytes([rng.choice(b"rps")]))
+            if sim.board.expect([answer], args.timeout) is None:
+                raise loadgen.GameError("a move was not accepted")
+        last = round_number + 1 == args.rounds
+        measure(sim, "end" if last else "round %d" % (round_number + 1),
+                ["BB1"])
+        if sim.board.expect([loadgen.END_TEXT if last else prompts[0]],
+                            args.timeout) is None:
+            raise loadgen.GameError("the next round did not start")
+    measure(sim, "game over", ["BB1"])
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--sim", default="host/build/sim", help="simulator binary")
+    parser.add_argument("--speed", type=float, default=1.0,
+                        help="virtual time against the wall clock")
+    parser.add_argument("--players", type=int, default=loadgen.DEF_PLAYERS,
+                        choices=range(loadgen.MIN_PLAYERS, loadgen.MAX_PLAYERS))
+    parser.add_argument("--rounds", type=int, default=3,
+                        choices=range(loadgen.MIN_ROUNDS, loadgen.MAX_ROUNDS))
+    parser.add_argument("--timeout", type=float, default=2.0,
+                        help="seconds to wait for an answer")
+    parser.add_argument("--seed", type=int, default=1)
+    args = parser.parse_args()
+
+    sim = round_bytes.Simulator(args.sim, args.speed)
+    try:
+        play(sim, args, random.Random(args.seed))
+    finally:
+        sim.close()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,185 @@
+"""Host side of the binary frame protocol of HAL/Frame.h, shared by the tools
+which talk to the board.
+
+A frame on the wire is a zero byte, the COBS encoding of
+
+    type | seq | payload... | CRC-32 (zlib, little endian)
+
+and a closing zero byte. Only the standard library is used; the serial port
+is opened with termios, so the tools run on Linux and macOS.
+"""
+
+import os
+import select
+import termios
+import zlib
+
+DELIMITER = 0x00
+MAX_PAYLOAD = 240
+
+# Message types of Application.h
+MSG_MOVES = 0x01
+MSG_MATCH = 0x02
+MSG_PROFILE = 0x03
+MSG_POWER = 0x04
+MSG_RESULT = 0x81
+MSG_MATCH_RESULT = 0x82
+MSG_PROFILE_RESULT = 0x83
+MSG_POWER_RESULT = 0x84
+MSG_NACK = 0xFF
+
+
+def cobs_encode(data):
+    out = bytearray([0])
+    code_index = 0
+    code = 1
+    for byte in data:
+        if byte == 0:
+            out[code_index] = code
+            code_index = len(out)
+            out.append(0)
+            code = 1
+        else:
+            out.append(byte)
+            code += 1
+            if code == 0xFF:
+                out[code_index] = code
+                code_index = len(out)
+                out.append(0)
+                code = 1
+    out[code_index] = code
+    return bytes(out)
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data) + 1:
+            raise ValueError("bad COBS encoding")
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def encode_frame(msg_type, seq, payload=b""):
+    raw = bytes([msg_type, seq]) + bytes(payload)
+    raw += zlib.crc32(raw).to_bytes(4, "little")
+    return bytes([DELIMITER]) + cobs_encode(raw) + bytes([DELIMITER])
+
+
+def decode_frame(encoded):
+    """Returns (type, seq, payload) of an encoded frame without its
+    delimiters, or raises ValueError."""
+    raw = cobs_decode(encoded)
+    if len(raw) < 6 or zlib.crc32(raw[:-4]).to_bytes(4, "little") != raw[-4:]:
+        raise ValueError("bad CRC")
+    return raw[0], raw[1], raw[2:-4]
+
+
+BAUDS = {
+    9600: termios.B9600,
+    19200: termios.B19200,
+    38400: termios.B38400,
+    57600: termios.B57600,
+    115200: termios.B115200,
+}
+
+# Faster rates of UART_Baudrate, where the host supports them
+for _rate in (230400, 460800, 921600, 1500000):
+    if hasattr(termios, "B%d" % _rate):
+        BAUDS[_rate] = getattr(termios, "B%d" % _rate)
+
+
+class Port:
+    """A raw serial port exchanging frames with the board."""
+
+    def __init__(self, path, baud):
+        self.fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+        attrs = termios.tcgetattr(self.fd)
+        attrs[0] = 0                                                # iflag
+        attrs[1] = 0                                                # oflag
+        attrs[2] = termios.CS8 | termios.CREAD | termios.CLOCAL     # cflag
+        attrs[3] = 0                                                # lflag
+        attrs[4] = attrs[5] = BAUDS[baud]
+        attrs[6][termios.VMIN] = 0
+        attrs[6][termios.VTIME] = 0
+        termios.tcsetattr(self.fd, termios.TCSANOW, attrs)
+        termios.tcflush(self.fd, termios.TCIOFLUSH)
+        self.pending = bytearray()
+        self.in_frame = False
+
+    def close(self):
+        os.close(self.fd)
+
+    def send(self, msg_type, seq, payload=b""):
+        # The extra delimiter is lost if it wakes a sleeping board
+        os.write(self.fd, bytes([DELIMITER]) + encode_frame(msg_type, seq, payload))
+
+    def send_text(self, text):
+        os.write(self.fd, bytes(text))
+
+    def receive(self, timeout):
+        """Returns the next valid frame as (type, seq, payload), or None if
+        none arrives within timeout seconds. Text and corrupt frames between
+        the frames are skipped."""
+        while True:
+            # Drop text in front of the next delimiter
+            start = self.pending.find(DELIMITER)
+            del self.pending[:start if start >= 0 else len(self.pending)]
+
+            end = self.pending.find(DELIMITER, 1)
+            if end == 1:
+                del self.pending[:1]
+                continue
+            if end > 1:
+                encoded = bytes(self.pending[1:end])
+                # The closing delimiter may open the next frame
+                del self.pending[:end]
+                try:
+                    return decode_frame(encoded)
+                except ValueError:
+                    continue
+
+            ready, _, _ = select.select([self.fd], [], [], timeout)
+            if not ready:
+                return None
+            self.pending += os.read(self.fd, 4096)
+
+    def read(self, timeout):
+        """Returns what arrives within timeout seconds, in order, as a list
+        of text (bytes) and valid frames (type, seq, payload). Corrupt frames
+        are skipped. Use either read() or receive() on a port, not both."""
+        ready, _, _ = select.select([self.fd], [], [], timeout)
+        if not ready:
+            return []
+
+        items = []
+        text = bytearray()
+        for byte in os.read(self.fd, 4096):
+            if not self.in_frame:
+                if byte == DELIMITER:
+                    self.in_frame = True
+                else:
+                    text.append(byte)
+                continue
+
+            if byte != DELIMITER:
+                self.pending.append(byte)
+            # Two delimiters in a row are the same as one
+            elif self.pending:
+                if text:
+                    items.append(bytes(text))
+                    text = bytearray()
+                try:
+                    items.append(decode_frame(bytes(self.pending)))
+                except ValueError:
+                    pass
+                self.pending = bytearray()
+                self.in_frame = False
+        if text:
+            items.append(bytes(text))
+        return items
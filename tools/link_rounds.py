@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+"""Plays one game on two linked host simulators and reports the time the
+board link takes per round, and its round trips.
+
+    make -C host BUILD=build-link0 DEFINES="-DBOARD_LINK=1 -DBOARD_LINK_ID=0"
+    make -C host BUILD=build-link1 DEFINES="-DBOARD_LINK=1 -DBOARD_LINK_ID=1"
+    python3 tools/link_rounds.py --players 4 --rounds 5
+
+The first simulator gets eUSCI_A3 on a pseudo-terminal and the second one
+attaches to it, so the boards talk over the modelled UARTs at
+BOARD_LINK_BAUD. Both boards are set up alike, and each seat's move is typed
+on the USB UART of the board which hosts it. For every round the tool prints
+the wall-clock time from the last move to both boards announcing the result,
+which includes the USB UART and the host; the simulators run at --speed 1,
+so it follows virtual time.
+
+At the end the link counters of HAL/Metrics.h are polled from both boards:
+the messages the other board acknowledged, their mean round-trip time on the
+firmware's timer, and the retransmissions. The link is stop-and-wait, so one
+message per round trip is the most it can carry.
+"""
+
+import argparse
+import os
+import random
+import struct
+import tempfile
+import time
+
+import loadgen
+import metrics
+import round_bytes
+
+# eUSCI_A module of the board link, LINK_UART_INSTANCE in HAL/Link.h
+LINK_MODULE = 3
+
+# MSG_LINK_MOVES of Application.h, for the payload size
+LINK_MOVES_HEADER = 3
+
+
+def setup(sim, args, names):
+    """Takes a board from the title screen to the first round."""
+    round_bytes.sync(sim)
+    sim.tap("BB1")
+    for _ in range(loadgen.increments(loadgen.DEF_ROUNDS, args.rounds,
+                                      loadgen.MIN_ROUNDS, loadgen.MAX_ROUNDS)):
+        sim.tap("JS")
+    sim.tap("LS2")
+    for _ in range(loadgen.increments(loadgen.DEF_PLAYERS, args.players,
+                                      loadgen.MIN_PLAYERS, loadgen.MAX_PLAYERS)):
+        sim.tap("JS")
+    sim.tap("BB1")
+    sim.settle()
+
+    for name in names:
+        sim.board.port.send_text(name)
+        if sim.board.expect([name], args.timeout) is None:
+            raise loadgen.GameError("name %s was not echoed" % name.decode())
+        sim.tap("BB1")
+        sim.settle()
+
+
+def poll(sim):
+    """Returns the counters of a board by name."""
+    reply = sim.board.request(metrics.MSG_METRICS, b"", metrics.MSG_METRICS_RESULT)
+    if reply is None:
+        raise loadgen.GameError("no reply to a metrics poll")
+    counters = reply[0]
+    values = struct.unpack_from("<%dI" % counters, reply, 2)
+    return {metrics.name(metrics.COUNTERS, i, "counter"): values[i]
+            for i in range(counters)}
+
+
+def play(sims, args, rng):
+    names = [b"%c%02d" % (ord("A") + i, i) for i in range(args.players)]
+    for sim in sims:
+        setup(sim, args, names)
+
+    # Board 0 hosts the even seats, board 1 the odd ones
+    prompts = [name + loadgen.PROMPT_TEXT for name in names]
+    print(f"{'round':>5}{'resolve ms':>12}")
+    for round_number in range(args.rounds):
+        for board, sim in enumerate(sims):
+            for seat in range(board, args.players, 2):
+                if sim.board.expect([prompts[seat]], args.timeout) is None:
+                    raise loadgen.GameError("seat %d was not prompted" % seat)
+                sim.board.port.send_text(bytes([rng.choice(b"rps")]))
+        moved = time.monotonic()
+
+        for sim in sims:
+            if sim.board.expect([loadgen.PLAY_TEXT], args.timeout) is None:
+                raise loadgen.GameError("the round was not resolved")
+        resolved = time.monotonic()
+        print(f"{round_number + 1:>5}{(resolved - moved) * 1000:>12.1f}")
+
+        for sim in sims:
+            sim.tap("BB1")
+    for sim in sims:
+        if sim.board.expect([loadgen.END_TEXT], args.timeout) is None:
+            raise loadgen.GameError("the game did not end")
+
+    message = LINK_MOVES_HEADER + args.players
+    print()
+    print(f"{'board':>5}{'acked':>7}{'rtt us':>9}{'resent':>8}"
+          f"{'link bytes':>12}{'msgs/s':>9}{'payload B/s':>13}")
+    for board, sim in enumerate(sims):
+        counters = poll(sim)
+        acks = counters["link_acks"]
+        rtt = counters["link_round_trip_us"] / acks if acks else 0
+        rate = 1e6 / rtt if rtt else 0
+        link_bytes = int(sim.stats()["uart%d_tx" % LINK_MODULE])
+        print(f"{board:>5}{acks:>7}{rtt:>9.0f}{counters['link_retransmissions']:>8}"
+              f"{link_bytes:>12}{rate:>9.0f}{rate * message:>13.0f}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--sim", nargs=2, default=["host/build-link0/sim",
+                                                   "host/build-link1/sim"],
+                        help="simulator binaries of board 0 and board 1")
+    parser.add_argument("--players", type=int, default=loadgen.DEF_PLAYERS,
+                        choices=range(loadgen.MIN_PLAYERS, loadgen.MAX_PLAYERS))
+    parser.add_argument("--rounds", type=int, default=loadgen.DEF_ROUNDS,
+                        choices=range(loadgen.MIN_ROUNDS, loadgen.MAX_ROUNDS))
+    parser.add_argument("--timeout", type=float, default=2.0,
+                        help="seconds to wait for an answer")
+    parser.add_argument("--seed", type=int, default=1)
+    args = parser.parse_args()
+
+    link_dir = tempfile.TemporaryDirectory()
+    link = os.path.join(link_dir.name, "link")
+    sims = [round_bytes.Simulator(args.sim[0], 1.0,
+                                  ["--uart%d" % LINK_MODULE, link])]
+    try:
+        sims.append(round_bytes.Simulator(args.sim[1], 1.0,
+                                          ["--attach%d" % LINK_MODULE, link]))
+        play(sims, args, random.Random(args.seed))
+    finally:
+        for sim in sims:
+            sim.close()
+        link_dir.cleanup()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,312 @@
+#!/usr/bin/env python3
+"""Plays whole games against the board through its ASCII prompts and
+reports how many rounds per second it sustains at each baud rate.
+
+    python3 tools/loadgen.py --port /dev/ttyACM0 --baud 9600 115200 --games 10
+    python3 tools/loadgen.py --port /dev/ttyACM0 --port /dev/ttyACM1 \\
+        --concurrency 2 --players 4 --rounds 5 --think 0.2
+
+Every game starts with a restart of the board (MSG_RESET) and a baud rate
+detection from a few 'U' characters. The tool then taps the buttons with
+MSG_TAP frames, types each player's name, and answers every prompt of
+uart_name() with a random move after the think-time. A round ends with the
+"Press BB1 to play the round" notice of print_BB1(), which is answered with
+another tap.
+
+A move is accepted when the board answers it with the next prompt or the
+notice. A move which is answered by the invalid input text, or not at all
+within the timeout, is counted as lost and sent again. The latency of a move
+is the time from sending it to its answer, so the think-time is not part of
+it. Each board plays one game at a time; --concurrency boards, one per
+--port, play at once.
+"""
+
+import argparse
+import random
+import threading
+import time
+
+import frames
+
+# Message types and buttons of Application.h
+MSG_TAP = 0x07
+MSG_RESET = 0x08
+MSG_TAP_RESULT = 0x87
+MSG_RESET_RESULT = 0x88
+
+TAP_LAUNCHPAD_S1 = 0
+TAP_LAUNCHPAD_S2 = 1
+TAP_BOOSTERPACK_S1 = 2
+TAP_BOOSTERPACK_JS = 4
+
+# Screens of HAL.h
+SCREEN_TITLE = 0
+
+# Settings of Application.h
+MIN_PLAYERS, MAX_PLAYERS, DEF_PLAYERS = 2, 5, 2
+MIN_ROUNDS, MAX_ROUNDS, DEF_ROUNDS = 1, 7, 3
+NAME_LENGTH = 3
+
+# Text of proj1_main.c
+PROMPT_TEXT = b", please enter\r\nR or r for Rock\r\nP or p for Paper\r\nS or s for Scissors\r\n"
+PLAY_TEXT = b"Press BB1 to play the round"
+END_TEXT = b"Press BB1 to end the game"
+INVALID_TEXT = b"Enter an R/r/P/p/S/s to choose\r\n"
+
+REPLY_TIMEOUT_S = 1.0
+# Time for the board to come back up after a reset, and for the baud rate
+# detection to give up waiting for a character and start over
+BOOT_TIME_S = 0.5
+SYNC_TIME_S = 5.0
+
+
+class GameError(Exception):
+    pass
+
+
+def increments(start, target, minimum, maximum):
+    """Number of joystick taps which take a setting from start to target, as
+    PlayerIncrement() and RoundIncrement() count."""
+    taps = 0
+    while start != target:
+        start = minimum if start + 1 == maximum else (start + 1) % maximum
+        taps += 1
+    return taps
+
+
+class Board:
+    """One board behind one serial port, talking both frames and text."""
+
+    def __init__(self, path, baud, timeout):
+        self.port = frames.Port(path, baud)
+        self.timeout = timeout
+        self.text = bytearray()
+        self.replies = []
+        self.seq = 0
+
+    def close(self):
+        self.port.close()
+
+    def pump(self, deadline):
+        remaining = deadline - time.monotonic()
+        if remaining <= 0:
+            return False
+        for item in self.port.read(remaining):
+            if isinstance(item, bytes):
+                self.text += item
+            else:
+                self.replies.append(item)
+        return True
+
+    def request(self, msg_type, payload, reply_type, timeout=REPLY_TIMEOUT_S):
+        """Sends a frame and returns the payload of its reply, or None."""
+        self.seq = (self.seq + 1) & 0xFF
+        self.port.send(msg_type, self.seq, payload)
+        deadline = time.monotonic() + timeout
+        while True:
+            for reply in self.replies:
+                if reply[1] == self.seq:
+                    self.replies.remove(reply)
+                    return reply[2] if reply[0] == reply_type else None
+            if not self.pump(deadline):
+                return None
+
+    def tap(self, button):
+        reply = self.request(MSG_TAP, bytes([button]), MSG_TAP_RESULT)
+        if reply is None:
+            raise GameError("no reply to a tap")
+        return reply[1]
+
+    def expect(self, needles, timeout):
+        """Waits for the first of the given texts. Returns its index, or None
+        on a timeout. The text up to its end is consumed."""
+        deadline = time.monotonic() + timeout
+        while True:
+            found = [(self.text.find(n), i) for i, n in enumerate(needles)]
+            found = [(at, i) for at, i in found if at >= 0]
+            if found:
+                at, i = min(found)
+                del self.text[:at + len(needles[i])]
+                return i
+            if not self.pump(deadline):
+                return None
+
+    def sync(self):
+        """Lets the board detect the baud rate, and waits until it answers."""
+        deadline = time.monotonic() + SYNC_TIME_S
+        while time.monotonic() < deadline:
+            self.port.send_text(b"UUUU")
+            time.sleep(0.05)
+            if self.request(MSG_TAP, bytes([TAP_LAUNCHPAD_S1]), MSG_TAP_RESULT,
+                            0.3) is not None:
+                return
+        raise GameError("the board does not answer")
+
+    def restart(self):
+        self.sync()
+        self.request(MSG_RESET, b"", MSG_RESET_RESULT)
+        time.sleep(BOOT_TIME_S)
+        self.sync()
+        self.text.clear()
+        self.replies.clear()
+
+
+class Stats:
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.games = 0
+        self.failed = 0
+        self.rounds = 0
+        self.moves = 0
+        self.lost = 0
+        self.latencies = []
+
+    def add(self, other):
+        with self.lock:
+            self.games += other.games
+            self.failed += other.failed
+            self.rounds += other.rounds
+            self.moves += other.moves
+            self.lost += other.lost
+            self.latencies += other.latencies
+
+
+def play_game(board, args, number, rng, stats):
+    board.restart()
+
+    if board.tap(TAP_BOOSTERPACK_S1) != SCREEN_TITLE:
+        raise GameError("the board did not start on the title screen")
+
+    # The settings screen starts on the number of rounds
+    for _ in range(increments(DEF_ROUNDS, args.rounds, MIN_ROUNDS, MAX_ROUNDS)):
+        board.tap(TAP_BOOSTERPACK_JS)
+    board.tap(TAP_LAUNCHPAD_S2)
+    for _ in range(increments(DEF_PLAYERS, args.players, MIN_PLAYERS, MAX_PLAYERS)):
+        board.tap(TAP_BOOSTERPACK_JS)
+    board.tap(TAP_BOOSTERPACK_S1)
+
+    names = [b"%c%02d" % (ord("A") + i, number % 100) for i in range(args.players)]
+    for name in names:
+        board.port.send_text(name)
+        if board.expect([name], args.timeout) is None:
+            raise GameError("name %s was not echoed" % name.decode())
+        board.tap(TAP_BOOSTERPACK_S1)
+
+    prompts = [name + PROMPT_TEXT for name in names]
+    if board.expect([prompts[0]], args.timeout) is None:
+        raise GameError("the first player was not prompted")
+
+    for round_number in range(args.rounds):
+        for seat in range(args.players):
+            answer = prompts[seat + 1] if seat + 1 < args.players else PLAY_TEXT
+            move = rng.choice(b"rps")
+            time.sleep(args.think * rng.uniform(1 - args.jitter, 1 + args.jitter))
+
+            for _ in range(args.retries + 1):
+                sent = time.monotonic()
+                board.port.send_text(bytes([move]))
+                stats.moves += 1
+                if board.expect([answer, INVALID_TEXT], args.timeout) == 0:
+                    stats.latencies.append(time.monotonic() - sent)
+                    break
+                stats.lost += 1
+            else:
+                raise GameError("a move was never accepted")
+
+        stats.rounds += 1
+        board.tap(TAP_BOOSTERPACK_S1)
+        last = round_number + 1 == args.rounds
+        if board.expect([END_TEXT if last else prompts[0]], args.timeout) is None:
+            raise GameError("the next round did not start")
+
+    board.tap(TAP_BOOSTERPACK_S1)
+    stats.games += 1
+
+
+def run_board(path, baud, args, games, seed, total):
+    rng = random.Random(seed)
+    board = Board(path, baud, args.timeout)
+    try:
+        while True:
+            with games["lock"]:
+                if games["next"] >= args.games:
+                    return
+                number = games["next"]
+                games["next"] += 1
+
+            stats = Stats()
+            try:
+                play_game(board, args, number, rng, stats)
+            except GameError as error:
+                stats.failed += 1
+                print(f"{path}: game {number} failed: {error}")
+            total.add(stats)
+    finally:
+        board.close()
+
+
+def percentile(values, share):
+    if not values:
+        return 0.0
+    ordered = sorted(values)
+    return ordered[min(len(ordered) - 1, int(share * len(ordered)))]
+
+
+def run(args, baud):
+    total = Stats()
+    games = {"lock": threading.Lock(), "next": 0}
+    threads = [threading.Thread(target=run_board,
+                                args=(path, baud, args, games, args.seed + i, total))
+               for i, path in enumerate(args.port[:args.concurrency])]
+
+    start = time.monotonic()
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    elapsed = time.monotonic() - start
+
+    loss = 100 * total.lost / total.moves if total.moves else 0.0
+    print(f"{baud:>8}{total.games:>7}{total.failed:>7}{total.rounds:>8}"
+          f"{total.rounds / elapsed:>10.2f}{total.moves:>7}{loss:>7.2f}%"
+          f"{1000 * percentile(total.latencies, 0.5):>9.1f}"
+          f"{1000 * percentile(total.latencies, 0.99):>9.1f}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--port", action="append", required=True,
+                        help="serial port of a board's USB UART; repeat for more boards")
+    parser.add_argument("--baud", type=int, nargs="+", default=[9600],
+                        choices=sorted(frames.BAUDS))
+    parser.add_argument("--concurrency", type=int,
+                        help="boards playing at once (default: all ports)")
+    parser.add_argument("--games", type=int, default=10, help="games at each baud rate")
+    parser.add_argument("--players", type=int, default=DEF_PLAYERS,
+                        choices=range(MIN_PLAYERS, MAX_PLAYERS))
+    parser.add_argument("--rounds", type=int, default=DEF_ROUNDS,
+                        choices=range(MIN_ROUNDS, MAX_ROUNDS))
+    parser.add_argument("--think", type=float, default=0.0,
+                        help="seconds before each move")
+    parser.add_argument("--jitter", type=float, default=0.0,
+                        help="think-time varies by up to this share")
+    parser.add_argument("--timeout", type=float, default=2.0,
+                        help="seconds to wait for an answer")
+    parser.add_argument("--retries", type=int, default=3,
+                        help="times a lost move is sent again")
+    parser.add_argument("--seed", type=int, default=1)
+    args = parser.parse_args()
+
+    if args.concurrency is None:
+        args.concurrency = len(args.port)
+    if not 1 <= args.concurrency <= len(args.port):
+        parser.error("--concurrency needs as many --port options")
+
+    print(f"{'baud':>8}{'games':>7}{'failed':>7}{'rounds':>8}{'rounds/s':>10}"
+          f"{'moves':>7}{'lost':>8}{'p50 ms':>9}{'p99 ms':>9}")
+    for baud in args.baud:
+        run(args, baud)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+"""Polls the metrics registry of HAL/Metrics.h on one or more boards.
+
+    python3 tools/metrics.py --port /dev/ttyACM0
+    python3 tools/metrics.py --port /dev/ttyACM0 --port /dev/ttyACM1 --watch 5
+    python3 tools/metrics.py --port /dev/ttyACM0 --json
+
+A poll is one small frame each way, answered between two loops of the game,
+so boards can be polled while they are played. With --watch, the boards are
+polled every WATCH seconds and the counters are shown as increases since the
+previous poll; the gauges are always shown as they are. Metrics the board
+reports beyond the names below, from newer firmware, are shown by number.
+"""
+
+import argparse
+import json
+import struct
+import sys
+import time
+
+import frames
+
+MSG_METRICS = 0x0B
+MSG_METRICS_RESULT = 0x8B
+
+# In the order of Metric and Gauge in HAL/Metrics.h
+COUNTERS = ["rounds", "invalid_inputs", "rx_dropped", "redraws", "spi_bytes", "loops",
+            "link_acks", "link_round_trip_us", "link_retransmissions"]
+GAUGES = ["loop_rate", "free_stack"]
+
+REPLY_TIMEOUT_S = 2.0
+
+
+def name(names, index, kind):
+    return names[index] if index < len(names) else f"{kind}_{index}"
+
+
+def poll(port, seq):
+    """Returns the counters and gauges of a board as two dicts, or None if
+    it does not answer."""
+    port.send(MSG_METRICS, seq)
+    reply = port.receive(REPLY_TIMEOUT_S)
+    if reply is None or reply[0] != MSG_METRICS_RESULT:
+        return None
+    payload = reply[2]
+    counters, gauges = payload[0], payload[1]
+    values = struct.unpack_from("<%dI" % (counters + gauges), payload, 2)
+    return ({name(COUNTERS, i, "counter"): values[i] for i in range(counters)},
+            {name(GAUGES, i, "gauge"): values[counters + i] for i in range(gauges)})
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--port", action="append", required=True,
+                        help="serial port of a board's USB UART; repeat for more boards")
+    parser.add_argument("--baud", type=int, default=9600, choices=sorted(frames.BAUDS))
+    parser.add_argument("--watch", type=float, help="poll every WATCH seconds")
+    parser.add_argument("--json", action="store_true", help="print one JSON line per poll")
+    args = parser.parse_args()
+
+    ports = {path: frames.Port(path, args.baud) for path in args.port}
+    previous = {}
+    seq = 0
+    try:
+        while True:
+            seq = (seq + 1) & 0xFF
+            for path, port in ports.items():
+                result = poll(port, seq)
+                if result is None:
+                    print(f"{path}: no reply", file=sys.stderr)
+                    continue
+                counters, gauges = result
+                shown = counters
+                if args.watch and path in previous:
+                    shown = {k: v - previous[path].get(k, 0) for k, v in counters.items()}
+                previous[path] = counters
+
+                if args.json:
+                    print(json.dumps({"port": path, "time": time.time(),
+                                      "counters": shown, "gauges": gauges}))
+                else:
+                    fields = {**shown, **gauges}
+                    print(path + "  " + "  ".join(f"{k}={v}" for k, v in fields.items()))
+            if not args.watch:
+                break
+            time.sleep(args.watch)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        for port in ports.values():
+            port.close()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+"""Reads the time the board spent in each power mode and estimates the
+average current of the MCU.
+
+    python3 tools/power.py --port /dev/ttyACM0
+    python3 tools/power.py --port /dev/ttyACM0 --watch 10
+
+With --watch, the counters are read twice, the given number of seconds
+apart, and only the time in between is reported. The estimate multiplies the
+time in each mode by a typical current of the MSP432P401R at that mode, and
+compares it to running at full speed the whole time. It covers the MCU only,
+not the LCD backlight or the rest of the boards; adjust CURRENT_UA to measured
+figures for anything better than a rough comparison.
+"""
+
+import argparse
+import struct
+import sys
+import time
+
+import frames
+
+# In the order of PowerMode in HAL/Power.h
+MODES = ["active 48 MHz", "active 3 MHz", "LPM0 3 MHz", "LPM3"]
+
+# Typical supply currents from the MSP432P401R datasheet, in microamps
+CURRENT_UA = [4600, 650, 400, 1]
+
+REPLY_TIMEOUT_S = 5.0
+
+
+def query(port, seq):
+    port.send(frames.MSG_POWER, seq)
+    reply = port.receive(REPLY_TIMEOUT_S)
+    if reply is None:
+        sys.exit("no reply from the board")
+    msg_type, _, payload = reply
+    if msg_type != frames.MSG_POWER_RESULT:
+        sys.exit(f"unexpected reply type {msg_type:#x}")
+    values = struct.unpack("<%dI" % (len(MODES) + 1), payload)
+    return list(values[:-1]), values[-1]
+
+
+def report(times_ms, sleeps):
+    total = sum(times_ms)
+    if total == 0:
+        sys.exit("no time accounted yet")
+
+    print(f"{'mode':<16}{'time (s)':>12}{'share':>9}")
+    for name, ms in zip(MODES, times_ms):
+        print(f"{name:<16}{ms / 1000:>12.1f}{100 * ms / total:>8.1f}%")
+    print(f"{sleeps} sleeps")
+
+    average = sum(ms * ua for ms, ua in zip(times_ms, CURRENT_UA)) / total
+    print(f"estimated average current {average:.0f} uA, "
+          f"{100 * (1 - average / CURRENT_UA[0]):.0f}% below full speed")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--port", required=True, help="serial port of the board's USB UART")
+    parser.add_argument("--baud", type=int, default=9600, choices=sorted(frames.BAUDS))
+    parser.add_argument("--watch", type=float, help="only report the next WATCH seconds")
+    args = parser.parse_args()
+
+    port = frames.Port(args.port, args.baud)
+    try:
+        times_ms, sleeps = query(port, 1)
+        if args.watch:
+            time.sleep(args.watch)
+            later_ms, later_sleeps = query(port, 2)
+            times_ms = [b - a for a, b in zip(times_ms, later_ms)]
+            sleeps = later_sleeps - sleeps
+    finally:
+        port.close()
+
+    report(times_ms, sleeps)
+
+
+if __name__ == "__main__":
+    main()
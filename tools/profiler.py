@@ -0,0 +1,186 @@
+#!/usr/bin/env python3
+"""Controls the on-board sampling profiler of HAL/Profiler.h and turns its
+samples into a flat profile and folded stacks.
+
+    python3 tools/profiler.py --port /dev/ttyACM0 start
+    python3 tools/profiler.py --port /dev/ttyACM0 stop
+    python3 tools/profiler.py --port /dev/ttyACM0 dump samples.txt
+    python3 tools/profiler.py report samples.txt Debug/<project>.out \\
+        --folded samples.folded
+
+The profiler must be stopped before a dump. The report symbolises every
+sampled PC and LR against the symbol table of the linked ELF file, prints the
+flat profile and writes "caller;function count" lines which flamegraph.pl and
+speedscope read. The caller comes from the LR at the time of the sample, which
+is only the real caller while the sampled function has not reused LR, so the
+stacks are two frames deep at most.
+"""
+
+import argparse
+import bisect
+import struct
+import sys
+
+import frames
+
+PROFILE_STOP = 0x00
+PROFILE_START = 0x01
+PROFILE_DUMP = 0x02
+
+REPLY_TIMEOUT_S = 5.0
+
+
+def command(port, seq, code):
+    port.send(frames.MSG_PROFILE, seq, bytes([code]))
+    reply = port.receive(REPLY_TIMEOUT_S)
+    if reply is None:
+        sys.exit("no reply from the board")
+    msg_type, _, payload = reply
+    if msg_type == frames.MSG_NACK:
+        sys.exit(f"board rejected the command (reason {payload[0]})")
+    return payload
+
+
+def dump(port, path):
+    header = command(port, 1, PROFILE_DUMP)
+    frames_left = header[1]
+    samples, dropped = struct.unpack_from("<II", header, 2)
+
+    slots = []
+    while frames_left:
+        reply = port.receive(REPLY_TIMEOUT_S)
+        if reply is None:
+            sys.exit("dump cut short")
+        payload = reply[2]
+        frames_left = payload[1]
+        slots += struct.iter_unpack("<III", payload[2:])
+
+    with open(path, "w") as out:
+        out.write(f"# samples {samples} dropped {dropped}\n")
+        for pc, lr, count in slots:
+            out.write(f"{pc:08x} {lr:08x} {count}\n")
+    print(f"{len(slots)} places, {samples} samples, {dropped} dropped")
+
+
+def read_symbols(path):
+    """Returns the sorted (address, size, name) of the function symbols of an
+    ELF file."""
+    with open(path, "rb") as elf_file:
+        elf = elf_file.read()
+    if elf[:4] != b"\x7fELF" or elf[5] != 1:
+        sys.exit(f"{path}: not a little endian ELF file")
+    is64 = elf[4] == 2
+    if is64:
+        shoff, = struct.unpack_from("<Q", elf, 0x28)
+        shentsize, shnum = struct.unpack_from("<HH", elf, 0x3A)
+    else:
+        shoff, = struct.unpack_from("<I", elf, 0x20)
+        shentsize, shnum = struct.unpack_from("<HH", elf, 0x2E)
+
+    def section(index):
+        base = shoff + index * shentsize
+        if is64:
+            _, sh_type, _, _, offset, size, link, _, _, entsize = struct.unpack_from(
+                "<IIQQQQIIQQ", elf, base)
+        else:
+            _, sh_type, _, _, offset, size, link, _, _, entsize = struct.unpack_from(
+                "<IIIIIIIIII", elf, base)
+        return sh_type, offset, size, link, entsize
+
+    symbols = []
+    for index in range(shnum):
+        sh_type, offset, size, link, entsize = section(index)
+        if sh_type != 2:  # SHT_SYMTAB
+            continue
+        _, str_offset, _, _, _ = section(link)
+        for entry in range(offset, offset + size, entsize):
+            if is64:
+                name, info, _, _, value, sym_size = struct.unpack_from("<IBBHQQ", elf, entry)
+            else:
+                name, value, sym_size, info, _, _ = struct.unpack_from("<IIIBBH", elf, entry)
+            if info & 0xF != 2:  # STT_FUNC
+                continue
+            end = elf.index(b"\0", str_offset + name)
+            # Thumb function addresses have bit 0 set
+            symbols.append((value & ~1, sym_size, elf[str_offset + name:end].decode()))
+    symbols.sort()
+    return symbols
+
+
+def symbolise(symbols, starts, address):
+    index = bisect.bisect_right(starts, address & ~1) - 1
+    if index >= 0:
+        start, size, name = symbols[index]
+        if size == 0 or address < start + size:
+            return name
+    return f"0x{address:08x}"
+
+
+def report(dump_path, elf_path, folded_path):
+    symbols = read_symbols(elf_path)
+    starts = [symbol[0] for symbol in symbols]
+
+    flat = {}
+    folded = {}
+    total = 0
+    with open(dump_path) as dump_file:
+        for line in dump_file:
+            if line.startswith("#"):
+                print(line.strip("# \n"))
+                continue
+            pc, lr, count = line.split()
+            pc, lr, count = int(pc, 16), int(lr, 16), int(count)
+            function = symbolise(symbols, starts, pc)
+            # An LR of 0xFFFFFFxx is an exception return, not a caller
+            if lr >= 0xFFFFFF00:
+                stack = "[exception];" + function
+            else:
+                caller = symbolise(symbols, starts, lr)
+                stack = function if caller == function else caller + ";" + function
+            flat[function] = flat.get(function, 0) + count
+            folded[stack] = folded.get(stack, 0) + count
+            total += count
+
+    print(f"{'samples':>8} {'%':>6}  function")
+    for function, count in sorted(flat.items(), key=lambda item: -item[1]):
+        print(f"{count:8d} {100.0 * count / total:6.2f}  {function}")
+
+    if folded_path:
+        with open(folded_path, "w") as out:
+            for stack, count in sorted(folded.items()):
+                out.write(f"{stack} {count}\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--port", help="serial port of the board's USB UART")
+    parser.add_argument("--baud", type=int, default=9600, choices=sorted(frames.BAUDS))
+    commands = parser.add_subparsers(dest="command", required=True)
+    commands.add_parser("start", help="clear the counts and start sampling")
+    commands.add_parser("stop", help="stop sampling")
+    dump_parser = commands.add_parser("dump", help="save the samples of the stopped profiler")
+    dump_parser.add_argument("output")
+    report_parser = commands.add_parser("report", help="symbolise a saved dump")
+    report_parser.add_argument("dump")
+    report_parser.add_argument("elf")
+    report_parser.add_argument("--folded", help="write folded stacks to this file")
+    args = parser.parse_args()
+
+    if args.command == "report":
+        report(args.dump, args.elf, args.folded)
+        return
+    if not args.port:
+        parser.error("--port is needed to talk to the board")
+
+    port = frames.Port(args.port, args.baud)
+    try:
+        if args.command == "dump":
+            dump(port, args.output)
+        else:
+            command(port, 1, PROFILE_START if args.command == "start" else PROFILE_STOP)
+    finally:
+        port.close()
+
+
+if __name__ == "__main__":
+    main()
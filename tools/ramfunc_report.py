@@ -0,0 +1,79 @@
+#!/usr/bin/env python3
+"""Reports the functions placed in SRAM by the RAMFUNC attribute of
+HAL/RamFunc.h and checks their size against RAMFUNC_BUDGET.
+
+Reads the map file the TI linker writes next to the executable, lists every
+input section of the .TI.ramfunc output section with its size, and exits with
+status 1 if the total is over budget:
+
+    python3 tools/ramfunc_report.py Debug/<project>.map
+    python3 tools/ramfunc_report.py --budget 4096 Debug/<project>.map
+"""
+
+import argparse
+import os
+import re
+import sys
+
+RAMFUNC_HEADER = os.path.join(os.path.dirname(__file__), "..", "HAL", "RamFunc.h")
+
+# An input section line: load address, length, object file and section name
+INPUT_SECTION = re.compile(
+    r"^\s+([0-9a-fA-F]{8})\s+([0-9a-fA-F]{8})\s+(\S+)\s+\((\.TI\.ramfunc[^)]*)\)")
+
+
+def header_budget():
+    """Returns RAMFUNC_BUDGET as defined in HAL/RamFunc.h."""
+    with open(RAMFUNC_HEADER) as header:
+        match = re.search(r"#define\s+RAMFUNC_BUDGET\s+(\d+)", header.read())
+    if match is None:
+        sys.exit(f"{RAMFUNC_HEADER}: RAMFUNC_BUDGET not found")
+    return int(match.group(1))
+
+
+def ramfunc_sections(path):
+    """Returns the (object, section, length) of every .TI.ramfunc input
+    section in the section allocation map."""
+    sections = []
+    inside = False
+    with open(path) as map_file:
+        for line in map_file:
+            if line.startswith(".TI.ramfunc"):
+                inside = True
+                continue
+            if not inside:
+                continue
+            if not line.strip():
+                break
+            match = INPUT_SECTION.match(line)
+            if match:
+                sections.append((match.group(3), match.group(4), int(match.group(2), 16)))
+    return sections
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("map", help="map file written by the TI linker")
+    parser.add_argument("--budget", type=int, help="bytes of SRAM allowed (default: RAMFUNC_BUDGET)")
+    args = parser.parse_args()
+
+    budget = args.budget if args.budget is not None else header_budget()
+    sections = ramfunc_sections(args.map)
+    if not sections:
+        sys.exit(f"{args.map}: no .TI.ramfunc input sections found")
+
+    total = 0
+    for obj, section, length in sorted(sections, key=lambda s: -s[2]):
+        function = section.split(":", 1)[1] if ":" in section else section
+        print(f"{length:6d}  {obj:40s} {function}")
+        total += length
+
+    print(f"{total:6d}  total of {budget} bytes budgeted")
+    if total > budget:
+        print(f"over budget by {total - budget} bytes", file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
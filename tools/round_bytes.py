@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+"""Plays one game on the host simulator and reports the LCD's SPI bytes of
+every round.
+
+    make -C host
+    python3 tools/round_bytes.py --sim host/build/sim --players 4 --rounds 5
+
+The simulator is started with its USB UART on a pseudo-terminal. Buttons are
+pressed through the simulator's stdin, and names and moves are typed on the
+terminal, so the tool needs nothing of the firmware but its prompts and runs
+on any revision which builds in host/. The bytes come from the simulator's
+spi_bytes counter, which counts every byte sent to the panel.
+
+A round is split in two: the moves, from the first prompt to the "Press BB1
+to play the round" notice, and the resolution, from the tap on BB1 to the
+next round's first prompt or the end of the game notice. The resolution is
+where print_scores() redraws the scoreboard.
+"""
+
+import argparse
+import os
+import random
+import subprocess
+import tempfile
+import time
+
+import loadgen
+
+BAUD = 115200
+
+
+class Simulator:
+    """A running host simulator with its USB UART on a pseudo-terminal."""
+
+    def __init__(self, path, speed, options=()):
+        self.dir = tempfile.TemporaryDirectory()
+        tty = os.path.join(self.dir.name, "uart0")
+        self.process = subprocess.Popen(
+            [path, "--uart0", tty, "--speed", str(speed), "--quiet", *options],
+            stdin=subprocess.PIPE, stdout=subprocess.PIPE, text=True)
+        deadline = time.monotonic() + 5
+        while not os.path.exists(tty):
+            if time.monotonic() > deadline:
+                raise loadgen.GameError("the simulator did not start")
+            time.sleep(0.05)
+        self.board = loadgen.Board(tty, BAUD, 2.0)
+
+    def command(self, line):
+        self.process.stdin.write(line + "\n")
+        self.process.stdin.flush()
+
+    def tap(self, button):
+        self.command("tap " + button)
+
+    def settle(self):
+        """Waits until the commands sent so far, such as taps, have run."""
+        self.stats()
+
+    def stats(self):
+        """Returns the simulator's counters once the commands before it ran."""
+        self.command("stats")
+        stats = {}
+        while "warnings" not in stats:
+            key, value = self.process.stdout.readline().split()
+            stats[key] = float(value)
+        return stats
+
+    def spi_bytes(self):
+        return int(self.stats()["spi_bytes"])
+
+    def close(self):
+        self.command("quit")
+        self.process.wait(5)
+        self.board.close()
+        self.dir.cleanup()
+
+
+def sync(sim):
+    """Lets the board detect the baud rate. Old firmware has no frame to
+    confirm it with, so a few bursts are sent and the board gets the time to
+    evaluate each one."""
+    for _ in range(3):
+        sim.board.port.send_text(b"UUUU")
+        time.sleep(0.3)
+
+
+def play(sim, args, rng):
+    sync(sim)
+    sim.tap("BB1")
+    for _ in range(loadgen.increments(loadgen.DEF_ROUNDS, args.rounds,
+                                      loadgen.MIN_ROUNDS, loadgen.MAX_ROUNDS)):
+        sim.tap("JS")
+    sim.tap("LS2")
+    for _ in range(loadgen.increments(loadgen.DEF_PLAYERS, args.players,
+                                      loadgen.MIN_PLAYERS, loadgen.MAX_PLAYERS)):
+        sim.tap("JS")
+    sim.tap("BB1")
+    sim.settle()
+
+    names = [b"%c%02d" % (ord("A") + i, i) for i in range(args.players)]
+    for name in names:
+        sim.board.port.send_text(name)
+        if sim.board.expect([name], args.timeout) is None:
+            raise loadgen.GameError("name %s was not echoed" % name.decode())
+        sim.tap("BB1")
+        sim.settle()
+
+    prompts = [name + loadgen.PROMPT_TEXT for name in names]
+    if sim.board.expect([prompts[0]], args.timeout) is None:
+        raise loadgen.GameError("the first player was not prompted")
+
+    print(f"{'round':>5}{'moves':>10}{'resolution':>12}")
+    start = sim.spi_bytes()
+    for round_number in range(args.rounds):
+        for seat in range(args.players):
+            answer = (prompts[seat + 1] if seat + 1 < args.players
+                      else loadgen.PLAY_TEXT)
+            sim.board.port.send_text(bytes([rng.choice(b"rps")]))
+            if sim.board.expect([answer], args.timeout) is None:
+                raise loadgen.GameError("a move was not accepted")
+        played = sim.spi_bytes()
+
+        sim.tap("BB1")
+        last = round_number + 1 == args.rounds
+        if sim.board.expect([loadgen.END_TEXT if last else prompts[0]],
+                            args.timeout) is None:
+            raise loadgen.GameError("the next round did not start")
+        # The screen is drawn before the prompt is sent
+        end = sim.spi_bytes()
+
+        print(f"{round_number + 1:>5}{played - start:>10}{end - played:>12}")
+        start = end
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--sim", default="host/build/sim", help="simulator binary")
+    parser.add_argument("--speed", type=float, default=1.0,
+                        help="virtual time against the wall clock")
+    parser.add_argument("--players", type=int, default=loadgen.DEF_PLAYERS,
+                        choices=range(loadgen.MIN_PLAYERS, loadgen.MAX_PLAYERS))
+    parser.add_argument("--rounds", type=int, default=loadgen.DEF_ROUNDS,
+                        choices=range(loadgen.MIN_ROUNDS, loadgen.MAX_ROUNDS))
+    parser.add_argument("--timeout", type=float, default=2.0,
+                        help="seconds to wait for an answer")
+    parser.add_argument("--seed", type=int, default=1)
+    args = parser.parse_args()
+
+    sim = Simulator(args.sim, args.speed)
+    try:
+        play(sim, args, random.Random(args.seed))
+    finally:
+        sim.close()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,177 @@
+#!/usr/bin/env python3
+"""Reads the trace ring buffer of HAL/Trace.h and turns it into Chrome trace
+JSON.
+
+    python3 tools/trace.py --port /dev/ttyACM0 dump trace.txt
+    python3 tools/trace.py convert trace.txt trace.json
+    python3 tools/trace.py --port /dev/ttyACM0 stop
+    python3 tools/trace.py --port /dev/ttyACM0 start
+
+The trace records from reset, so a dump right after a sluggish round holds
+the last TRACE_RECORDS events leading up to it. The JSON opens in
+chrome://tracing or https://ui.perfetto.dev. The loop, the screens, the UART
+send loops and the LCD primitives show as nested slices. Each character a
+player typed shows as an instant event, with the character as its argument.
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+import frames
+
+MSG_TRACE = 0x0A
+
+TRACE_STOP = 0x00
+TRACE_START = 0x01
+TRACE_DUMP = 0x02
+
+# In the order of TracePoint in HAL/Trace.h
+POINTS = [
+    "Application_loop",
+    "Game_FSM",
+    "title_screen_state",
+    "instructions_screen_state",
+    "settings_screen_state",
+    "selection_screen_state",
+    "game_screen_state",
+    "end_screen_state",
+    "UART send",
+    "LCD pixels",
+    "LCD line H",
+    "LCD line V",
+    "LCD rect",
+    "LCD flush",
+    "RX char",
+]
+
+# TracePhase
+BEGIN, END, MARK = 0, 1, 2
+
+REPLY_TIMEOUT_S = 5.0
+
+
+def command(port, seq, code):
+    port.send(MSG_TRACE, seq, bytes([code]))
+    reply = port.receive(REPLY_TIMEOUT_S)
+    if reply is None:
+        sys.exit("no reply from the board")
+    msg_type, _, payload = reply
+    if msg_type == frames.MSG_NACK:
+        sys.exit(f"board rejected the command (reason {payload[0]})")
+    return payload
+
+
+def dump(port, path):
+    header = command(port, 1, TRACE_DUMP)
+    frames_left = header[1]
+    written, clock_hz = struct.unpack_from("<II", header, 2)
+
+    records = []
+    while frames_left:
+        reply = port.receive(REPLY_TIMEOUT_S)
+        if reply is None:
+            sys.exit("dump cut short")
+        payload = reply[2]
+        frames_left = payload[1]
+        records += struct.iter_unpack("<IBBH", payload[2:])
+
+    with open(path, "w") as out:
+        out.write(f"# written {written} clock {clock_hz}\n")
+        for record in records:
+            out.write("%d %d %d %d\n" % record)
+    print(f"{len(records)} of {written} records written to {path}")
+
+
+def load(path):
+    clock_hz = None
+    records = []
+    with open(path) as source:
+        for line in source:
+            if line.startswith("#"):
+                words = line.split()
+                clock_hz = int(words[words.index("clock") + 1])
+                continue
+            records.append(tuple(int(word) for word in line.split()))
+    if clock_hz is None:
+        sys.exit(f"{path} is not a trace dump")
+    return clock_hz, records
+
+
+def convert(clock_hz, records):
+    """Returns the Chrome trace events of the records. Times are unwrapped
+    and start at 0; slices whose beginning fell out of the ring buffer are
+    left out."""
+    events = []
+    open_slices = {}
+    base = 0
+    last = None
+    start = None
+
+    for time, point, phase, arg in records:
+        if last is not None and time < last:
+            base += 1 << 32
+        last = time
+        cycles = base + time
+        if start is None:
+            start = cycles
+
+        name = POINTS[point] if point < len(POINTS) else f"point {point}"
+        event = {"name": name, "pid": 1, "tid": 1,
+                 "ts": round((cycles - start) * 1e6 / clock_hz, 3)}
+
+        if phase == BEGIN:
+            open_slices[point] = open_slices.get(point, 0) + 1
+            event["ph"] = "B"
+            if arg:
+                event["args"] = {"arg": arg}
+        elif phase == END:
+            if not open_slices.get(point):
+                continue
+            open_slices[point] -= 1
+            event["ph"] = "E"
+        else:
+            event["ph"] = "i"
+            event["s"] = "t"
+            shown = chr(arg) if 0x20 <= arg < 0x7F else f"{arg:#04x}"
+            event["args"] = {"arg": shown}
+        events.append(event)
+
+    return {"traceEvents": events, "displayTimeUnit": "ms"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--port", help="serial port of the board's USB UART")
+    parser.add_argument("--baud", type=int, default=9600, choices=sorted(frames.BAUDS))
+    sub = parser.add_subparsers(dest="action", required=True)
+    sub.add_parser("start", help="clear the records and start recording")
+    sub.add_parser("stop", help="stop recording")
+    dump_parser = sub.add_parser("dump", help="save the records")
+    dump_parser.add_argument("output")
+    convert_parser = sub.add_parser("convert", help="write a dump as Chrome trace JSON")
+    convert_parser.add_argument("dump")
+    convert_parser.add_argument("output")
+    args = parser.parse_args()
+
+    if args.action == "convert":
+        clock_hz, records = load(args.dump)
+        with open(args.output, "w") as out:
+            json.dump(convert(clock_hz, records), out)
+        return
+
+    if args.port is None:
+        parser.error("--port is needed to talk to the board")
+    port = frames.Port(args.port, args.baud)
+    try:
+        if args.action == "dump":
+            dump(port, args.output)
+        else:
+            command(port, 1, TRACE_START if args.action == "start" else TRACE_STOP)
+    finally:
+        port.close()
+
+
+if __name__ == "__main__":
+    main()